@@ -67,12 +67,42 @@ class ROCKETMQCLIENT_API DefaultLitePullConsumerConfig : virtual public MQClient
   virtual int pull_threshold_for_queue() const = 0;
   virtual void set_pull_threshold_for_queue(int pull_threshold_for_queue) = 0;
 
+  /**
+   * max cached message size in MiB per Queue, default is 100MiB
+   */
+  virtual int pull_threshold_size_for_queue() const = 0;
+  virtual void set_pull_threshold_size_for_queue(int pull_threshold_size_for_queue) = 0;
+
+  /**
+   * max cached message size in MiB of all queues of this consumer, default is -1 which means unlimited
+   */
+  virtual int pull_threshold_size_for_all() const = 0;
+  virtual void set_pull_threshold_size_for_all(int pull_threshold_size_for_all) = 0;
+
+  /**
+   * max offset span of cached messages per Queue, default is 2000
+   */
+  virtual int consume_max_span() const = 0;
+  virtual void set_consume_max_span(int consume_max_span) = 0;
+
   virtual long pull_time_delay_millis_when_exception() const = 0;
   virtual void set_pull_time_delay_millis_when_exception(long pull_time_delay_millis_when_exception) = 0;
 
   virtual long poll_timeout_millis() const = 0;
   virtual void set_poll_timeout_millis(long poll_timeout_millis) = 0;
 
+  /**
+   * max number of messages returned by one poll, which may span several queues, default is 32
+   */
+  virtual int poll_batch_max_size() const = 0;
+  virtual void set_poll_batch_max_size(int poll_batch_max_size) = 0;
+
+  /**
+   * max body size in bytes returned by one poll, default is 4MiB; a pulled batch is never split
+   */
+  virtual int poll_batch_max_bytes() const = 0;
+  virtual void set_poll_batch_max_bytes(int poll_batch_max_bytes) = 0;
+
   virtual long topic_metadata_check_interval_millis() const = 0;
   virtual void set_topic_metadata_check_interval_millis(long topic_metadata_check_interval_millis) = 0;
 
@@ -131,6 +131,32 @@ class ROCKETMQCLIENT_API DefaultLitePullConsumerConfigProxy : public MQClientCon
         ->set_pull_threshold_for_queue(pull_threshold_for_queue);
   }
 
+  int pull_threshold_size_for_queue() const override {
+    return dynamic_cast<DefaultLitePullConsumerConfig*>(client_config_.get())->pull_threshold_size_for_queue();
+  }
+
+  void set_pull_threshold_size_for_queue(int pull_threshold_size_for_queue) override {
+    dynamic_cast<DefaultLitePullConsumerConfig*>(client_config_.get())
+        ->set_pull_threshold_size_for_queue(pull_threshold_size_for_queue);
+  }
+
+  int pull_threshold_size_for_all() const override {
+    return dynamic_cast<DefaultLitePullConsumerConfig*>(client_config_.get())->pull_threshold_size_for_all();
+  }
+
+  void set_pull_threshold_size_for_all(int pull_threshold_size_for_all) override {
+    dynamic_cast<DefaultLitePullConsumerConfig*>(client_config_.get())
+        ->set_pull_threshold_size_for_all(pull_threshold_size_for_all);
+  }
+
+  int consume_max_span() const override {
+    return dynamic_cast<DefaultLitePullConsumerConfig*>(client_config_.get())->consume_max_span();
+  }
+
+  void set_consume_max_span(int consume_max_span) override {
+    dynamic_cast<DefaultLitePullConsumerConfig*>(client_config_.get())->set_consume_max_span(consume_max_span);
+  }
+
   long pull_time_delay_millis_when_exception() const override {
     return dynamic_cast<DefaultLitePullConsumerConfig*>(client_config_.get())->pull_time_delay_millis_when_exception();
   }
@@ -148,6 +174,22 @@ class ROCKETMQCLIENT_API DefaultLitePullConsumerConfigProxy : public MQClientCon
     dynamic_cast<DefaultLitePullConsumerConfig*>(client_config_.get())->set_poll_timeout_millis(poll_timeout_millis);
   }
 
+  int poll_batch_max_size() const override {
+    return dynamic_cast<DefaultLitePullConsumerConfig*>(client_config_.get())->poll_batch_max_size();
+  }
+
+  void set_poll_batch_max_size(int poll_batch_max_size) override {
+    dynamic_cast<DefaultLitePullConsumerConfig*>(client_config_.get())->set_poll_batch_max_size(poll_batch_max_size);
+  }
+
+  int poll_batch_max_bytes() const override {
+    return dynamic_cast<DefaultLitePullConsumerConfig*>(client_config_.get())->poll_batch_max_bytes();
+  }
+
+  void set_poll_batch_max_bytes(int poll_batch_max_bytes) override {
+    dynamic_cast<DefaultLitePullConsumerConfig*>(client_config_.get())->set_poll_batch_max_bytes(poll_batch_max_bytes);
+  }
+
   long topic_metadata_check_interval_millis() const override {
     return dynamic_cast<DefaultLitePullConsumerConfig*>(client_config_.get())->topic_metadata_check_interval_millis();
   }
@@ -17,6 +17,7 @@
 #ifndef ROCKETMQ_DEFAULTMQPRODUCERCONFIG_H_
 #define ROCKETMQ_DEFAULTMQPRODUCERCONFIG_H_
 
+#include "CompressionType.h"
 #include "MQClientConfig.h"
 
 namespace rocketmq {
@@ -49,6 +50,10 @@ class ROCKETMQCLIENT_API DefaultMQProducerConfig : virtual public MQClientConfig
   virtual int compress_level() const = 0;
   virtual void set_compress_level(int compress_level) = 0;
 
+  // codec of compressed bodies, ZSTD and LZ4 are only accepted when the client is built with them
+  virtual CompressionType compression_type() const = 0;
+  virtual void set_compression_type(CompressionType compression_type) = 0;
+
   // set and get timeout of per msg
   virtual int send_msg_timeout() const = 0;
   virtual void set_send_msg_timeout(int send_msg_timeout) = 0;
@@ -65,6 +65,14 @@ class ROCKETMQCLIENT_API DefaultMQProducerConfigProxy : public MQClientConfigPro
     dynamic_cast<DefaultMQProducerConfig*>(client_config_.get())->set_compress_level(compress_level);
   }
 
+  CompressionType compression_type() const override {
+    return dynamic_cast<DefaultMQProducerConfig*>(client_config_.get())->compression_type();
+  }
+
+  void set_compression_type(CompressionType compression_type) override {
+    dynamic_cast<DefaultMQProducerConfig*>(client_config_.get())->set_compression_type(compression_type);
+  }
+
   int send_msg_timeout() const override {
     return dynamic_cast<DefaultMQProducerConfig*>(client_config_.get())->send_msg_timeout();
   }
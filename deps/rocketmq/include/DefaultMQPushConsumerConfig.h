@@ -56,6 +56,24 @@ class ROCKETMQCLIENT_API DefaultMQPushConsumerConfig : virtual public MQClientCo
   virtual int pull_threshold_for_queue() const = 0;
   virtual void set_pull_threshold_for_queue(int maxCacheSize) = 0;
 
+  /**
+   * max cached message size in MiB per Queue, default is 100MiB
+   */
+  virtual int pull_threshold_size_for_queue() const = 0;
+  virtual void set_pull_threshold_size_for_queue(int maxCacheSizeInMiB) = 0;
+
+  /**
+   * max cached message size in MiB of all queues of this consumer, default is -1 which means unlimited
+   */
+  virtual int pull_threshold_size_for_all() const = 0;
+  virtual void set_pull_threshold_size_for_all(int maxCacheSizeInMiB) = 0;
+
+  /**
+   * max offset span of cached messages per Queue for concurrently consume, default is 2000
+   */
+  virtual int consume_concurrently_max_span() const = 0;
+  virtual void set_consume_concurrently_max_span(int maxSpan) = 0;
+
   /**
    * the pull number of message size by each pullMsg for orderly consume, default value is 1
    */
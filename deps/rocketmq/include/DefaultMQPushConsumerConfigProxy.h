@@ -70,6 +70,32 @@ class ROCKETMQCLIENT_API DefaultMQPushConsumerConfigProxy : public MQClientConfi
     dynamic_cast<DefaultMQPushConsumerConfig*>(client_config_.get())->set_pull_threshold_for_queue(maxCacheSize);
   }
 
+  int pull_threshold_size_for_queue() const override {
+    return dynamic_cast<DefaultMQPushConsumerConfig*>(client_config_.get())->pull_threshold_size_for_queue();
+  }
+
+  void set_pull_threshold_size_for_queue(int maxCacheSizeInMiB) override {
+    dynamic_cast<DefaultMQPushConsumerConfig*>(client_config_.get())
+        ->set_pull_threshold_size_for_queue(maxCacheSizeInMiB);
+  }
+
+  int pull_threshold_size_for_all() const override {
+    return dynamic_cast<DefaultMQPushConsumerConfig*>(client_config_.get())->pull_threshold_size_for_all();
+  }
+
+  void set_pull_threshold_size_for_all(int maxCacheSizeInMiB) override {
+    dynamic_cast<DefaultMQPushConsumerConfig*>(client_config_.get())
+        ->set_pull_threshold_size_for_all(maxCacheSizeInMiB);
+  }
+
+  int consume_concurrently_max_span() const override {
+    return dynamic_cast<DefaultMQPushConsumerConfig*>(client_config_.get())->consume_concurrently_max_span();
+  }
+
+  void set_consume_concurrently_max_span(int maxSpan) override {
+    dynamic_cast<DefaultMQPushConsumerConfig*>(client_config_.get())->set_consume_concurrently_max_span(maxSpan);
+  }
+
   int consume_message_batch_max_size() const override {
     return dynamic_cast<DefaultMQPushConsumerConfig*>(client_config_.get())->consume_message_batch_max_size();
   }
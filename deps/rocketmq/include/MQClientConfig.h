@@ -21,6 +21,7 @@
 #include <string>  // std::string
 
 #include "RocketMQClient.h"
+#include "SerializeType.h"
 
 namespace rocketmq {
 
@@ -72,6 +73,12 @@ class ROCKETMQCLIENT_API MQClientConfig {
    **/
   virtual uint64_t tcp_transport_try_lock_timeout() const = 0;
   virtual void set_tcp_transport_try_lock_timeout(uint64_t timeout) = 0;  // ms
+
+  /**
+   * header encoding of requests sent by client, ROCKETMQ is a compact binary header
+   **/
+  virtual SerializeType serialize_type() const = 0;
+  virtual void set_serialize_type(SerializeType serializeType) = 0;
 };
 
 }  // namespace rocketmq
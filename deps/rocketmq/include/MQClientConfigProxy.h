@@ -64,6 +64,9 @@ class ROCKETMQCLIENT_API MQClientConfigProxy : virtual public MQClientConfig  //
     client_config_->set_tcp_transport_try_lock_timeout(timeout);
   }
 
+  SerializeType serialize_type() const override { return client_config_->serialize_type(); }
+  void set_serialize_type(SerializeType serializeType) override { client_config_->set_serialize_type(serializeType); }
+
   inline MQClientConfigPtr real_config() const { return client_config_; }
 
  protected:
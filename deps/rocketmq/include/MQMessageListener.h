@@ -17,6 +17,9 @@
 #ifndef ROCKETMQ_MQMESSAGELISTENER_H_
 #define ROCKETMQ_MQMESSAGELISTENER_H_
 
+#include <memory>  // std::shared_ptr
+#include <vector>  // std::vector
+
 #include "MQMessageExt.h"
 
 namespace rocketmq {
@@ -30,6 +33,34 @@ enum ConsumeStatus {
 
 enum MessageListenerType { messageListenerDefaultly = 0, messageListenerOrderly = 1, messageListenerConcurrently = 2 };
 
+/**
+ * ConsumeCallback - completion callback for asynchronous consumption
+ *
+ * onComplete may be invoked from any thread, only the first invocation takes effect.
+ */
+class ROCKETMQCLIENT_API ConsumeCallback {
+ public:
+  virtual ~ConsumeCallback() = default;
+
+  virtual void onComplete(ConsumeStatus status) = 0;
+
+  /**
+   * onPartialComplete - report the result of each message, msgs[i] was consumed if acks[i] is true
+   *
+   * messages without a true entry are re-consumed later, the others are acknowledged. the default
+   * implementation reduces the results to a single status.
+   */
+  virtual void onPartialComplete(const std::vector<bool>& acks) {
+    bool consumed = !acks.empty();
+    for (auto ack : acks) {
+      consumed = consumed && ack;
+    }
+    onComplete(consumed ? CONSUME_SUCCESS : RECONSUME_LATER);
+  }
+};
+
+typedef std::shared_ptr<ConsumeCallback> ConsumeCallbackPtr;
+
 /**
  * MQMessageListener - listener interface for MQPushConsumer
  */
@@ -40,6 +71,17 @@ class ROCKETMQCLIENT_API MQMessageListener {
   virtual MessageListenerType getMessageListenerType() { return messageListenerDefaultly; }
 
   virtual ConsumeStatus consumeMessage(std::vector<MQMessageExt>& msgs) { return RECONSUME_LATER; };
+
+  /**
+   * consumeMessageAsync - consume messages without holding the consume thread
+   *
+   * the result must be reported through callback, possibly after this method returned. the default
+   * implementation delegates to consumeMessage. in Orderly mode the next batch of the same queue is
+   * dispatched only after the callback completed, other queues are not held up.
+   */
+  virtual void consumeMessageAsync(std::vector<MQMessageExt>& msgs, ConsumeCallbackPtr callback) {
+    callback->onComplete(consumeMessage(msgs));
+  }
 };
 
 /**
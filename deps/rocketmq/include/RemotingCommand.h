@@ -26,6 +26,7 @@
 #include "ByteArray.h"
 #include "CommandCustomHeader.h"
 #include "MQException.h"
+#include "SerializeType.h"
 
 namespace rocketmq {
 
@@ -37,7 +38,7 @@ class ROCKETMQCLIENT_API RemotingCommand {
   static int32_t createNewRequestId();
 
  public:
-  RemotingCommand() : code_(0) {}
+  RemotingCommand() : code_(0), serialize_type_(SerializeType::JSON) {}
   RemotingCommand(int32_t code, CommandCustomHeader* customHeader = nullptr);
   RemotingCommand(int32_t code, const std::string& remark, CommandCustomHeader* customHeader = nullptr);
   RemotingCommand(int32_t code,
@@ -62,8 +63,12 @@ class ROCKETMQCLIENT_API RemotingCommand {
   CommandCustomHeader* readCustomHeader() const;
 
  public:
+  // [length][header length][header][body], in one buffer
   ByteArrayRef encode() const;
 
+  // [length][header length][header], length still counts body which is written separately
+  ByteArrayRef encodeHeader() const;
+
   template <class H>
   H* decodeCommandCustomHeader(bool useCache = true);
 
@@ -75,6 +80,8 @@ class ROCKETMQCLIENT_API RemotingCommand {
   inline int32_t code() const { return code_; }
   inline void set_code(int32_t code) { code_ = code; }
 
+  inline const std::string& language() const { return language_; }
+
   inline int32_t version() const { return version_; }
 
   inline int32_t opaque() const { return opaque_; }
@@ -87,11 +94,19 @@ class ROCKETMQCLIENT_API RemotingCommand {
 
   inline void set_ext_field(const std::string& name, const std::string& value) { ext_fields_[name] = value; }
 
+  inline SerializeType serialize_type() const { return serialize_type_; }
+  inline void set_serialize_type(SerializeType serializeType) { serialize_type_ = serializeType; }
+
   inline ByteArrayRef body() const { return body_; }
   inline void set_body(ByteArrayRef body) { body_ = std::move(body); }
   inline void set_body(const std::string& body) { body_ = stoba(body); }
   inline void set_body(std::string&& body) { body_ = stoba(std::move(body)); }
 
+ private:
+  std::string jsonHeaderEncode() const;
+  void rocketmqHeaderFields(std::map<std::string, std::string>& fields) const;
+  ByteArrayRef encodePackage(bool withBody) const;
+
  private:
   int32_t code_;
   std::string language_;
@@ -101,6 +116,8 @@ class ROCKETMQCLIENT_API RemotingCommand {
   std::string remark_;
   std::map<std::string, std::string> ext_fields_;
 
+  SerializeType serialize_type_;  // transient, header encoding on the wire
+
   std::unique_ptr<CommandCustomHeader> custom_header_;  // transient
 
   ByteArrayRef body_;  // transient
@@ -30,6 +30,10 @@
 #define base64_decode_alloc rocketmq_signature_base64_decode_alloc
 #define isbase64 rocketmq_signature_isbase64
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 #ifdef __cplusplus
 namespace rocketmqSignature {
 #endif
@@ -52,4 +56,8 @@ extern bool base64_decode_alloc(const char* in, size_t inlen, char** out, size_t
 }
 #endif
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* BASE64_H */
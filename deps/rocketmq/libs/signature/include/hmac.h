@@ -18,6 +18,9 @@
 #ifndef _HMAC_HMAC_H
 #define _HMAC_HMAC_H
 
+#include "sha1.h"
+#include "sha256.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -59,6 +62,36 @@ extern int hmac_sha1(const void* key, size_t key_len, const void* data, size_t d
 extern int hmac_sha256(const void* key, size_t key_len, const void* data, size_t data_len, void* ret_buf);
 extern int hmac_sha512(const void* key, size_t key_len, const void* data, size_t data_len, void* ret_buf);
 
+/*
+ * hmac_sha1_init / hmac_sha1_update / hmac_sha1_final:
+ * hmac_sha256_init / hmac_sha256_update / hmac_sha256_final:
+ *	Calculate the same HMAC incrementally, so that data kept in several buffers
+ *	need not be concatenated first. update may be called any number of times.
+ *
+ *	@ctx [in/out]: the HMAC state, it can be initialized again after final.
+ *	@key [in]: the secure-key string
+ *	@key_len [in]: the length of secure-key
+ *	@ret_buf [out]: HMAC result stored in ret_buf.
+ */
+
+struct hmac_sha1_ctx {
+  struct sha1_ctx inner;
+  struct sha1_ctx outer;
+};
+
+struct hmac_sha256_ctx {
+  struct sha256_ctx inner;
+  struct sha256_ctx outer;
+};
+
+extern int hmac_sha1_init(struct hmac_sha1_ctx* ctx, const void* key, size_t key_len);
+extern void hmac_sha1_update(struct hmac_sha1_ctx* ctx, const void* data, size_t data_len);
+extern int hmac_sha1_final(struct hmac_sha1_ctx* ctx, void* ret_buf);
+
+extern int hmac_sha256_init(struct hmac_sha256_ctx* ctx, const void* key, size_t key_len);
+extern void hmac_sha256_update(struct hmac_sha256_ctx* ctx, const void* data, size_t data_len);
+extern int hmac_sha256_final(struct hmac_sha256_ctx* ctx, void* ret_buf);
+
 #ifdef __cplusplus
 }
 #endif
@@ -30,18 +30,15 @@ namespace rocketmqSignature{
 #define IPAD 0x36
 #define OPAD 0x5c
 
-int hmac_sha1(const void *key, size_t key_len, const void *data, size_t data_len, void *ret_buf)
+int hmac_sha1_init(struct hmac_sha1_ctx *ctx, const void *key, size_t key_len)
 {
 	uint32_t i;
-	struct sha1_ctx inner;
-	struct sha1_ctx outer;
 	struct sha1_ctx key_hash;
 	char ipad[64] = {0};
 	char opad[64] = {0};
 	char key_buf[SHA1_DIGEST_SIZE] = {0};
-	char inner_buf[SHA1_DIGEST_SIZE] = {0};
 
-	if (key == NULL || data == NULL || ret_buf == NULL) return -1;
+	if (ctx == NULL || key == NULL) return -1;
 
  	if (key_len > 64) {
 		sha1_init_ctx(&key_hash);
@@ -52,8 +49,6 @@ int hmac_sha1(const void *key, size_t key_len, const void *data, size_t data_len
 		key_len = SHA1_DIGEST_SIZE;
 	}
 
-	sha1_init_ctx (&inner);
-
 	for (i = 0; i < 64; i++) {
 		if (i < key_len) {
 			ipad[i] = ((const char *)key)[i] ^ IPAD;
@@ -64,33 +59,54 @@ int hmac_sha1(const void *key, size_t key_len, const void *data, size_t data_len
 		}
 	}
 
-  sha1_process_block (ipad, 64, &inner);
-  sha1_process_bytes (data, data_len, &inner);
+  sha1_init_ctx (&ctx->inner);
+  sha1_process_block (ipad, 64, &ctx->inner);
+
+  sha1_init_ctx (&ctx->outer);
+  sha1_process_block (opad, 64, &ctx->outer);
+
+  return 0;
+}
+
+void hmac_sha1_update(struct hmac_sha1_ctx *ctx, const void *data, size_t data_len)
+{
+  sha1_process_bytes (data, data_len, &ctx->inner);
+}
 
-  sha1_finish_ctx (&inner, inner_buf);
+int hmac_sha1_final(struct hmac_sha1_ctx *ctx, void *ret_buf)
+{
+	char inner_buf[SHA1_DIGEST_SIZE] = {0};
 
-  sha1_init_ctx (&outer);
+	if (ctx == NULL || ret_buf == NULL) return -1;
 
-  sha1_process_block (opad, 64, &outer);
-  sha1_process_bytes (inner_buf, SHA1_DIGEST_SIZE, &outer);
+  sha1_finish_ctx (&ctx->inner, inner_buf);
 
-  sha1_finish_ctx (&outer, ret_buf);
+  sha1_process_bytes (inner_buf, SHA1_DIGEST_SIZE, &ctx->outer);
+  sha1_finish_ctx (&ctx->outer, ret_buf);
 
   return 0;
 }
 
-int hmac_sha256(const void *key, size_t key_len, const void *data, size_t data_len, void *ret_buf)
+int hmac_sha1(const void *key, size_t key_len, const void *data, size_t data_len, void *ret_buf)
+{
+	struct hmac_sha1_ctx ctx;
+
+	if (key == NULL || data == NULL || ret_buf == NULL) return -1;
+
+	hmac_sha1_init(&ctx, key, key_len);
+	hmac_sha1_update(&ctx, data, data_len);
+	return hmac_sha1_final(&ctx, ret_buf);
+}
+
+int hmac_sha256_init(struct hmac_sha256_ctx *ctx, const void *key, size_t key_len)
 {
 	uint32_t i;
-	struct sha256_ctx inner;
-	struct sha256_ctx outer;
 	struct sha256_ctx key_hash;
 	char ipad[64] = {0};
 	char opad[64] = {0};
 	char key_buf[SHA256_DIGEST_SIZE] = {0};
-	char inner_buf[SHA256_DIGEST_SIZE] = {0};
 
-	if (key == NULL || data == NULL || ret_buf == NULL) return -1;
+	if (ctx == NULL || key == NULL) return -1;
 
  	if (key_len > 64) {
 		sha256_init_ctx(&key_hash);
@@ -101,8 +117,6 @@ int hmac_sha256(const void *key, size_t key_len, const void *data, size_t data_l
 		key_len = SHA256_DIGEST_SIZE;
 	}
 
-	sha256_init_ctx (&inner);
-
 	for (i = 0; i < 64; i++) {
 		if (i < key_len) {
 			ipad[i] = ((const char *)key)[i] ^ IPAD;
@@ -113,21 +127,45 @@ int hmac_sha256(const void *key, size_t key_len, const void *data, size_t data_l
 		}
 	}
 
-  sha256_process_block (ipad, 64, &inner);
-  sha256_process_bytes (data, data_len, &inner);
+  sha256_init_ctx (&ctx->inner);
+  sha256_process_block (ipad, 64, &ctx->inner);
+
+  sha256_init_ctx (&ctx->outer);
+  sha256_process_block (opad, 64, &ctx->outer);
+
+  return 0;
+}
+
+void hmac_sha256_update(struct hmac_sha256_ctx *ctx, const void *data, size_t data_len)
+{
+  sha256_process_bytes (data, data_len, &ctx->inner);
+}
 
-  sha256_finish_ctx (&inner, inner_buf);
+int hmac_sha256_final(struct hmac_sha256_ctx *ctx, void *ret_buf)
+{
+	char inner_buf[SHA256_DIGEST_SIZE] = {0};
 
-  sha256_init_ctx (&outer);
+	if (ctx == NULL || ret_buf == NULL) return -1;
 
-  sha256_process_block (opad, 64, &outer);
-  sha256_process_bytes (inner_buf, SHA256_DIGEST_SIZE, &outer);
+  sha256_finish_ctx (&ctx->inner, inner_buf);
 
-  sha256_finish_ctx (&outer, ret_buf);
+  sha256_process_bytes (inner_buf, SHA256_DIGEST_SIZE, &ctx->outer);
+  sha256_finish_ctx (&ctx->outer, ret_buf);
 
   return 0;
 }
 
+int hmac_sha256(const void *key, size_t key_len, const void *data, size_t data_len, void *ret_buf)
+{
+	struct hmac_sha256_ctx ctx;
+
+	if (key == NULL || data == NULL || ret_buf == NULL) return -1;
+
+	hmac_sha256_init(&ctx, key, key_len);
+	hmac_sha256_update(&ctx, data, data_len);
+	return hmac_sha256_final(&ctx, ret_buf);
+}
+
 int hmac_sha512(const void *key, size_t key_len, const void *data, size_t data_len, void *ret_buf)
 {
 	uint32_t i;
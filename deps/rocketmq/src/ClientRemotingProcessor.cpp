@@ -18,6 +18,7 @@
 
 #include <cassert>
 
+#include "CompressionCodec.h"
 #include "MQException.h"
 #include "MQProtos.h"
 #include "MessageAccessor.hpp"
@@ -219,8 +220,9 @@ RemotingCommand* ClientRemotingProcessor::receiveReplyMessage(RemotingCommand* r
     }
 
     if ((requestHeader->sys_flag() & MessageSysFlag::COMPRESSED_FLAG) == MessageSysFlag::COMPRESSED_FLAG) {
+      const auto* codec = CompressionCodec::of(MessageSysFlag::getCompressionType(requestHeader->sys_flag()));
       std::string origin_body;
-      if (UtilAll::inflate(*body, origin_body)) {
+      if (codec != nullptr && codec->uncompress(body->array(), body->size(), origin_body)) {
         msg->set_body(std::move(origin_body));
       } else {
         LOG_WARN_NEW("failed to uncompress reply message body");
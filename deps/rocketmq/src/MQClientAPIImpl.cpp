@@ -33,12 +33,52 @@
 
 namespace rocketmq {
 
+/**
+ * MessageBodyByteArray - view of message body, keeps message alive instead of copying body
+ */
+class MessageBodyByteArray : public ByteArray {
+ public:
+  MessageBodyByteArray(MessagePtr msg)
+      : ByteArray((char*)msg->body().data(), msg->body().size()), message_(std::move(msg)) {}
+
+ private:
+  MessagePtr message_;
+};
+
+/**
+ * SendMessageBackCallbackWrap - reports the result of an asynchronous CONSUMER_SEND_MSG_BACK
+ */
+class SendMessageBackCallbackWrap : public InvokeCallback {
+ public:
+  SendMessageBackCallbackWrap(std::function<void(bool)> callback) : callback_(std::move(callback)) {}
+
+  void operationComplete(ResponseFuture* responseFuture) noexcept override {
+    std::unique_ptr<RemotingCommand> response(responseFuture->getResponseCommand());  // avoid RemotingCommand leak
+    bool success = response != nullptr && response->code() == SUCCESS;
+    if (!success) {
+      LOG_WARN_NEW("consumerSendMessageBack failed, {}",
+                   response != nullptr ? response->remark()
+                                       : (responseFuture->send_request_ok() ? "wait response timeout"
+                                                                             : "send request failed"));
+    }
+    try {
+      callback_(success);
+    } catch (const std::exception& e) {
+      LOG_WARN_NEW("encounter exception when invoke send back callback, {}", e.what());
+    }
+  }
+
+ private:
+  std::function<void(bool)> callback_;
+};
+
 MQClientAPIImpl::MQClientAPIImpl(ClientRemotingProcessor* clientRemotingProcessor,
                                  RPCHookPtr rpcHook,
                                  const MQClientConfig& clientConfig)
     : remoting_client_(new TcpRemotingClient(clientConfig.tcp_transport_worker_thread_nums(),
                                              clientConfig.tcp_transport_connect_timeout(),
-                                             clientConfig.tcp_transport_try_lock_timeout())) {
+                                             clientConfig.tcp_transport_try_lock_timeout(),
+                                             clientConfig.serialize_type())) {
   remoting_client_->registerRPCHook(rpcHook);
   remoting_client_->registerProcessor(CHECK_TRANSACTION_STATE, clientRemotingProcessor);
   remoting_client_->registerProcessor(NOTIFY_CONSUMER_IDS_CHANGED, clientRemotingProcessor);
@@ -130,7 +170,8 @@ SendResult* MQClientAPIImpl::sendMessage(const std::string& addr,
   }
 
   RemotingCommand request(code, header.release());
-  request.set_body(msg->body());
+  // NOTE: body is sent by reference, message must not be modified until sent
+  request.set_body(std::make_shared<MessageBodyByteArray>(msg));
 
   switch (communicationMode) {
     case CommunicationMode::ONEWAY:
@@ -571,6 +612,27 @@ void MQClientAPIImpl::consumerSendMessageBack(const std::string& addr,
   THROW_MQEXCEPTION(MQBrokerException, response->remark(), response->code());
 }
 
+void MQClientAPIImpl::consumerSendMessageBackAsync(const std::string& addr,
+                                                   MessageExtPtr msg,
+                                                   const std::string& consumerGroup,
+                                                   int delayLevel,
+                                                   int timeoutMillis,
+                                                   int maxConsumeRetryTimes,
+                                                   std::function<void(bool)> callback) {
+  auto* requestHeader = new ConsumerSendMsgBackRequestHeader();
+  requestHeader->group = consumerGroup;
+  requestHeader->originTopic = msg->topic();
+  requestHeader->offset = msg->commit_log_offset();
+  requestHeader->delayLevel = delayLevel;
+  requestHeader->originMsgId = msg->msg_id();
+  requestHeader->maxReconsumeTimes = maxConsumeRetryTimes;
+
+  RemotingCommand request(CONSUMER_SEND_MSG_BACK, requestHeader);
+
+  std::unique_ptr<InvokeCallback> cbw(new SendMessageBackCallbackWrap(std::move(callback)));
+  remoting_client_->invokeAsync(addr, request, cbw, timeoutMillis);
+}
+
 void MQClientAPIImpl::lockBatchMQ(const std::string& addr,
                                   LockBatchRequestBody* requestBody,
                                   std::vector<MQMessageQueue>& mqs,
@@ -17,6 +17,8 @@
 #ifndef ROCKETMQ_MQCLIENTAPIIMPL_H_
 #define ROCKETMQ_MQCLIENTAPIIMPL_H_
 
+#include <functional>  // std::function
+
 #include "CommunicationMode.h"
 #include "DefaultMQProducerImpl.h"
 #include "KVTable.h"
@@ -135,6 +137,15 @@ class MQClientAPIImpl {
                                int timeoutMillis,
                                int maxConsumeRetryTimes);
 
+  // callback is invoked with the result once the broker answered, unless this method throws
+  void consumerSendMessageBackAsync(const std::string& addr,
+                                    MessageExtPtr msg,
+                                    const std::string& consumerGroup,
+                                    int delayLevel,
+                                    int timeoutMillis,
+                                    int maxConsumeRetryTimes,
+                                    std::function<void(bool)> callback);
+
   void lockBatchMQ(const std::string& addr,
                    LockBatchRequestBody* requestBody,
                    std::vector<MQMessageQueue>& mqs,
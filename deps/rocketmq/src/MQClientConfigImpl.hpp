@@ -36,7 +36,8 @@ class MQClientConfigImpl : virtual public MQClientConfig {
       : instance_name_("DEFAULT"),
         tcp_worker_thread_nums_(std::min(4, (int)std::thread::hardware_concurrency())),
         tcp_connect_timeout(3000),
-        tcp_transport_try_lock_timeout_(3) {
+        tcp_transport_try_lock_timeout_(3),
+        serialize_type_(SerializeType::JSON) {
     const char* addr = std::getenv(ROCKETMQ_NAMESRV_ADDR_ENV.c_str());
     if (addr != nullptr) {
       namesrv_addr_ = addr;
@@ -95,6 +96,9 @@ class MQClientConfigImpl : virtual public MQClientConfig {
     tcp_transport_try_lock_timeout_ = std::max<uint64_t>(1000, millisec) / 1000;
   }
 
+  SerializeType serialize_type() const override { return serialize_type_; }
+  void set_serialize_type(SerializeType serializeType) override { serialize_type_ = serializeType; }
+
  protected:
   std::string namesrv_addr_;
   std::string instance_name_;
@@ -105,6 +109,8 @@ class MQClientConfigImpl : virtual public MQClientConfig {
   int tcp_worker_thread_nums_;
   uint64_t tcp_connect_timeout;              // ms
   uint64_t tcp_transport_try_lock_timeout_;  // s
+
+  SerializeType serialize_type_;
 };
 
 }  // namespace rocketmq
@@ -18,8 +18,9 @@
 
 #include "Logging.h"
 #include "RemotingCommand.h"
+#include "base64.h"
+#include "hmac.h"
 #include "protocol/header/CommandHeader.h"
-#include "spas_client.h"
 
 static const std::string ACCESS_KEY = "AccessKey";
 static const std::string SECRET_KEY = "SecretKey";
@@ -58,28 +59,37 @@ void ClientRPCHook::signCommand(RemotingCommand& command) {
   }
   LOG_DEBUG_NEW("after insert declared filed, MAP SIZE is:{}", headerMap.size());
 
-  std::string totalMsg;
+  // HmacSHA1 over the header values in key order followed by the body, fed piece by piece instead of concatenated
+  const auto& secretKey = session_credentials_.secret_key();
+  rocketmqSignature::hmac_sha1_ctx ctx;
+  if (rocketmqSignature::hmac_sha1_init(&ctx, secretKey.data(), secretKey.size()) != 0) {
+    LOG_ERROR_NEW("signature for request failed");
+    return;
+  }
+  size_t totalSize = 0;
   for (const auto& it : headerMap) {
-    totalMsg.append(it.second);
+    rocketmqSignature::hmac_sha1_update(&ctx, it.second.data(), it.second.size());
+    totalSize += it.second.size();
   }
   auto body = command.body();
   if (body != nullptr && body->size() > 0) {
     LOG_DEBUG_NEW("request have msgBody, length is:{}", body->size());
-    totalMsg.append(body->array(), body->size());
+    rocketmqSignature::hmac_sha1_update(&ctx, body->array(), body->size());
+    totalSize += body->size();
   }
-  LOG_DEBUG_NEW("total msg info are:{}, size is:{}", totalMsg, totalMsg.size());
+  LOG_DEBUG_NEW("total msg size is:{}", totalSize);
 
-  char* sign =
-      rocketmqSignature::spas_sign(totalMsg.c_str(), totalMsg.size(), session_credentials_.secret_key().c_str());
-  if (sign != nullptr) {
-    std::string signature(static_cast<const char*>(sign));
-    command.set_ext_field(SIGNATURE_KEY, signature);
-    command.set_ext_field(ACCESS_KEY, session_credentials_.access_key());
-    command.set_ext_field(ONS_CHANNEL_KEY, session_credentials_.auth_channel());
-    rocketmqSignature::spas_mem_free(sign);
-  } else {
+  char digest[SHA1_DIGEST_SIZE];
+  if (rocketmqSignature::hmac_sha1_final(&ctx, digest) != 0) {
     LOG_ERROR_NEW("signature for request failed");
+    return;
   }
+  std::string signature(BASE64_LENGTH(SHA1_DIGEST_SIZE), '\0');
+  rocketmqSignature::base64_encode(digest, sizeof(digest), &signature[0], signature.size());
+
+  command.set_ext_field(SIGNATURE_KEY, signature);
+  command.set_ext_field(ACCESS_KEY, session_credentials_.access_key());
+  command.set_ext_field(ONS_CHANNEL_KEY, session_credentials_.auth_channel());
 }
 
 }  // namespace rocketmq
@@ -0,0 +1,358 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "CompressionCodec.h"
+
+#include <algorithm>  // std::max
+#include <cstring>    // std::memset
+
+#include <zlib.h>
+
+#ifdef ROCKETMQ_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+#ifdef ROCKETMQ_WITH_LZ4
+#include <lz4frame.h>
+#ifndef LZ4F_HEADER_SIZE_MAX
+#define LZ4F_HEADER_SIZE_MAX 19
+#endif
+#endif
+
+namespace rocketmq {
+
+namespace {
+
+// first guess of the uncompressed size when the stream doesn't carry it, doubled until it fits
+inline size_t initialUncompressedSize(size_t len) {
+  return std::max<size_t>(len * 4, 1024);
+}
+
+// ============================
+// zlib
+// ============================
+
+struct ZlibDeflater {
+  z_stream strm;
+  bool inited = false;
+  int level = 0;
+
+  ~ZlibDeflater() {
+    if (inited) {
+      (void)::deflateEnd(&strm);
+    }
+  }
+
+  z_stream* reset(int compressLevel) {
+    if (inited && level == compressLevel) {
+      return ::deflateReset(&strm) == Z_OK ? &strm : nullptr;
+    }
+    if (inited) {
+      (void)::deflateEnd(&strm);
+      inited = false;
+    }
+    std::memset(&strm, 0, sizeof(strm));  // Z_NULL zalloc, zfree and opaque
+    if (::deflateInit(&strm, compressLevel) != Z_OK) {
+      return nullptr;
+    }
+    inited = true;
+    level = compressLevel;
+    return &strm;
+  }
+};
+
+struct ZlibInflater {
+  z_stream strm;
+  bool inited = false;
+
+  ~ZlibInflater() {
+    if (inited) {
+      (void)::inflateEnd(&strm);
+    }
+  }
+
+  z_stream* reset() {
+    if (inited) {
+      return ::inflateReset(&strm) == Z_OK ? &strm : nullptr;
+    }
+    std::memset(&strm, 0, sizeof(strm));
+    if (::inflateInit(&strm) != Z_OK) {
+      return nullptr;
+    }
+    inited = true;
+    return &strm;
+  }
+};
+
+thread_local ZlibDeflater tls_deflater;
+thread_local ZlibInflater tls_inflater;
+
+class ZlibCodec : public CompressionCodec {
+ public:
+  CompressionType type() const override { return CompressionType::ZLIB; }
+
+  bool compress(const char* in, size_t len, int level, std::string& out) const override {
+    z_stream* strm = tls_deflater.reset(level);
+    if (strm == nullptr) {
+      return false;
+    }
+
+    // deflateBound is large enough to finish the stream in one call
+    out.resize(::deflateBound(strm, static_cast<uLong>(len)));
+    strm->next_in = (z_const Bytef*)in;
+    strm->avail_in = static_cast<uInt>(len);
+    strm->next_out = (Bytef*)&out[0];
+    strm->avail_out = static_cast<uInt>(out.size());
+    if (::deflate(strm, Z_FINISH) != Z_STREAM_END) {
+      return false;
+    }
+    out.resize(strm->total_out);
+    return true;
+  }
+
+  bool uncompress(const char* in, size_t len, std::string& out) const override {
+    z_stream* strm = tls_inflater.reset();
+    if (strm == nullptr) {
+      return false;
+    }
+
+    out.resize(initialUncompressedSize(len));
+    strm->next_in = (z_const Bytef*)in;
+    strm->avail_in = static_cast<uInt>(len);
+    size_t produced = 0;
+    for (;;) {
+      strm->next_out = (Bytef*)&out[produced];
+      strm->avail_out = static_cast<uInt>(out.size() - produced);
+      int ret = ::inflate(strm, Z_NO_FLUSH);
+      produced = out.size() - strm->avail_out;
+      if (ret == Z_STREAM_END) {
+        out.resize(produced);
+        return true;
+      }
+      if ((ret != Z_OK && ret != Z_BUF_ERROR) || strm->avail_out != 0) {
+        // broken or truncated stream
+        return false;
+      }
+      out.resize(out.size() * 2);
+    }
+  }
+};
+
+#ifdef ROCKETMQ_WITH_ZSTD
+
+// ============================
+// zstd
+// ============================
+
+struct ZstdContexts {
+  ZSTD_CCtx* cctx = nullptr;
+  ZSTD_DCtx* dctx = nullptr;
+
+  ~ZstdContexts() {
+    ZSTD_freeCCtx(cctx);
+    ZSTD_freeDCtx(dctx);
+  }
+};
+
+thread_local ZstdContexts tls_zstd;
+
+class ZstdCodec : public CompressionCodec {
+ public:
+  CompressionType type() const override { return CompressionType::ZSTD; }
+
+  bool compress(const char* in, size_t len, int level, std::string& out) const override {
+    if (tls_zstd.cctx == nullptr && (tls_zstd.cctx = ZSTD_createCCtx()) == nullptr) {
+      return false;
+    }
+
+    out.resize(ZSTD_compressBound(len));
+    size_t n = ZSTD_compressCCtx(tls_zstd.cctx, &out[0], out.size(), in, len, level);
+    if (ZSTD_isError(n)) {
+      return false;
+    }
+    out.resize(n);
+    return true;
+  }
+
+  bool uncompress(const char* in, size_t len, std::string& out) const override {
+    if (tls_zstd.dctx == nullptr && (tls_zstd.dctx = ZSTD_createDCtx()) == nullptr) {
+      return false;
+    }
+
+    unsigned long long size = ZSTD_getFrameContentSize(in, len);
+    if (size == ZSTD_CONTENTSIZE_ERROR) {
+      return false;
+    }
+    if (size != ZSTD_CONTENTSIZE_UNKNOWN) {
+      out.resize(static_cast<size_t>(size));
+      size_t n = ZSTD_decompressDCtx(tls_zstd.dctx, &out[0], out.size(), in, len);
+      return !ZSTD_isError(n) && n == size;
+    }
+
+    // streamed frames don't carry the content size
+    ZSTD_DCtx_reset(tls_zstd.dctx, ZSTD_reset_session_only);
+    out.resize(initialUncompressedSize(len));
+    ZSTD_inBuffer input = {in, len, 0};
+    size_t produced = 0;
+    for (;;) {
+      ZSTD_outBuffer output = {&out[0], out.size(), produced};
+      size_t ret = ZSTD_decompressStream(tls_zstd.dctx, &output, &input);
+      if (ZSTD_isError(ret)) {
+        return false;
+      }
+      produced = output.pos;
+      if (ret == 0) {
+        out.resize(produced);
+        return true;
+      }
+      if (output.pos < output.size) {
+        // all input is consumed, but the frame isn't complete
+        return false;
+      }
+      out.resize(out.size() * 2);
+    }
+  }
+};
+
+#endif  // ROCKETMQ_WITH_ZSTD
+
+#ifdef ROCKETMQ_WITH_LZ4
+
+// ============================
+// lz4, frame format
+// ============================
+
+struct Lz4Contexts {
+  LZ4F_cctx* cctx = nullptr;
+  LZ4F_dctx* dctx = nullptr;
+
+  ~Lz4Contexts() {
+    if (cctx != nullptr) {
+      LZ4F_freeCompressionContext(cctx);
+    }
+    if (dctx != nullptr) {
+      LZ4F_freeDecompressionContext(dctx);
+    }
+  }
+};
+
+thread_local Lz4Contexts tls_lz4;
+
+class Lz4Codec : public CompressionCodec {
+ public:
+  CompressionType type() const override { return CompressionType::LZ4; }
+
+  bool compress(const char* in, size_t len, int level, std::string& out) const override {
+    if (tls_lz4.cctx == nullptr && LZ4F_isError(LZ4F_createCompressionContext(&tls_lz4.cctx, LZ4F_VERSION))) {
+      tls_lz4.cctx = nullptr;
+      return false;
+    }
+
+    LZ4F_preferences_t prefs;
+    std::memset(&prefs, 0, sizeof(prefs));
+    prefs.compressionLevel = level;
+    prefs.frameInfo.contentSize = len;
+
+    // LZ4F_compressBound covers the blocks and the frame footer
+    out.resize(LZ4F_HEADER_SIZE_MAX + LZ4F_compressBound(len, &prefs));
+    char* dst = &out[0];
+    size_t capacity = out.size();
+    size_t pos = LZ4F_compressBegin(tls_lz4.cctx, dst, capacity, &prefs);
+    if (LZ4F_isError(pos)) {
+      return false;
+    }
+    size_t n = LZ4F_compressUpdate(tls_lz4.cctx, dst + pos, capacity - pos, in, len, nullptr);
+    if (LZ4F_isError(n)) {
+      return false;
+    }
+    pos += n;
+    n = LZ4F_compressEnd(tls_lz4.cctx, dst + pos, capacity - pos, nullptr);
+    if (LZ4F_isError(n)) {
+      return false;
+    }
+    out.resize(pos + n);
+    return true;
+  }
+
+  bool uncompress(const char* in, size_t len, std::string& out) const override {
+    if (tls_lz4.dctx == nullptr && LZ4F_isError(LZ4F_createDecompressionContext(&tls_lz4.dctx, LZ4F_VERSION))) {
+      tls_lz4.dctx = nullptr;
+      return false;
+    }
+    LZ4F_resetDecompressionContext(tls_lz4.dctx);
+
+    LZ4F_frameInfo_t info;
+    size_t pos = len;
+    size_t ret = LZ4F_getFrameInfo(tls_lz4.dctx, &info, in, &pos);
+    if (LZ4F_isError(ret)) {
+      return false;
+    }
+
+    out.resize(info.contentSize > 0 ? static_cast<size_t>(info.contentSize) : initialUncompressedSize(len));
+    size_t produced = 0;
+    for (;;) {
+      size_t dstSize = out.size() - produced;
+      size_t srcSize = len - pos;
+      ret = LZ4F_decompress(tls_lz4.dctx, &out[0] + produced, &dstSize, in + pos, &srcSize, nullptr);
+      if (LZ4F_isError(ret)) {
+        return false;
+      }
+      pos += srcSize;
+      produced += dstSize;
+      if (ret == 0) {
+        out.resize(produced);
+        return true;
+      }
+      if (produced == out.size()) {
+        out.resize(out.size() * 2);
+      } else if (pos == len || (srcSize == 0 && dstSize == 0)) {
+        // all input is consumed, but the frame isn't complete
+        return false;
+      }
+    }
+  }
+};
+
+#endif  // ROCKETMQ_WITH_LZ4
+
+}  // namespace
+
+const CompressionCodec* CompressionCodec::of(CompressionType type) {
+  static ZlibCodec zlib;
+#ifdef ROCKETMQ_WITH_ZSTD
+  static ZstdCodec zstd;
+#endif
+#ifdef ROCKETMQ_WITH_LZ4
+  static Lz4Codec lz4;
+#endif
+
+  switch (type) {
+    case CompressionType::ZLIB:
+      return &zlib;
+#ifdef ROCKETMQ_WITH_ZSTD
+    case CompressionType::ZSTD:
+      return &zstd;
+#endif
+#ifdef ROCKETMQ_WITH_LZ4
+    case CompressionType::LZ4:
+      return &lz4;
+#endif
+    default:
+      return nullptr;
+  }
+}
+
+}  // namespace rocketmq
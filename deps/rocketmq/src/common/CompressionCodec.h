@@ -0,0 +1,50 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ROCKETMQ_COMMON_COMPRESSIONCODEC_H_
+#define ROCKETMQ_COMMON_COMPRESSIONCODEC_H_
+
+#include <cstddef>  // size_t
+#include <string>   // std::string
+
+#include "CompressionType.h"
+
+namespace rocketmq {
+
+/**
+ * CompressionCodec - compressor of message bodies
+ *
+ * codecs are stateless singletons. the zlib/zstd/lz4 contexts live in thread local storage and are
+ * reset between calls instead of being created for every message, and the output is written into one
+ * buffer that is sized up front.
+ */
+class CompressionCodec {
+ public:
+  virtual ~CompressionCodec() = default;
+
+  virtual CompressionType type() const = 0;
+
+  // replaces the content of out, returns false if the input can't be (de)compressed
+  virtual bool compress(const char* in, size_t len, int level, std::string& out) const = 0;
+  virtual bool uncompress(const char* in, size_t len, std::string& out) const = 0;
+
+  // nullptr if the codec isn't built in
+  static const CompressionCodec* of(CompressionType type);
+};
+
+}  // namespace rocketmq
+
+#endif  // ROCKETMQ_COMMON_COMPRESSIONCODEC_H_
@@ -29,6 +29,11 @@ const int MessageSysFlag::TRANSACTION_ROLLBACK_TYPE = 0x3 << 2;
 const int MessageSysFlag::BORNHOST_V6_FLAG = 0x1 << 4;
 const int MessageSysFlag::STOREHOST_V6_FLAG = 0x1 << 5;
 
+const int MessageSysFlag::COMPRESSION_LZ4_TYPE = 0x1 << 8;
+const int MessageSysFlag::COMPRESSION_ZSTD_TYPE = 0x2 << 8;
+const int MessageSysFlag::COMPRESSION_ZLIB_TYPE = 0x3 << 8;
+const int MessageSysFlag::COMPRESSION_TYPE_COMPARATOR = 0x7 << 8;
+
 int MessageSysFlag::getTransactionValue(int flag) {
   return flag & TRANSACTION_ROLLBACK_TYPE;
 }
@@ -41,4 +46,13 @@ int MessageSysFlag::clearCompressedFlag(int flag) {
   return flag & (~COMPRESSED_FLAG);
 }
 
+CompressionType MessageSysFlag::getCompressionType(int flag) {
+  int type = (flag & COMPRESSION_TYPE_COMPARATOR) >> 8;
+  return type == 0 ? CompressionType::ZLIB : static_cast<CompressionType>(type);
+}
+
+int MessageSysFlag::compressionFlag(CompressionType type) {
+  return static_cast<int>(type) << 8;
+}
+
 }  // namespace rocketmq
@@ -17,6 +17,8 @@
 #ifndef ROCKETMQ_COMMON_MESSAGESYSFLAG_H_
 #define ROCKETMQ_COMMON_MESSAGESYSFLAG_H_
 
+#include "CompressionType.h"
+
 namespace rocketmq {
 
 class MessageSysFlag {
@@ -32,11 +34,20 @@ class MessageSysFlag {
   static const int BORNHOST_V6_FLAG;
   static const int STOREHOST_V6_FLAG;
 
+  static const int COMPRESSION_LZ4_TYPE;
+  static const int COMPRESSION_ZSTD_TYPE;
+  static const int COMPRESSION_ZLIB_TYPE;
+  static const int COMPRESSION_TYPE_COMPARATOR;
+
  public:
   static int getTransactionValue(int flag);
   static int resetTransactionValue(int flag, int type);
 
   static int clearCompressedFlag(int flag);
+
+  // bodies compressed by older clients carry no type bits, they are zlib
+  static CompressionType getCompressionType(int flag);
+  static int compressionFlag(CompressionType type);
 };
 
 }  // namespace rocketmq
@@ -33,10 +33,7 @@
 #include <io.h>
 #endif
 
-#include <zlib.h>
-
-#define ZLIB_CHUNK 16384
-
+#include "CompressionCodec.h"
 #include "Logging.h"
 #include "SocketUtil.h"
 
@@ -338,40 +335,7 @@ bool UtilAll::deflate(const std::string& input, std::string& out, int level) {
 }
 
 bool UtilAll::deflate(const ByteArray& in, std::string& out, int level) {
-  int ret;
-  unsigned have;
-  z_stream strm;
-  unsigned char buf[ZLIB_CHUNK];
-
-  /* allocate deflate state */
-  strm.zalloc = Z_NULL;
-  strm.zfree = Z_NULL;
-  strm.opaque = Z_NULL;
-  ret = ::deflateInit(&strm, level);
-  if (ret != Z_OK) {
-    return false;
-  }
-
-  strm.avail_in = in.size();
-  strm.next_in = (z_const Bytef*)in.array();
-
-  /* run deflate() on input until output buffer not full, finish
-     compression if all of source has been read in */
-  do {
-    strm.avail_out = ZLIB_CHUNK;
-    strm.next_out = buf;
-    ret = ::deflate(&strm, Z_FINISH); /* no bad return value */
-    assert(ret != Z_STREAM_ERROR);    /* state not clobbered */
-    have = ZLIB_CHUNK - strm.avail_out;
-    out.append((char*)buf, have);
-  } while (strm.avail_out == 0);
-  assert(strm.avail_in == 0);  /* all input will be used */
-  assert(ret == Z_STREAM_END); /* stream will be complete */
-
-  /* clean up and return */
-  (void)::deflateEnd(&strm);
-
-  return true;
+  return CompressionCodec::of(CompressionType::ZLIB)->compress(in.array(), in.size(), level, out);
 }
 
 bool UtilAll::inflate(const std::string& input, std::string& out) {
@@ -379,47 +343,7 @@ bool UtilAll::inflate(const std::string& input, std::string& out) {
 }
 
 bool UtilAll::inflate(const ByteArray& in, std::string& out) {
-  int ret;
-  unsigned have;
-  z_stream strm;
-  unsigned char buf[ZLIB_CHUNK];
-
-  /* allocate inflate state */
-  strm.zalloc = Z_NULL;
-  strm.zfree = Z_NULL;
-  strm.opaque = Z_NULL;
-  strm.avail_in = 0;
-  strm.next_in = Z_NULL;
-  ret = ::inflateInit(&strm);
-  if (ret != Z_OK) {
-    return false;
-  }
-
-  strm.avail_in = in.size();
-  strm.next_in = (z_const Bytef*)in.array();
-
-  /* run inflate() on input until output buffer not full */
-  do {
-    strm.avail_out = ZLIB_CHUNK;
-    strm.next_out = buf;
-    ret = ::inflate(&strm, Z_NO_FLUSH);
-    assert(ret != Z_STREAM_ERROR); /* state not clobbered */
-    switch (ret) {
-      case Z_NEED_DICT:
-        ret = Z_DATA_ERROR; /* and fall through */
-      case Z_DATA_ERROR:
-      case Z_MEM_ERROR:
-        (void)inflateEnd(&strm);
-        return false;
-    }
-    have = ZLIB_CHUNK - strm.avail_out;
-    out.append((char*)buf, have);
-  } while (strm.avail_out == 0);
-
-  /* clean up and return */
-  (void)::inflateEnd(&strm);
-
-  return ret == Z_STREAM_END;
+  return CompressionCodec::of(CompressionType::ZLIB)->uncompress(in.array(), in.size(), out);
 }
 
 bool UtilAll::ReplaceFile(const std::string& from_path, const std::string& to_path) {
@@ -17,9 +17,12 @@
 #ifndef ROCKETMQ_CONCURRENT_EXECUTORIMPL_HPP_
 #define ROCKETMQ_CONCURRENT_EXECUTORIMPL_HPP_
 
+#include <algorithm>
 #include <atomic>
+#include <condition_variable>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <queue>
 
 #include "concurrent_queue.hpp"
@@ -128,6 +131,143 @@ class thread_pool_executor : public abstract_executor_service {
   std::atomic<int> free_threads_;
 };
 
+/**
+ * sharded_thread_pool_executor - thread pool with one task lane per thread
+ *
+ * a task submitted with a key always goes to the same lane, so related tasks run on the same thread
+ * and the threads don't contend on one shared queue. a thread whose lane is empty steals from the other
+ * lanes before it goes to sleep, and a busy lane wakes up an idle thread to steal its new tasks.
+ */
+class sharded_thread_pool_executor : public abstract_executor_service {
+ public:
+  explicit sharded_thread_pool_executor(const std::string& name,
+                                        std::size_t thread_nums,
+                                        bool start_immediately = true)
+      : state_(STOP), thread_nums_(std::max<std::size_t>(thread_nums, 1)), thread_group_(name), next_lane_(0) {
+    if (start_immediately) {
+      startup();
+    }
+  }
+
+  void startup() {
+    if (state_ == STOP) {
+      lanes_.reset(new lane[thread_nums_]);
+      state_ = RUNNING;
+      for (std::size_t i = 0; i < thread_nums_; i++) {
+        thread_group_.create_thread(std::bind(&sharded_thread_pool_executor::run, this, i));
+      }
+      thread_group_.start();
+    }
+  }
+
+  void shutdown(bool immediately = true) override {
+    if (state_ == RUNNING) {
+      state_ = immediately ? STOP : SHUTDOWN;
+      for (std::size_t i = 0; i < thread_nums_; i++) {
+        std::lock_guard<std::mutex> lock(lanes_[i].mutex);
+        lanes_[i].event.notify_all();
+      }
+      thread_group_.join();
+      state_ = STOP;
+    }
+  }
+
+  bool is_shutdown() override { return state_ != RUNNING; }
+
+  std::size_t thread_nums() { return thread_nums_; }
+  void set_thread_nums(std::size_t thread_nums) { thread_nums_ = std::max<std::size_t>(thread_nums, 1); }
+
+  using abstract_executor_service::submit;
+
+  // tasks with the same key are queued on the same lane
+  std::future<void> submit(std::size_t key, const handler_type& task) {
+    std::unique_ptr<executor_handler> handler(new executor_handler(const_cast<handler_type&>(task)));
+    std::future<void> fut = handler->promise_->get_future();
+    execute(key % thread_nums_, std::move(handler));
+    return fut;
+  }
+
+ protected:
+  static const unsigned int ACCEPT_NEW_TASKS = 1U << 0U;
+  static const unsigned int PROCESS_QUEUED_TASKS = 1U << 1U;
+
+  enum state { STOP = 0, SHUTDOWN = PROCESS_QUEUED_TASKS, RUNNING = ACCEPT_NEW_TASKS | PROCESS_QUEUED_TASKS };
+
+  void execute(std::unique_ptr<executor_handler> command) override {
+    execute(next_lane_.fetch_add(1) % thread_nums_, std::move(command));
+  }
+
+  void execute(std::size_t index, std::unique_ptr<executor_handler> command) {
+    if (!(state_ & ACCEPT_NEW_TASKS)) {
+      command->abort(std::logic_error("executor don't accept new tasks."));
+      return;
+    }
+
+    lanes_[index].tasks.push_back(command.release());
+    for (std::size_t i = 0; i < thread_nums_; i++) {
+      // prefer the owner of the lane, otherwise let an idle thread steal the task
+      auto& target = lanes_[(index + i) % thread_nums_];
+      if (target.idle.load()) {
+        std::lock_guard<std::mutex> lock(target.mutex);
+        target.event.notify_one();
+        break;
+      }
+    }
+  }
+
+  void run(std::size_t index) {
+    auto& own = lanes_[index];
+    while (state_ & PROCESS_QUEUED_TASKS) {
+      auto task = own.tasks.pop_front();
+      for (std::size_t i = 1; task == nullptr && i < thread_nums_; i++) {
+        task = lanes_[(index + i) % thread_nums_].tasks.pop_front();
+      }
+      if (task != nullptr) {
+        task->operator()();
+        continue;
+      }
+
+      if (!(state_ & ACCEPT_NEW_TASKS)) {
+        // don't accept new tasks
+        break;
+      }
+
+      // wait new tasks, a task pushed after idle is set is either seen here or followed by a notify
+      std::unique_lock<std::mutex> lock(own.mutex);
+      own.idle.store(true);
+      if ((state_ & ACCEPT_NEW_TASKS) && !has_tasks()) {
+        own.event.wait_for(lock, std::chrono::seconds(5));
+      }
+      own.idle.store(false);
+    }
+  }
+
+  bool has_tasks() {
+    for (std::size_t i = 0; i < thread_nums_; i++) {
+      if (!lanes_[i].tasks.empty()) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+ private:
+  struct lane {
+    concurrent_queue<executor_handler> tasks;
+    std::mutex mutex;
+    std::condition_variable event;
+    std::atomic<bool> idle{false};
+  };
+
+  std::atomic<unsigned int> state_;
+
+  std::size_t thread_nums_;
+  thread_group thread_group_;
+
+  std::unique_ptr<lane[]> lanes_;
+  std::atomic<std::size_t> next_lane_;
+};
+
 struct scheduled_executor_handler : public executor_handler {
   std::chrono::steady_clock::time_point wakeup_time_;
 
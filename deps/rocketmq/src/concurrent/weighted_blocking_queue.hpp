@@ -0,0 +1,159 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ROCKETMQ_CONCURRENT_WEIGHTEDBLOCKINGQUEUE_HPP_
+#define ROCKETMQ_CONCURRENT_WEIGHTEDBLOCKINGQUEUE_HPP_
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "time.hpp"
+
+namespace rocketmq {
+
+/**
+ * weighted_blocking_queue - a queue whose elements carry a message count and a size in bytes
+ *
+ * The totals are bounded by a capacity. push_back never blocks, producers check full() and back off
+ * instead; drain() takes several elements at once within a count/byte budget.
+ */
+template <typename T>
+class weighted_blocking_queue {
+ public:
+  // types:
+  typedef T value_type;
+
+  virtual ~weighted_blocking_queue() = default;
+
+  // max_count or max_bytes <= 0 means that dimension is unbounded
+  void set_capacity(int64_t max_count, int64_t max_bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    max_count_ = max_count;
+    max_bytes_ = max_bytes;
+  }
+
+  bool full() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return (max_count_ > 0 && count_ >= max_count_) || (max_bytes_ > 0 && bytes_ >= max_bytes_);
+  }
+
+  bool empty() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.empty();
+  }
+
+  size_t size() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.size();
+  }
+
+  int64_t count() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return count_;
+  }
+
+  int64_t bytes() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return bytes_;
+  }
+
+  void push_back(value_type* v, int64_t count, int64_t bytes) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    queue_.push_back(entry{std::unique_ptr<value_type>(v), count, bytes});
+    count_ += count;
+    bytes_ += bytes;
+    cv_.notify_one();
+  }
+
+  /**
+   * drain - wait up to timeout for an element, then take following ones as long as the batch stays within
+   * max_count and max_bytes (<= 0 means unlimited). The first element is always taken whatever its weight.
+   * Elements matching discard are dropped on the way and never returned.
+   */
+  template <typename Predicate>
+  std::vector<std::unique_ptr<value_type>> drain(long timeout,
+                                                 time_unit unit,
+                                                 int64_t max_count,
+                                                 int64_t max_bytes,
+                                                 Predicate discard) {
+    auto deadline = until_time_point(timeout, unit);
+    std::vector<std::unique_ptr<value_type>> batch;
+    int64_t batch_count = 0;
+    int64_t batch_bytes = 0;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (batch.empty()) {
+      if (!cv_.wait_until(lock, deadline, [&] { return !queue_.empty(); })) {
+        break;
+      }
+      while (!queue_.empty()) {
+        auto& front = queue_.front();
+        if (!discard(*front.value)) {
+          if (!batch.empty() && ((max_count > 0 && batch_count + front.count > max_count) ||
+                                 (max_bytes > 0 && batch_bytes + front.bytes > max_bytes))) {
+            break;
+          }
+          batch_count += front.count;
+          batch_bytes += front.bytes;
+          batch.push_back(std::move(front.value));
+        }
+        count_ -= front.count;
+        bytes_ -= front.bytes;
+        queue_.pop_front();
+      }
+    }
+    return batch;
+  }
+
+  template <typename Predicate>
+  size_t remove_if(Predicate pred) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t size = queue_.size();
+    for (auto it = queue_.begin(); it != queue_.end();) {
+      if (pred(*it->value)) {
+        count_ -= it->count;
+        bytes_ -= it->bytes;
+        it = queue_.erase(it);
+      } else {
+        it++;
+      }
+    }
+    return size - queue_.size();
+  }
+
+ private:
+  struct entry {
+    std::unique_ptr<value_type> value;
+    int64_t count;
+    int64_t bytes;
+  };
+
+  std::deque<entry> queue_;
+  int64_t count_ = 0;
+  int64_t bytes_ = 0;
+  int64_t max_count_ = 0;
+  int64_t max_bytes_ = 0;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+};
+
+}  // namespace rocketmq
+
+#endif  // ROCKETMQ_CONCURRENT_WEIGHTEDBLOCKINGQUEUE_HPP_
@@ -34,7 +34,8 @@ class MessageQueueState {
         paused_(false),
         pull_offset_(-1),
         consume_offset_(-1),
-        seek_offset_(-1) {}
+        seek_offset_(-1),
+        seek_generation_(0) {}
 
   inline const MQMessageQueue& message_queue() const { return message_queue_; }
   inline void set_message_queue(const MQMessageQueue message_queue) { message_queue_ = message_queue; }
@@ -54,6 +55,9 @@ class MessageQueueState {
   inline int64_t seek_offset() const { return seek_offset_; }
   inline void set_seek_offset(int64_t seek_offset) { seek_offset_ = seek_offset; }
 
+  inline int64_t seek_generation() const { return seek_generation_; }
+  inline void next_seek_generation() { seek_generation_++; }
+
  private:
   MQMessageQueue message_queue_;
   ProcessQueuePtr process_queue_;
@@ -61,6 +65,7 @@ class MessageQueueState {
   volatile int64_t pull_offset_;
   volatile int64_t consume_offset_;
   volatile int64_t seek_offset_;
+  volatile int64_t seek_generation_;  // bumped by every seek, results of pulls issued before it are dropped
 };
 
 class AssignedMessageQueue {
@@ -171,10 +176,23 @@ class AssignedMessageQueue {
     auto it = assigned_message_queue_state_.find(message_queue);
     if (it != assigned_message_queue_state_.end()) {
       auto& message_queue_state = it->second;
+      if (offset != -1) {
+        message_queue_state.next_seek_generation();
+      }
       return message_queue_state.set_seek_offset(offset);
     }
   }
 
+  int64_t getSeekGeneration(const MQMessageQueue& message_queue) {
+    std::lock_guard<std::mutex> lock(assigned_message_queue_state_mutex_);
+    auto it = assigned_message_queue_state_.find(message_queue);
+    if (it != assigned_message_queue_state_.end()) {
+      auto& message_queue_state = it->second;
+      return message_queue_state.seek_generation();
+    }
+    return -1;
+  }
+
   void updateAssignedMessageQueue(const std::string& topic, std::vector<MQMessageQueue>& assigned) {
     std::sort(assigned.begin(), assigned.end());
     std::lock_guard<std::mutex> lock(assigned_message_queue_state_mutex_);
@@ -191,6 +209,20 @@ class AssignedMessageQueue {
     addAssignedMessageQueue(assigned);
   }
 
+  // replace the queues of all topics, used by assign()
+  void updateAssignedMessageQueue(std::vector<MQMessageQueue>& assigned) {
+    std::sort(assigned.begin(), assigned.end());
+    std::lock_guard<std::mutex> lock(assigned_message_queue_state_mutex_);
+    for (auto it = assigned_message_queue_state_.begin(); it != assigned_message_queue_state_.end();) {
+      if (!std::binary_search(assigned.begin(), assigned.end(), it->first)) {
+        it = assigned_message_queue_state_.erase(it);
+        continue;
+      }
+      it++;
+    }
+    addAssignedMessageQueue(assigned);
+  }
+
  private:
   void addAssignedMessageQueue(const std::vector<MQMessageQueue>& assigned) {
     for (const auto& message_queue : assigned) {
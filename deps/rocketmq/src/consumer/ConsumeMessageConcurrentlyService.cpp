@@ -16,6 +16,8 @@
  */
 #include "ConsumeMsgService.h"
 
+#include <algorithm>  // std::find, std::max, std::min, std::remove_if
+
 #include "Logging.h"
 #include "MessageAccessor.hpp"
 #include "OffsetStore.h"
@@ -23,15 +25,117 @@
 
 namespace rocketmq {
 
+struct ConsumeMessageConcurrentlyService::AsyncConsumeGuard {
+  std::mutex mutex;
+  ConsumeMessageConcurrentlyService* service;
+};
+
+/**
+ * AsyncConsumeCallback - completion handle passed to MQMessageListener::consumeMessageAsync
+ *
+ * if the listener completes before consumeMessageAsync returns, the result is processed inline by
+ * ConsumeRequest; otherwise it is handed back to the consume thread pool.
+ */
+class ConsumeMessageConcurrentlyService::AsyncConsumeCallback : public ConsumeCallback {
+ public:
+  AsyncConsumeCallback(std::shared_ptr<AsyncConsumeGuard> guard,
+                       const std::vector<MessageExtPtr>& msgs,
+                       ProcessQueuePtr processQueue,
+                       const MQMessageQueue& messageQueue)
+      : guard_(std::move(guard)),
+        msgs_(msgs),
+        process_queue_(std::move(processQueue)),
+        message_queue_(messageQueue),
+        status_(RECONSUME_LATER),
+        completed_(false),
+        state_(DISPATCHING) {}
+
+  void onComplete(ConsumeStatus status) override {
+    if (completed_.exchange(true)) {
+      return;
+    }
+    status_ = status;
+    finish();
+  }
+
+  void onPartialComplete(const std::vector<bool>& acks) override {
+    if (completed_.exchange(true)) {
+      return;
+    }
+    acks_ = acks;
+    acks_.resize(msgs_.size(), false);
+    status_ = std::find(acks_.begin(), acks_.end(), false) == acks_.end() ? CONSUME_SUCCESS : RECONSUME_LATER;
+    finish();
+  }
+
+  // return true if the listener has completed synchronously
+  bool markReturned() { return state_.exchange(RETURNED) == COMPLETED; }
+
+  ConsumeStatus status() const { return status_; }
+  const std::vector<bool>& acks() const { return acks_; }
+
+ private:
+  enum State { DISPATCHING, RETURNED, COMPLETED };
+
+  void finish() {
+    if (state_.exchange(COMPLETED) == RETURNED) {
+      std::lock_guard<std::mutex> lock(guard_->mutex);
+      if (guard_->service != nullptr) {
+        guard_->service->submitConsumeResult(status_, acks_, msgs_, process_queue_, message_queue_);
+      }
+    }
+  }
+
+  std::shared_ptr<AsyncConsumeGuard> guard_;
+  std::vector<MessageExtPtr> msgs_;
+  ProcessQueuePtr process_queue_;
+  MQMessageQueue message_queue_;
+  ConsumeStatus status_;
+  std::vector<bool> acks_;  // empty unless completed by onPartialComplete
+  std::atomic<bool> completed_;
+  std::atomic<int> state_;
+};
+
+/**
+ * SendBackRequest - failed messages of one consume result, sent back to the broker together
+ *
+ * the requests are pipelined on the broker connection without blocking the consume thread. once every
+ * message has been answered, the ones failed to be sent back are re-consumed locally and the rest of the
+ * consume result is removed from the process queue.
+ */
+struct ConsumeMessageConcurrentlyService::SendBackRequest {
+  SendBackRequest(std::vector<MessageExtPtr> msgs,
+                  ProcessQueuePtr processQueue,
+                  const MQMessageQueue& messageQueue,
+                  size_t count)
+      : msgs(std::move(msgs)),
+        process_queue(std::move(processQueue)),
+        message_queue(messageQueue),
+        remaining(count) {}
+
+  std::vector<MessageExtPtr> msgs;
+  ProcessQueuePtr process_queue;
+  MQMessageQueue message_queue;
+
+  std::mutex mutex;
+  std::vector<MessageExtPtr> msg_back_failed;
+  std::atomic<size_t> remaining;
+};
+
 ConsumeMessageConcurrentlyService::ConsumeMessageConcurrentlyService(DefaultMQPushConsumerImpl* consumer,
                                                                      int threadCount,
                                                                      MQMessageListener* msgListener)
     : consumer_(consumer),
       message_listener_(msgListener),
       consume_executor_("ConsumeMessageThread", threadCount, false),
-      scheduled_executor_service_("ConsumeMessageScheduledThread", false) {}
+      scheduled_executor_service_("ConsumeMessageScheduledThread", false),
+      async_guard_(new AsyncConsumeGuard{{}, this}),
+      send_back_in_flight_(0) {}
 
-ConsumeMessageConcurrentlyService::~ConsumeMessageConcurrentlyService() = default;
+ConsumeMessageConcurrentlyService::~ConsumeMessageConcurrentlyService() {
+  std::lock_guard<std::mutex> lock(async_guard_->mutex);
+  async_guard_->service = nullptr;
+}
 
 void ConsumeMessageConcurrentlyService::start() {
   // start callback threadpool
@@ -48,8 +152,25 @@ void ConsumeMessageConcurrentlyService::submitConsumeRequest(std::vector<Message
                                                              ProcessQueuePtr processQueue,
                                                              const MQMessageQueue& messageQueue,
                                                              const bool dispathToConsume) {
-  consume_executor_.submit(
-      std::bind(&ConsumeMessageConcurrentlyService::ConsumeRequest, this, msgs, processQueue, messageQueue));
+  const size_t consumeBatchSize =
+      std::max(consumer_->getDefaultMQPushConsumerConfig()->consume_message_batch_max_size(), 1);
+  if (msgs.size() <= consumeBatchSize) {
+    consume_executor_.submit(
+        shardOf(messageQueue),
+        std::bind(&ConsumeMessageConcurrentlyService::ConsumeRequest, this, msgs, processQueue, messageQueue));
+    return;
+  }
+
+  // split the pulled messages, so that every chunk can be consumed by a different thread.
+  // each chunk is committed by itself through ProcessQueue::removeMessage.
+  // the chunks share the lane of the queue, idle threads steal them from there.
+  const auto shard = shardOf(messageQueue);
+  for (size_t begin = 0; begin < msgs.size(); begin += consumeBatchSize) {
+    const size_t end = std::min(begin + consumeBatchSize, msgs.size());
+    std::vector<MessageExtPtr> msgThis(msgs.begin() + begin, msgs.begin() + end);
+    consume_executor_.submit(shard, std::bind(&ConsumeMessageConcurrentlyService::ConsumeRequest, this, msgThis,
+                                              processQueue, messageQueue));
+  }
 }
 
 void ConsumeMessageConcurrentlyService::submitConsumeRequestLater(std::vector<MessageExtPtr>& msgs,
@@ -60,6 +181,16 @@ void ConsumeMessageConcurrentlyService::submitConsumeRequestLater(std::vector<Me
       5000L, time_unit::milliseconds);
 }
 
+void ConsumeMessageConcurrentlyService::submitConsumeResult(ConsumeStatus status,
+                                                            const std::vector<bool>& acks,
+                                                            std::vector<MessageExtPtr>& msgs,
+                                                            ProcessQueuePtr processQueue,
+                                                            const MQMessageQueue& messageQueue) {
+  consume_executor_.submit(shardOf(messageQueue), [this, status, acks, msgs, processQueue, messageQueue]() mutable {
+    processConsumeResult(status, acks, msgs, processQueue, messageQueue);
+  });
+}
+
 void ConsumeMessageConcurrentlyService::ConsumeRequest(std::vector<MessageExtPtr>& msgs,
                                                        ProcessQueuePtr processQueue,
                                                        const MQMessageQueue& messageQueue) {
@@ -77,7 +208,7 @@ void ConsumeMessageConcurrentlyService::ConsumeRequest(std::vector<MessageExtPtr
 
   consumer_->resetRetryAndNamespace(msgs);  // set where to sendMessageBack
 
-  ConsumeStatus status = RECONSUME_LATER;
+  auto callback = std::make_shared<AsyncConsumeCallback>(async_guard_, msgs, processQueue, messageQueue);
   try {
     auto consumeTimestamp = UtilAll::currentTimeMillis();
     processQueue->set_last_consume_timestamp(consumeTimestamp);
@@ -88,11 +219,29 @@ void ConsumeMessageConcurrentlyService::ConsumeRequest(std::vector<MessageExtPtr
       }
     }
     auto message_list = MQMessageExt::from_list(msgs);
-    status = message_listener_->consumeMessage(message_list);
+    message_listener_->consumeMessageAsync(message_list, callback);
   } catch (const std::exception& e) {
     LOG_WARN_NEW("encounter unexpected exception when consume messages.\n{}", e.what());
+    callback->onComplete(RECONSUME_LATER);
+  }
+
+  if (callback->markReturned()) {
+    processConsumeResult(callback->status(), callback->acks(), msgs, processQueue, messageQueue);
   }
+}
 
+void ConsumeMessageConcurrentlyService::processConsumeResult(ConsumeStatus status,
+                                                             std::vector<MessageExtPtr>& msgs,
+                                                             ProcessQueuePtr processQueue,
+                                                             const MQMessageQueue& messageQueue) {
+  processConsumeResult(status, std::vector<bool>(), msgs, processQueue, messageQueue);
+}
+
+void ConsumeMessageConcurrentlyService::processConsumeResult(ConsumeStatus status,
+                                                             const std::vector<bool>& acks,
+                                                             std::vector<MessageExtPtr>& msgs,
+                                                             ProcessQueuePtr processQueue,
+                                                             const MQMessageQueue& messageQueue) {
   if (processQueue->dropped()) {
     LOG_WARN_NEW("processQueue is dropped without process consume result. messageQueue={}", messageQueue.toString());
     return;
@@ -113,41 +262,107 @@ void ConsumeMessageConcurrentlyService::ConsumeRequest(std::vector<MessageExtPtr
       break;
   }
 
+  // with per-message results only the messages not acknowledged are failed, otherwise all after ackIndex
+  auto consumed = [&acks, ackIndex](size_t idx) {
+    return acks.empty() ? static_cast<int>(idx) <= ackIndex : idx < acks.size() && acks[idx];
+  };
+
   switch (consumer_->messageModel()) {
     case BROADCASTING:
       // Note: broadcasting reconsume should do by application, as it has big affect to broker cluster
-      for (size_t i = ackIndex + 1; i < msgs.size(); i++) {
+      for (size_t i = 0; i < msgs.size(); i++) {
+        if (consumed(i)) {
+          continue;
+        }
         const auto& msg = msgs[i];
         LOG_WARN_NEW("BROADCASTING, the message consume failed, drop it, {}", msg->toString());
       }
       break;
     case CLUSTERING: {
       // send back msg to broker
-      std::vector<MessageExtPtr> msgBackFailed;
-      int idx = ackIndex + 1;
-      for (auto iter = msgs.begin() + idx; iter != msgs.end(); idx++) {
-        LOG_WARN_NEW("consume fail, MQ is:{}, its msgId is:{}, index is:{}, reconsume times is:{}",
-                     messageQueue.toString(), (*iter)->msg_id(), idx, (*iter)->reconsume_times());
-        auto& msg = (*iter);
-        bool result = consumer_->sendMessageBack(msg, 0, messageQueue.broker_name());
-        if (!result) {
-          msg->set_reconsume_times(msg->reconsume_times() + 1);
-          msgBackFailed.push_back(msg);
-          iter = msgs.erase(iter);
-        } else {
-          iter++;
+      std::vector<MessageExtPtr> msgBack;
+      for (size_t idx = 0; idx < msgs.size(); idx++) {
+        if (consumed(idx)) {
+          continue;
         }
+        const auto& msg = msgs[idx];
+        LOG_WARN_NEW("consume fail, MQ is:{}, its msgId is:{}, index is:{}, reconsume times is:{}",
+                     messageQueue.toString(), msg->msg_id(), idx, msg->reconsume_times());
+        msgBack.push_back(msg);
       }
 
-      if (!msgBackFailed.empty()) {
-        // send back failed, reconsume later
-        submitConsumeRequestLater(msgBackFailed, processQueue, messageQueue);
+      if (!msgBack.empty()) {
+        // the offset is updated once the broker answered, see onSendBackComplete
+        sendMessageBack(msgBack, msgs, processQueue, messageQueue);
+        return;
       }
     } break;
     default:
       break;
   }
 
+  removeConsumedMessages(msgs, processQueue, messageQueue);
+}
+
+void ConsumeMessageConcurrentlyService::sendMessageBack(const std::vector<MessageExtPtr>& msgBack,
+                                                        std::vector<MessageExtPtr>& msgs,
+                                                        ProcessQueuePtr processQueue,
+                                                        const MQMessageQueue& messageQueue) {
+  auto request = std::make_shared<SendBackRequest>(msgs, processQueue, messageQueue, msgBack.size());
+  for (const auto& msg : msgBack) {
+    if (send_back_in_flight_.fetch_add(1) >= kMaxSendBackInFlight) {
+      // too many requests are waiting for the broker, reconsume the message locally instead
+      send_back_in_flight_--;
+      LOG_WARN_NEW("too many messages are being sent back, reconsume later. msgId:{}", msg->msg_id());
+      onSendBackComplete(request, msg, false);
+      continue;
+    }
+
+    auto guard = async_guard_;
+    consumer_->sendMessageBackAsync(msg, 0, messageQueue.broker_name(), [guard, request, msg](bool success) {
+      std::lock_guard<std::mutex> lock(guard->mutex);
+      if (guard->service != nullptr) {
+        guard->service->send_back_in_flight_--;
+        guard->service->onSendBackComplete(request, msg, success);
+      }
+    });
+  }
+}
+
+void ConsumeMessageConcurrentlyService::onSendBackComplete(std::shared_ptr<SendBackRequest> request,
+                                                           MessageExtPtr msg,
+                                                           bool success) {
+  if (!success) {
+    msg->set_reconsume_times(msg->reconsume_times() + 1);
+    std::lock_guard<std::mutex> lock(request->mutex);
+    request->msg_back_failed.push_back(msg);
+  }
+
+  if (request->remaining.fetch_sub(1) != 1) {
+    return;
+  }
+
+  // every message has been answered
+  auto& msgs = request->msgs;
+  auto& msgBackFailed = request->msg_back_failed;
+  if (!msgBackFailed.empty()) {
+    msgs.erase(std::remove_if(msgs.begin(), msgs.end(),
+                              [&msgBackFailed](const MessageExtPtr& msg) {
+                                return std::find(msgBackFailed.begin(), msgBackFailed.end(), msg) !=
+                                       msgBackFailed.end();
+                              }),
+               msgs.end());
+
+    // send back failed, reconsume later
+    submitConsumeRequestLater(msgBackFailed, request->process_queue, request->message_queue);
+  }
+
+  removeConsumedMessages(msgs, request->process_queue, request->message_queue);
+}
+
+void ConsumeMessageConcurrentlyService::removeConsumedMessages(std::vector<MessageExtPtr>& msgs,
+                                                               ProcessQueuePtr processQueue,
+                                                               const MQMessageQueue& messageQueue) {
   // update offset
   int64_t offset = processQueue->removeMessage(msgs);
   if (offset >= 0 && !processQueue->dropped()) {
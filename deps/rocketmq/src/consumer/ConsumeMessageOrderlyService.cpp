@@ -16,6 +16,8 @@
  */
 #include "ConsumeMsgService.h"
 
+#include <algorithm>  // std::find, std::max, std::min
+
 #include "Logging.h"
 #include "OffsetStore.h"
 #include "RebalanceImpl.h"
@@ -25,15 +27,91 @@ namespace rocketmq {
 
 const uint64_t MAX_TIME_CONSUME_CONTINUOUSLY = 60000;
 
+struct ConsumeMessageOrderlyService::AsyncConsumeGuard {
+  std::mutex mutex;
+  ConsumeMessageOrderlyService* service;
+};
+
+/**
+ * AsyncConsumeCallback - completion handle of one orderly batch
+ *
+ * while the batch is in flight the process queue is marked consuming, so no other batch of the same
+ * queue is dispatched. if the listener completes after consumeMessageAsync returned, the result is
+ * handed back to the consume thread pool, which then continues with the next batch of the queue.
+ */
+class ConsumeMessageOrderlyService::AsyncConsumeCallback : public ConsumeCallback {
+ public:
+  AsyncConsumeCallback(std::shared_ptr<AsyncConsumeGuard> guard,
+                       const std::vector<MessageExtPtr>& msgs,
+                       ProcessQueuePtr processQueue,
+                       const MQMessageQueue& messageQueue)
+      : guard_(std::move(guard)),
+        msgs_(msgs),
+        process_queue_(std::move(processQueue)),
+        message_queue_(messageQueue),
+        status_(RECONSUME_LATER),
+        completed_(false),
+        state_(DISPATCHING) {}
+
+  void onComplete(ConsumeStatus status) override {
+    if (completed_.exchange(true)) {
+      return;
+    }
+    status_ = status;
+    finish();
+  }
+
+  void onPartialComplete(const std::vector<bool>& acks) override {
+    if (completed_.exchange(true)) {
+      return;
+    }
+    acks_ = acks;
+    acks_.resize(msgs_.size(), false);
+    status_ = std::find(acks_.begin(), acks_.end(), false) == acks_.end() ? CONSUME_SUCCESS : RECONSUME_LATER;
+    finish();
+  }
+
+  // return true if the listener has completed synchronously
+  bool markReturned() { return state_.exchange(RETURNED) == COMPLETED; }
+
+  ConsumeStatus status() const { return status_; }
+  const std::vector<bool>& acks() const { return acks_; }
+
+ private:
+  enum State { DISPATCHING, RETURNED, COMPLETED };
+
+  void finish() {
+    if (state_.exchange(COMPLETED) == RETURNED) {
+      std::lock_guard<std::mutex> lock(guard_->mutex);
+      if (guard_->service != nullptr) {
+        guard_->service->submitConsumeResult(status_, acks_, msgs_, process_queue_, message_queue_);
+      }
+    }
+  }
+
+  std::shared_ptr<AsyncConsumeGuard> guard_;
+  std::vector<MessageExtPtr> msgs_;
+  ProcessQueuePtr process_queue_;
+  MQMessageQueue message_queue_;
+  ConsumeStatus status_;
+  std::vector<bool> acks_;  // empty unless completed by onPartialComplete
+  std::atomic<bool> completed_;
+  std::atomic<int> state_;
+};
+
 ConsumeMessageOrderlyService::ConsumeMessageOrderlyService(DefaultMQPushConsumerImpl* consumer,
                                                            int threadCount,
                                                            MQMessageListener* msgListener)
     : consumer_(consumer),
       message_listener_(msgListener),
       consume_executor_("OderlyConsumeService", threadCount, false),
-      scheduled_executor_service_(false) {}
+      scheduled_executor_service_(false),
+      async_guard_(new AsyncConsumeGuard{{}, this}) {}
 
-ConsumeMessageOrderlyService::~ConsumeMessageOrderlyService() = default;
+ConsumeMessageOrderlyService::~ConsumeMessageOrderlyService() {
+  std::lock_guard<std::mutex> lock(async_guard_->mutex);
+  async_guard_->service = nullptr;
+}
 
 void ConsumeMessageOrderlyService::start() {
   consume_executor_.startup();
@@ -74,6 +152,7 @@ void ConsumeMessageOrderlyService::submitConsumeRequest(std::vector<MessageExtPt
                                                         const bool dispathToConsume) {
   if (dispathToConsume) {
     consume_executor_.submit(
+        shardOf(messageQueue),
         std::bind(&ConsumeMessageOrderlyService::ConsumeRequest, this, processQueue, messageQueue));
   }
 }
@@ -109,6 +188,20 @@ void ConsumeMessageOrderlyService::tryLockLaterAndReconsume(const MQMessageQueue
       delayMills, time_unit::milliseconds);
 }
 
+void ConsumeMessageOrderlyService::submitConsumeResult(ConsumeStatus status,
+                                                       const std::vector<bool>& acks,
+                                                       std::vector<MessageExtPtr>& msgs,
+                                                       ProcessQueuePtr processQueue,
+                                                       const MQMessageQueue& messageQueue) {
+  consume_executor_.submit(shardOf(messageQueue), [this, status, acks, msgs, processQueue, messageQueue]() mutable {
+    auto objLock = message_queue_lock_.fetchLockObject(messageQueue);
+    std::lock_guard<std::mutex> lock(*objLock);
+    if (processConsumeResult(status, acks, msgs, processQueue, messageQueue)) {
+      consumeMessages(processQueue, messageQueue);
+    }
+  });
+}
+
 void ConsumeMessageOrderlyService::ConsumeRequest(ProcessQueuePtr processQueue, const MQMessageQueue& messageQueue) {
   if (processQueue->dropped()) {
     LOG_WARN_NEW("run, the message queue not be able to consume, because it's dropped. {}", messageQueue.toString());
@@ -118,82 +211,120 @@ void ConsumeMessageOrderlyService::ConsumeRequest(ProcessQueuePtr processQueue,
   auto objLock = message_queue_lock_.fetchLockObject(messageQueue);
   std::lock_guard<std::mutex> lock(*objLock);
 
+  if (processQueue->consuming()) {
+    // a batch is in flight, the queue goes on once it is completed, see submitConsumeResult
+    return;
+  }
+
   if (BROADCASTING == consumer_->messageModel() || (processQueue->locked() && !processQueue->isLockExpired())) {
-    auto beginTime = UtilAll::currentTimeMillis();
-    for (bool continueConsume = true; continueConsume;) {
-      if (processQueue->dropped()) {
-        LOG_WARN_NEW("the message queue not be able to consume, because it's dropped. {}", messageQueue.toString());
-        break;
-      }
+    consumeMessages(processQueue, messageQueue);
+  } else {
+    if (processQueue->dropped()) {
+      LOG_WARN_NEW("the message queue not be able to consume, because it's dropped. {}", messageQueue.toString());
+      return;
+    }
 
-      if (CLUSTERING == consumer_->messageModel() && !processQueue->locked()) {
-        LOG_WARN_NEW("the message queue not locked, so consume later, {}", messageQueue.toString());
-        tryLockLaterAndReconsume(messageQueue, processQueue, 10);
-        break;
-      }
+    tryLockLaterAndReconsume(messageQueue, processQueue, 100);
+  }
+}
 
-      if (CLUSTERING == consumer_->messageModel() && processQueue->isLockExpired()) {
-        LOG_WARN_NEW("the message queue lock expired, so consume later, {}", messageQueue.toString());
-        tryLockLaterAndReconsume(messageQueue, processQueue, 10);
-        break;
-      }
+void ConsumeMessageOrderlyService::consumeMessages(ProcessQueuePtr processQueue, const MQMessageQueue& messageQueue) {
+  auto beginTime = UtilAll::currentTimeMillis();
+  for (;;) {
+    if (processQueue->dropped()) {
+      LOG_WARN_NEW("the message queue not be able to consume, because it's dropped. {}", messageQueue.toString());
+      return;
+    }
 
-      auto interval = UtilAll::currentTimeMillis() - beginTime;
-      if (interval > MAX_TIME_CONSUME_CONTINUOUSLY) {
-        submitConsumeRequestLater(processQueue, messageQueue, 10);
-        break;
-      }
+    if (CLUSTERING == consumer_->messageModel() && !processQueue->locked()) {
+      LOG_WARN_NEW("the message queue not locked, so consume later, {}", messageQueue.toString());
+      tryLockLaterAndReconsume(messageQueue, processQueue, 10);
+      return;
+    }
 
-      const int consumeBatchSize = consumer_->getDefaultMQPushConsumerConfig()->consume_message_batch_max_size();
-
-      std::vector<MessageExtPtr> msgs;
-      processQueue->takeMessages(msgs, consumeBatchSize);
-      consumer_->resetRetryAndNamespace(msgs);
-      if (!msgs.empty()) {
-        ConsumeStatus status = RECONSUME_LATER;
-        try {
-          std::lock_guard<std::timed_mutex> lock(processQueue->lock_consume());
-          if (processQueue->dropped()) {
-            LOG_WARN_NEW("consumeMessage, the message queue not be able to consume, because it's dropped. {}",
-                         messageQueue.toString());
-            break;
-          }
-          auto message_list = MQMessageExt::from_list(msgs);
-          status = message_listener_->consumeMessage(message_list);
-        } catch (const std::exception& e) {
-          LOG_WARN_NEW("encounter unexpected exception when consume messages.\n{}", e.what());
-        }
+    if (CLUSTERING == consumer_->messageModel() && processQueue->isLockExpired()) {
+      LOG_WARN_NEW("the message queue lock expired, so consume later, {}", messageQueue.toString());
+      tryLockLaterAndReconsume(messageQueue, processQueue, 10);
+      return;
+    }
 
-        // processConsumeResult
-        long commitOffset = -1L;
-        switch (status) {
-          case CONSUME_SUCCESS:
-            commitOffset = processQueue->commit();
-            break;
-          case RECONSUME_LATER:
-            processQueue->makeMessageToCosumeAgain(msgs);
-            submitConsumeRequestLater(processQueue, messageQueue, -1);
-            continueConsume = false;
-            break;
-          default:
-            break;
-        }
+    auto interval = UtilAll::currentTimeMillis() - beginTime;
+    if (interval > MAX_TIME_CONSUME_CONTINUOUSLY) {
+      submitConsumeRequestLater(processQueue, messageQueue, 10);
+      return;
+    }
 
-        if (commitOffset >= 0 && !processQueue->dropped()) {
-          consumer_->getOffsetStore()->updateOffset(messageQueue, commitOffset, false);
-        }
-      } else {
-        continueConsume = false;
+    const int consumeBatchSize = consumer_->getDefaultMQPushConsumerConfig()->consume_message_batch_max_size();
+
+    std::vector<MessageExtPtr> msgs;
+    processQueue->takeMessages(msgs, consumeBatchSize);
+    consumer_->resetRetryAndNamespace(msgs);
+    if (msgs.empty()) {
+      return;
+    }
+
+    auto callback = std::make_shared<AsyncConsumeCallback>(async_guard_, msgs, processQueue, messageQueue);
+    {
+      // rebalance holds lock_consume before unlocking the queue, the in-flight batch is seen by consuming()
+      std::lock_guard<std::timed_mutex> lock(processQueue->lock_consume());
+      if (processQueue->dropped()) {
+        LOG_WARN_NEW("consumeMessage, the message queue not be able to consume, because it's dropped. {}",
+                     messageQueue.toString());
+        return;
+      }
+      processQueue->set_consuming(true);
+      try {
+        auto message_list = MQMessageExt::from_list(msgs);
+        message_listener_->consumeMessageAsync(message_list, callback);
+      } catch (const std::exception& e) {
+        LOG_WARN_NEW("encounter unexpected exception when consume messages.\n{}", e.what());
+        callback->onComplete(RECONSUME_LATER);
       }
     }
-  } else {
-    if (processQueue->dropped()) {
-      LOG_WARN_NEW("the message queue not be able to consume, because it's dropped. {}", messageQueue.toString());
+
+    if (!callback->markReturned()) {
+      // the consume thread is released, the result comes back through submitConsumeResult
       return;
     }
 
-    tryLockLaterAndReconsume(messageQueue, processQueue, 100);
+    if (!processConsumeResult(callback->status(), callback->acks(), msgs, processQueue, messageQueue)) {
+      return;
+    }
+  }
+}
+
+bool ConsumeMessageOrderlyService::processConsumeResult(ConsumeStatus status,
+                                                        const std::vector<bool>& acks,
+                                                        std::vector<MessageExtPtr>& msgs,
+                                                        ProcessQueuePtr processQueue,
+                                                        const MQMessageQueue& messageQueue) {
+  processQueue->set_consuming(false);
+
+  bool continueConsume = true;
+  long commitOffset = -1L;
+  switch (status) {
+    case CONSUME_SUCCESS:
+      commitOffset = processQueue->commit();
+      break;
+    case RECONSUME_LATER: {
+      // with per-message results the acknowledged prefix is committed, the rest is consumed again in order
+      size_t consumed = acks.empty() ? 0 : std::find(acks.begin(), acks.end(), false) - acks.begin();
+      std::vector<MessageExtPtr> msgsAgain(msgs.begin() + consumed, msgs.end());
+      processQueue->makeMessageToCosumeAgain(msgsAgain);
+      if (consumed > 0) {
+        commitOffset = processQueue->commit();
+      }
+      submitConsumeRequestLater(processQueue, messageQueue, -1);
+      continueConsume = false;
+    } break;
+    default:
+      break;
+  }
+
+  if (commitOffset >= 0 && !processQueue->dropped()) {
+    consumer_->getOffsetStore()->updateOffset(messageQueue, commitOffset, false);
   }
+  return continueConsume;
 }
 
 }  // namespace rocketmq
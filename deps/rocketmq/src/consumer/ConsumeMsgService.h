@@ -17,6 +17,9 @@
 #ifndef ROCKETMQ_CONSUMER_CONSUMEMSGSERVICE_H_
 #define ROCKETMQ_CONSUMER_CONSUMEMSGSERVICE_H_
 
+#include <functional>  // std::hash
+#include <string>
+
 #include "DefaultMQPushConsumerImpl.h"
 #include "Logging.h"
 #include "MQMessageListener.h"
@@ -37,6 +40,14 @@ class ConsumeMsgService {
                                     ProcessQueuePtr processQueue,
                                     const MQMessageQueue& messageQueue,
                                     const bool dispathToConsume) = 0;
+
+ protected:
+  // key of the consume executor lane the requests of messageQueue are queued on
+  static std::size_t shardOf(const MQMessageQueue& messageQueue) {
+    std::size_t seed = std::hash<std::string>()(messageQueue.topic());
+    seed = seed * 31 + std::hash<std::string>()(messageQueue.broker_name());
+    return seed * 31 + static_cast<std::size_t>(messageQueue.queue_id());
+  }
 };
 
 class ConsumeMessageConcurrentlyService : public ConsumeMsgService {
@@ -56,17 +67,54 @@ class ConsumeMessageConcurrentlyService : public ConsumeMsgService {
                       ProcessQueuePtr processQueue,
                       const MQMessageQueue& messageQueue);
 
+  void processConsumeResult(ConsumeStatus status,
+                            std::vector<MessageExtPtr>& msgs,
+                            ProcessQueuePtr processQueue,
+                            const MQMessageQueue& messageQueue);
+  // acks holds the result of each message if the listener reported them one by one, otherwise it is empty
+  void processConsumeResult(ConsumeStatus status,
+                            const std::vector<bool>& acks,
+                            std::vector<MessageExtPtr>& msgs,
+                            ProcessQueuePtr processQueue,
+                            const MQMessageQueue& messageQueue);
+
  private:
+  class AsyncConsumeCallback;
+  struct AsyncConsumeGuard;
+  struct SendBackRequest;
+
+  // upper bound of CONSUMER_SEND_MSG_BACK requests waiting for the broker
+  static const int kMaxSendBackInFlight = 1024;
+
+  void sendMessageBack(const std::vector<MessageExtPtr>& msgBack,
+                       std::vector<MessageExtPtr>& msgs,
+                       ProcessQueuePtr processQueue,
+                       const MQMessageQueue& messageQueue);
+  void onSendBackComplete(std::shared_ptr<SendBackRequest> request, MessageExtPtr msg, bool success);
+  void removeConsumedMessages(std::vector<MessageExtPtr>& msgs,
+                              ProcessQueuePtr processQueue,
+                              const MQMessageQueue& messageQueue);
+
   void submitConsumeRequestLater(std::vector<MessageExtPtr>& msgs,
                                  ProcessQueuePtr processQueue,
                                  const MQMessageQueue& messageQueue);
+  void submitConsumeResult(ConsumeStatus status,
+                           const std::vector<bool>& acks,
+                           std::vector<MessageExtPtr>& msgs,
+                           ProcessQueuePtr processQueue,
+                           const MQMessageQueue& messageQueue);
 
  private:
   DefaultMQPushConsumerImpl* consumer_;
   MQMessageListener* message_listener_;
 
-  thread_pool_executor consume_executor_;
+  sharded_thread_pool_executor consume_executor_;
   scheduled_thread_pool_executor scheduled_executor_service_;
+
+  // shared with in-flight async callbacks, detached on shutdown
+  std::shared_ptr<AsyncConsumeGuard> async_guard_;
+
+  std::atomic<int> send_back_in_flight_;
 };
 
 class ConsumeMessageOrderlyService : public ConsumeMsgService {
@@ -93,13 +141,34 @@ class ConsumeMessageOrderlyService : public ConsumeMsgService {
   void unlockAllMQ();
   bool lockOneMQ(const MQMessageQueue& mq);
 
+ private:
+  class AsyncConsumeCallback;
+  struct AsyncConsumeGuard;
+
+  // called with the lock of messageQueue held
+  void consumeMessages(ProcessQueuePtr processQueue, const MQMessageQueue& messageQueue);
+  // return true if the queue can go on consuming
+  bool processConsumeResult(ConsumeStatus status,
+                            const std::vector<bool>& acks,
+                            std::vector<MessageExtPtr>& msgs,
+                            ProcessQueuePtr processQueue,
+                            const MQMessageQueue& messageQueue);
+  void submitConsumeResult(ConsumeStatus status,
+                           const std::vector<bool>& acks,
+                           std::vector<MessageExtPtr>& msgs,
+                           ProcessQueuePtr processQueue,
+                           const MQMessageQueue& messageQueue);
+
  private:
   DefaultMQPushConsumerImpl* consumer_;
   MQMessageListener* message_listener_;
 
   MessageQueueLock message_queue_lock_;
-  thread_pool_executor consume_executor_;
+  sharded_thread_pool_executor consume_executor_;
   scheduled_thread_pool_executor scheduled_executor_service_;
+
+  // shared with in-flight async callbacks, detached on destruction
+  std::shared_ptr<AsyncConsumeGuard> async_guard_;
 };
 
 }  // namespace rocketmq
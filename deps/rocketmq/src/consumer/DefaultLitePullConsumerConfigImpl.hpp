@@ -45,8 +45,13 @@ class DefaultLitePullConsumerConfigImpl : virtual public DefaultLitePullConsumer
         broker_suspend_max_time_millis_(1000 * 20),
         pull_threshold_for_all_(10000),
         pull_threshold_for_queue_(1000),
+        pull_threshold_size_for_queue_(100),
+        pull_threshold_size_for_all_(-1),
+        consume_max_span_(2000),
         pull_time_delay_millis_when_exception_(1000),
         poll_timeout_millis_(1000 * 5),
+        poll_batch_max_size_(32),
+        poll_batch_max_bytes_(1024 * 1024 * 4),
         topic_metadata_check_interval_millis_(30 * 1000),
         allocate_mq_strategy_(new AllocateMQAveragely()) {}
   virtual ~DefaultLitePullConsumerConfigImpl() = default;
@@ -99,6 +104,19 @@ class DefaultLitePullConsumerConfigImpl : virtual public DefaultLitePullConsumer
     pull_threshold_for_queue_ = pull_threshold_for_queue;
   }
 
+  int pull_threshold_size_for_queue() const override { return pull_threshold_size_for_queue_; }
+  void set_pull_threshold_size_for_queue(int pull_threshold_size_for_queue) override {
+    pull_threshold_size_for_queue_ = pull_threshold_size_for_queue;
+  }
+
+  int pull_threshold_size_for_all() const override { return pull_threshold_size_for_all_; }
+  void set_pull_threshold_size_for_all(int pull_threshold_size_for_all) override {
+    pull_threshold_size_for_all_ = pull_threshold_size_for_all;
+  }
+
+  int consume_max_span() const override { return consume_max_span_; }
+  void set_consume_max_span(int consume_max_span) override { consume_max_span_ = consume_max_span; }
+
   long pull_time_delay_millis_when_exception() const override { return pull_time_delay_millis_when_exception_; }
   void set_pull_time_delay_millis_when_exception(long pull_time_delay_millis_when_exception) override {
     pull_time_delay_millis_when_exception_ = pull_time_delay_millis_when_exception;
@@ -107,6 +125,12 @@ class DefaultLitePullConsumerConfigImpl : virtual public DefaultLitePullConsumer
   long poll_timeout_millis() const override { return poll_timeout_millis_; }
   void set_poll_timeout_millis(long poll_timeout_millis) override { poll_timeout_millis_ = poll_timeout_millis; }
 
+  int poll_batch_max_size() const override { return poll_batch_max_size_; }
+  void set_poll_batch_max_size(int poll_batch_max_size) override { poll_batch_max_size_ = poll_batch_max_size; }
+
+  int poll_batch_max_bytes() const override { return poll_batch_max_bytes_; }
+  void set_poll_batch_max_bytes(int poll_batch_max_bytes) override { poll_batch_max_bytes_ = poll_batch_max_bytes; }
+
   long topic_metadata_check_interval_millis() const override { return topic_metadata_check_interval_millis_; }
   void set_topic_metadata_check_interval_millis(long topicMetadataCheckIntervalMillis) override {
     topic_metadata_check_interval_millis_ = topicMetadataCheckIntervalMillis;
@@ -135,10 +159,15 @@ class DefaultLitePullConsumerConfigImpl : virtual public DefaultLitePullConsumer
 
   long pull_threshold_for_all_;
   int pull_threshold_for_queue_;
+  int pull_threshold_size_for_queue_;  // MiB
+  int pull_threshold_size_for_all_;    // MiB
+  int consume_max_span_;
 
   long pull_time_delay_millis_when_exception_;  // 1000
 
   long poll_timeout_millis_;
+  int poll_batch_max_size_;
+  int poll_batch_max_bytes_;  // bytes
 
   long topic_metadata_check_interval_millis_;
 
@@ -22,6 +22,7 @@
 
 #include "AssignedMessageQueue.hpp"
 #include "FilterAPI.hpp"
+#include "LitePullTask.hpp"
 #include "MQAdminImpl.h"
 #include "MQClientAPIImpl.h"
 #include "MQClientInstance.h"
@@ -34,9 +35,6 @@
 #include "UtilAll.h"
 #include "Validators.h"
 
-static const long PULL_TIME_DELAY_MILLS_WHEN_PAUSE = 1000;
-static const long PULL_TIME_DELAY_MILLS_WHEN_FLOW_CONTROL = 50;
-
 namespace rocketmq {
 
 class DefaultLitePullConsumerImpl::MessageQueueListenerImpl : public MessageQueueListener {
@@ -70,184 +68,6 @@ class DefaultLitePullConsumerImpl::MessageQueueListenerImpl : public MessageQueu
   std::weak_ptr<DefaultLitePullConsumerImpl> default_lite_pull_consumer_;
 };
 
-class DefaultLitePullConsumerImpl::ConsumeRequest {
- public:
-  ConsumeRequest(std::vector<MessageExtPtr>&& message_exts,
-                 const MQMessageQueue& message_queue,
-                 ProcessQueuePtr process_queue)
-      : message_exts_(std::move(message_exts)), message_queue_(message_queue), process_queue_(process_queue) {}
-
- public:
-  std::vector<MessageExtPtr>& message_exts() { return message_exts_; }
-
-  MQMessageQueue& message_queue() { return message_queue_; }
-
-  ProcessQueuePtr process_queue() { return process_queue_; }
-
- private:
-  std::vector<MessageExtPtr> message_exts_;
-  MQMessageQueue message_queue_;
-  ProcessQueuePtr process_queue_;
-};
-
-class DefaultLitePullConsumerImpl::PullTaskImpl : public std::enable_shared_from_this<PullTaskImpl> {
- public:
-  PullTaskImpl(DefaultLitePullConsumerImplPtr pull_consumer, const MQMessageQueue& message_queue)
-      : default_lite_pull_consumer_(pull_consumer), message_queue_(message_queue), cancelled_(false) {}
-
-  void run() {
-    auto consumer = default_lite_pull_consumer_.lock();
-    if (nullptr == consumer) {
-      LOG_WARN_NEW("PullTaskImpl::run: DefaultLitePullConsumerImpl is released.");
-      return;
-    }
-
-    if (cancelled_) {
-      return;
-    }
-
-    if (consumer->assigned_message_queue_->isPaused(message_queue_)) {
-      consumer->scheduled_thread_pool_executor_.schedule(
-          std::bind(&DefaultLitePullConsumerImpl::PullTaskImpl::run, shared_from_this()),
-          PULL_TIME_DELAY_MILLS_WHEN_PAUSE, time_unit::milliseconds);
-      LOG_DEBUG_NEW("Message Queue: {} has been paused!", message_queue_.toString());
-      return;
-    }
-
-    auto process_queue = consumer->assigned_message_queue_->getProcessQueue(message_queue_);
-    if (nullptr == process_queue || process_queue->dropped()) {
-      LOG_INFO_NEW("The message queue not be able to poll, because it's dropped. group={}, messageQueue={}",
-                   consumer->groupName(), message_queue_.toString());
-      return;
-    }
-
-    auto config = consumer->getDefaultLitePullConsumerConfig();
-
-    if (consumer->consume_request_cache_.size() * config->pull_batch_size() > config->pull_threshold_for_all()) {
-      consumer->scheduled_thread_pool_executor_.schedule(
-          std::bind(&DefaultLitePullConsumerImpl::PullTaskImpl::run, shared_from_this()),
-          PULL_TIME_DELAY_MILLS_WHEN_FLOW_CONTROL, time_unit::milliseconds);
-      if ((consumer->consume_request_flow_control_times_++ % 1000) == 0)
-        LOG_WARN_NEW(
-            "The consume request count exceeds threshold {}, so do flow control, consume request count={}, "
-            "flowControlTimes={}",
-            config->pull_threshold_for_all(), consumer->consume_request_cache_.size(),
-            consumer->consume_request_flow_control_times_);
-      return;
-    }
-
-    auto cached_message_count = process_queue->getCacheMsgCount();
-    if (cached_message_count > config->pull_threshold_for_queue()) {
-      consumer->scheduled_thread_pool_executor_.schedule(
-          std::bind(&DefaultLitePullConsumerImpl::PullTaskImpl::run, shared_from_this()),
-          PULL_TIME_DELAY_MILLS_WHEN_FLOW_CONTROL, time_unit::milliseconds);
-      if ((consumer->queue_flow_control_times_++ % 1000) == 0) {
-        LOG_WARN_NEW(
-            "The cached message count exceeds the threshold {}, so do flow control, minOffset={}, maxOffset={}, "
-            "count={}, size={} MiB, flowControlTimes={}",
-            config->pull_threshold_for_queue(), process_queue->getCacheMinOffset(), process_queue->getCacheMaxOffset(),
-            cached_message_count, "unknown", consumer->queue_flow_control_times_);
-      }
-      return;
-    }
-
-    // long cachedMessageSizeInMiB = processQueue->getMsgSize() / (1024 * 1024);
-    // if (cachedMessageSizeInMiB > consumer.getPullThresholdSizeForQueue()) {
-    //   scheduledThreadPoolExecutor.schedule(this, PULL_TIME_DELAY_MILLS_WHEN_FLOW_CONTROL, TimeUnit.MILLISECONDS);
-    //   if ((queueFlowControlTimes++ % 1000) == 0) {
-    //     log.warn(
-    //         "The cached message size exceeds the threshold {} MiB, so do flow control, minOffset={}, maxOffset={},
-    //         "
-    //         "count={}, size={} MiB, flowControlTimes={}",
-    //         consumer.getPullThresholdSizeForQueue(), processQueue.getMsgTreeMap().firstKey(),
-    //         processQueue.getMsgTreeMap().lastKey(), cachedMessageCount, cachedMessageSizeInMiB,
-    //         queueFlowControlTimes);
-    //   }
-    //   return;
-    // }
-
-    // if (processQueue.getMaxSpan() > consumer.getConsumeMaxSpan()) {
-    //   scheduledThreadPoolExecutor.schedule(this, PULL_TIME_DELAY_MILLS_WHEN_FLOW_CONTROL, TimeUnit.MILLISECONDS);
-    //   if ((queueMaxSpanFlowControlTimes++ % 1000) == 0) {
-    //     log.warn(
-    //         "The queue's messages, span too long, so do flow control, minOffset={}, maxOffset={}, maxSpan={}, "
-    //         "flowControlTimes={}",
-    //         processQueue.getMsgTreeMap().firstKey(), processQueue.getMsgTreeMap().lastKey(),
-    //         processQueue.getMaxSpan(),
-    //         queueMaxSpanFlowControlTimes);
-    //   }
-    //   return;
-    // }
-
-    auto offset = consumer->nextPullOffset(message_queue_);
-    long pull_delay_time_millis = 0;
-    SubscriptionData* subscription_data = nullptr;
-    try {
-      if (consumer->subscription_type_ == SubscriptionType::SUBSCRIBE) {
-        subscription_data = consumer->rebalance_impl_->getSubscriptionData(message_queue_.topic());
-      } else {
-        subscription_data = FilterAPI::buildSubscriptionData(message_queue_.topic(), SUB_ALL);
-      }
-
-      std::unique_ptr<PullResult> pull_result(
-          consumer->pull(message_queue_, subscription_data, offset, config->pull_batch_size()));
-
-      switch (pull_result->pull_status()) {
-        case PullStatus::FOUND: {
-          auto objLock = consumer->message_queue_lock_.fetchLockObject(message_queue_);
-          std::lock_guard<std::mutex> lock(*objLock);
-          if (!pull_result->msg_found_list().empty() &&
-              consumer->assigned_message_queue_->getSeekOffset(message_queue_) == -1) {
-            process_queue->putMessage(pull_result->msg_found_list());
-            consumer->submitConsumeRequest(
-                new ConsumeRequest(std::move(pull_result->msg_found_list()), message_queue_, process_queue));
-          }
-        } break;
-        case PullStatus::OFFSET_ILLEGAL:
-          LOG_WARN_NEW("The pull request offset illegal, {}", pull_result->toString());
-          break;
-        case PullStatus::NO_NEW_MSG:
-        case PullStatus::NO_MATCHED_MSG:
-          pull_delay_time_millis = 1000;
-          break;
-        case PullStatus::NO_LATEST_MSG:
-          pull_delay_time_millis = config->pull_time_delay_millis_when_exception();
-          break;
-        default:
-          break;
-      }
-
-      consumer->updatePullOffset(message_queue_, pull_result->next_begin_offset());
-    } catch (std::exception& e) {
-      pull_delay_time_millis = config->pull_time_delay_millis_when_exception();
-      LOG_ERROR_NEW("An error occurred in pull message process. {}", e.what());
-    }
-
-    if (consumer->subscription_type_ != SubscriptionType::SUBSCRIBE) {
-      delete subscription_data;
-    }
-
-    if (!cancelled_) {
-      consumer->scheduled_thread_pool_executor_.schedule(
-          std::bind(&DefaultLitePullConsumerImpl::PullTaskImpl::run, shared_from_this()), pull_delay_time_millis,
-          time_unit::milliseconds);
-    } else {
-      LOG_WARN_NEW("The Pull Task is cancelled after doPullTask, {}", message_queue_.toString());
-    }
-  }
-
- public:
-  inline const MQMessageQueue& message_queue() { return message_queue_; }
-
-  inline bool is_cancelled() const { return cancelled_; }
-  inline void set_cancelled(bool cancelled) { cancelled_ = cancelled; }
-
- private:
-  std::weak_ptr<DefaultLitePullConsumerImpl> default_lite_pull_consumer_;
-  MQMessageQueue message_queue_;
-  volatile bool cancelled_;
-};
-
 DefaultLitePullConsumerImpl::DefaultLitePullConsumerImpl(DefaultLitePullConsumerConfigPtr config)
     : DefaultLitePullConsumerImpl(config, nullptr) {}
 
@@ -257,6 +77,7 @@ DefaultLitePullConsumerImpl::DefaultLitePullConsumerImpl(DefaultLitePullConsumer
       subscription_type_(SubscriptionType::NONE),
       consume_request_flow_control_times_(0),
       queue_flow_control_times_(0),
+      queue_max_span_flow_control_times_(0),
       next_auto_commit_deadline_(-1LL),
       auto_commit_(true),
       message_queue_listener_(nullptr),
@@ -319,6 +140,11 @@ void DefaultLitePullConsumerImpl::start() {
       }
       offset_store_->load();
 
+      auto threshold_size_for_all = getDefaultLitePullConsumerConfig()->pull_threshold_size_for_all();
+      consume_request_cache_.set_capacity(
+          getDefaultLitePullConsumerConfig()->pull_threshold_for_all(),
+          threshold_size_for_all > 0 ? static_cast<int64_t>(threshold_size_for_all) * 1024 * 1024 : -1);
+
       scheduled_thread_pool_executor_.set_thread_nums(getDefaultLitePullConsumerConfig()->pull_thread_nums());
       scheduled_thread_pool_executor_.startup();
       scheduled_executor_service_.startup();
@@ -600,23 +426,6 @@ int64_t DefaultLitePullConsumerImpl::fetchConsumeOffset(const MQMessageQueue& me
   return rebalance_impl_->computePullFromWhere(messageQueue);
 }
 
-PullResult* DefaultLitePullConsumerImpl::pull(const MQMessageQueue& mq,
-                                              SubscriptionData* subscription_data,
-                                              int64_t offset,
-                                              int max_nums) {
-  return pull(mq, subscription_data, offset, max_nums,
-              getDefaultLitePullConsumerConfig()->consumer_pull_timeout_millis());
-}
-
-PullResult* DefaultLitePullConsumerImpl::pull(const MQMessageQueue& mq,
-                                              SubscriptionData* subscription_data,
-                                              int64_t offset,
-                                              int max_nums,
-                                              long timeout) {
-  return pullSyncImpl(mq, subscription_data, offset, max_nums,
-                      getDefaultLitePullConsumerConfig()->long_polling_enable(), timeout);
-}
-
 PullResult* DefaultLitePullConsumerImpl::pullSyncImpl(const MQMessageQueue& mq,
                                                       SubscriptionData* subscription_data,
                                                       int64_t offset,
@@ -654,8 +463,48 @@ PullResult* DefaultLitePullConsumerImpl::pullSyncImpl(const MQMessageQueue& mq,
   return pull_api_wrapper_->processPullResult(mq, std::move(pull_result), subscription_data);
 }
 
+void DefaultLitePullConsumerImpl::pullAsyncImpl(const MQMessageQueue& mq,
+                                                SubscriptionData* subscription_data,
+                                                int64_t offset,
+                                                int max_nums,
+                                                bool block,
+                                                long timeout,
+                                                PullCallback* pull_callback) {
+  if (offset < 0) {
+    THROW_MQEXCEPTION(MQClientException, "offset < 0", -1);
+  }
+
+  if (max_nums <= 0) {
+    THROW_MQEXCEPTION(MQClientException, "maxNums <= 0", -1);
+  }
+
+  int sysFlag = PullSysFlag::buildSysFlag(false, block, true, false, true);
+
+  long timeoutMillis = block ? getDefaultLitePullConsumerConfig()->consumer_timeout_millis_when_suspend() : timeout;
+
+  bool isTagType = ExpressionType::isTagType(subscription_data->expression_type());
+
+  pull_api_wrapper_->pullKernelImpl(
+      mq,                                                                    // mq
+      subscription_data->sub_string(),                                       // subExpression
+      subscription_data->expression_type(),                                  // expressionType
+      isTagType ? 0L : subscription_data->sub_version(),                     // subVersion
+      offset,                                                                // offset
+      max_nums,                                                              // maxNums
+      sysFlag,                                                               // sysFlag
+      0,                                                                     // commitOffset
+      getDefaultLitePullConsumerConfig()->broker_suspend_max_time_millis(),  // brokerSuspendMaxTimeMillis
+      timeoutMillis,                                                         // timeoutMillis
+      CommunicationMode::ASYNC,                                              // communicationMode
+      pull_callback);                                                        // pullCallback
+}
+
 void DefaultLitePullConsumerImpl::submitConsumeRequest(ConsumeRequest* consume_request) {
-  consume_request_cache_.push_back(consume_request);
+  int64_t size = 0;
+  for (const auto& message_ext : consume_request->message_exts()) {
+    size += message_ext->body().size();
+  }
+  consume_request_cache_.push_back(consume_request, consume_request->message_exts().size(), size);
 }
 
 void DefaultLitePullConsumerImpl::updatePullOffset(const MQMessageQueue& message_queue, int64_t next_pull_offset) {
@@ -674,28 +523,25 @@ std::vector<MQMessageExt> DefaultLitePullConsumerImpl::poll(long timeout) {
     maybeAutoCommit();
   }
 
-  int64_t endTime = UtilAll::currentTimeMillis() + timeout;
-
-  auto consume_request = consume_request_cache_.pop_front(timeout, time_unit::milliseconds);
-  if (endTime - UtilAll::currentTimeMillis() > 0) {
-    while (consume_request != nullptr && consume_request->process_queue()->dropped()) {
-      consume_request = consume_request_cache_.pop_front();
-      if (endTime - UtilAll::currentTimeMillis() <= 0) {
-        break;
-      }
-    }
-  }
+  // drain the batches of several queues at once, so a poll is not limited to a single pull
+  auto config = getDefaultLitePullConsumerConfig();
+  auto consume_requests = consume_request_cache_.drain(
+      timeout, time_unit::milliseconds, config->poll_batch_max_size(), config->poll_batch_max_bytes(),
+      [](ConsumeRequest& consume_request) { return consume_request.process_queue()->dropped(); });
 
-  if (consume_request != nullptr && !consume_request->process_queue()->dropped()) {
-    auto& messages = consume_request->message_exts();
-    long offset = consume_request->process_queue()->removeMessage(messages);
+  std::vector<MQMessageExt> messages;
+  for (auto& consume_request : consume_requests) {
+    auto& message_exts = consume_request->message_exts();
+    long offset = consume_request->process_queue()->removeMessage(message_exts);
     assigned_message_queue_->updateConsumeOffset(consume_request->message_queue(), offset);
     // If namespace not null , reset Topic without namespace.
-    resetTopic(messages);
-    return MQMessageExt::from_list(messages);
+    resetTopic(message_exts);
+    messages.reserve(messages.size() + message_exts.size());
+    for (auto& message_ext : message_exts) {
+      messages.emplace_back(message_ext);
+    }
   }
-
-  return std::vector<MQMessageExt>();
+  return messages;
 }
 
 void DefaultLitePullConsumerImpl::maybeAutoCommit() {
@@ -778,11 +624,71 @@ void DefaultLitePullConsumerImpl::parseMessageQueues(std::vector<MQMessageQueue>
 }
 
 void DefaultLitePullConsumerImpl::assign(const std::vector<MQMessageQueue>& messageQueues) {
-  // TODO:
+  std::lock_guard<std::mutex> lock(mutex_);  // synchronized
+  if (messageQueues.empty()) {
+    THROW_MQEXCEPTION(MQClientException, "Message queues can not be null or empty.", -1);
+  }
+  set_subscription_type(SubscriptionType::ASSIGN);
+
+  std::vector<MQMessageQueue> message_queues(messageQueues);
+  assigned_message_queue_->updateAssignedMessageQueue(message_queues);
+  if (service_state_ == ServiceState::RUNNING) {
+    updateAssignPullTask(message_queues);
+  }
 }
 
 void DefaultLitePullConsumerImpl::seek(const MQMessageQueue& messageQueue, int64_t offset) {
-  // TODO:
+  std::lock_guard<std::mutex> lock(mutex_);  // synchronized
+  if (service_state_ != ServiceState::RUNNING) {
+    THROW_MQEXCEPTION(MQClientException, "The PullConsumer service state not OK, maybe not started", -1);
+  }
+
+  auto message_queues = assigned_message_queue_->messageQueues();
+  if (std::find(message_queues.begin(), message_queues.end(), messageQueue) == message_queues.end()) {
+    if (subscription_type_ == SubscriptionType::SUBSCRIBE) {
+      THROW_MQEXCEPTION(MQClientException,
+                        "The message queue is not in assigned list, may be rebalancing, message queue: " +
+                            messageQueue.toString(),
+                        -1);
+    } else {
+      THROW_MQEXCEPTION(MQClientException,
+                        "The message queue is not in assigned list, message queue: " + messageQueue.toString(), -1);
+    }
+  }
+
+  auto min_offset = minOffset(messageQueue);
+  auto max_offset = maxOffset(messageQueue);
+  if (offset < min_offset || offset > max_offset) {
+    THROW_MQEXCEPTION(MQClientException,
+                      "Seek offset illegal, seek offset = " + UtilAll::to_string(offset) +
+                          ", min offset = " + UtilAll::to_string(min_offset) +
+                          ", max offset = " + UtilAll::to_string(max_offset),
+                      -1);
+  }
+
+  auto objLock = message_queue_lock_.fetchLockObject(messageQueue);
+  std::lock_guard<std::mutex> queue_lock(*objLock);
+  clearMessageQueueInCache(messageQueue);
+
+  // restart the pull task, so a pull still in flight can't overwrite the seek offset
+  std::lock_guard<std::mutex> task_lock(task_table_mutex_);
+  auto it = task_table_.find(messageQueue);
+  if (it != task_table_.end()) {
+    it->second->set_cancelled(true);
+    task_table_.erase(it);
+  }
+  assigned_message_queue_->setSeekOffset(messageQueue, offset);
+  std::vector<MQMessageQueue> mq_set{messageQueue};
+  startPullTask(mq_set);
+}
+
+void DefaultLitePullConsumerImpl::clearMessageQueueInCache(const MQMessageQueue& message_queue) {
+  auto process_queue = assigned_message_queue_->getProcessQueue(message_queue);
+  if (process_queue != nullptr) {
+    process_queue->clear();
+  }
+  consume_request_cache_.remove_if(
+      [&message_queue](ConsumeRequest& consume_request) { return consume_request.message_queue() == message_queue; });
 }
 
 void DefaultLitePullConsumerImpl::seekToBegin(const MQMessageQueue& message_queue) {
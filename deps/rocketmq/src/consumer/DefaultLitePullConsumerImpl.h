@@ -21,8 +21,8 @@
 #include <mutex>   // std::mutex
 #include <string>  // std::string
 
-#include "concurrent/blocking_queue.hpp"
 #include "concurrent/executor.hpp"
+#include "concurrent/weighted_blocking_queue.hpp"
 #include "DefaultLitePullConsumer.h"
 #include "MessageQueueListener.h"
 #include "MessageQueueLock.hpp"
@@ -35,6 +35,7 @@ namespace rocketmq {
 class AssignedMessageQueue;
 class OffsetStore;
 class PullAPIWrapper;
+class PullCallback;
 class PullResult;
 class RebalanceImpl;
 
@@ -51,6 +52,7 @@ class DefaultLitePullConsumerImpl : public std::enable_shared_from_this<DefaultL
   class MessageQueueListenerImpl;
   class ConsumeRequest;
   class PullTaskImpl;
+  class AsyncPullCallback;
 
  public:
   /**
@@ -156,18 +158,19 @@ class DefaultLitePullConsumerImpl : public std::enable_shared_from_this<DefaultL
   int64_t nextPullOffset(const MQMessageQueue& messageQueue);
   int64_t fetchConsumeOffset(const MQMessageQueue& messageQueue);
 
-  PullResult* pull(const MQMessageQueue& mq, SubscriptionData* subscription_data, int64_t offset, int max_nums);
-  PullResult* pull(const MQMessageQueue& mq,
-                   SubscriptionData* subscription_data,
-                   int64_t offset,
-                   int max_nums,
-                   long timeout);
   PullResult* pullSyncImpl(const MQMessageQueue& mq,
                            SubscriptionData* subscription_data,
                            int64_t offset,
                            int max_nums,
                            bool block,
                            long timeout);
+  void pullAsyncImpl(const MQMessageQueue& mq,
+                     SubscriptionData* subscription_data,
+                     int64_t offset,
+                     int max_nums,
+                     bool block,
+                     long timeout,
+                     PullCallback* pull_callback);
 
   void submitConsumeRequest(ConsumeRequest* consume_request);
 
@@ -177,6 +180,8 @@ class DefaultLitePullConsumerImpl : public std::enable_shared_from_this<DefaultL
 
   void resetTopic(std::vector<MessageExtPtr>& msg_list);
 
+  void clearMessageQueueInCache(const MQMessageQueue& message_queue);
+
   void commitAll();
 
   void updateConsumeOffset(const MQMessageQueue& mq, int64_t offset);
@@ -205,6 +210,7 @@ class DefaultLitePullConsumerImpl : public std::enable_shared_from_this<DefaultL
 
   long consume_request_flow_control_times_;
   long queue_flow_control_times_;
+  long queue_max_span_flow_control_times_;
 
   int64_t next_auto_commit_deadline_;
 
@@ -221,7 +227,8 @@ class DefaultLitePullConsumerImpl : public std::enable_shared_from_this<DefaultL
   std::map<MQMessageQueue, std::shared_ptr<PullTaskImpl>> task_table_;
   std::mutex task_table_mutex_;
 
-  blocking_queue<ConsumeRequest> consume_request_cache_;
+  // pulled batches waiting for poll(), bounded by pull_threshold_for_all/pull_threshold_size_for_all
+  weighted_blocking_queue<ConsumeRequest> consume_request_cache_;
 
   scheduled_thread_pool_executor scheduled_thread_pool_executor_;
   scheduled_thread_pool_executor scheduled_executor_service_;
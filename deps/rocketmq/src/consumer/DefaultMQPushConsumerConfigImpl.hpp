@@ -38,6 +38,9 @@ class DefaultMQPushConsumerConfigImpl : virtual public DefaultMQPushConsumerConf
         consume_timestamp_("0"),
         consume_thread_nums_(std::min(8, (int)std::thread::hardware_concurrency())),
         pull_threshold_for_queue_(1000),
+        pull_threshold_size_for_queue_(100),
+        pull_threshold_size_for_all_(-1),
+        consume_concurrently_max_span_(2000),
         consume_message_batch_max_size_(1),
         pull_batch_size_(32),
         max_reconsume_times_(16),
@@ -64,6 +67,19 @@ class DefaultMQPushConsumerConfigImpl : virtual public DefaultMQPushConsumerConf
   int pull_threshold_for_queue() const override { return pull_threshold_for_queue_; }
   void set_pull_threshold_for_queue(int maxCacheSize) override { pull_threshold_for_queue_ = maxCacheSize; }
 
+  int pull_threshold_size_for_queue() const override { return pull_threshold_size_for_queue_; }
+  void set_pull_threshold_size_for_queue(int maxCacheSizeInMiB) override {
+    pull_threshold_size_for_queue_ = maxCacheSizeInMiB;
+  }
+
+  int pull_threshold_size_for_all() const override { return pull_threshold_size_for_all_; }
+  void set_pull_threshold_size_for_all(int maxCacheSizeInMiB) override {
+    pull_threshold_size_for_all_ = maxCacheSizeInMiB;
+  }
+
+  int consume_concurrently_max_span() const override { return consume_concurrently_max_span_; }
+  void set_consume_concurrently_max_span(int maxSpan) override { consume_concurrently_max_span_ = maxSpan; }
+
   int consume_message_batch_max_size() const override { return consume_message_batch_max_size_; }
   void set_consume_message_batch_max_size(int consumeMessageBatchMaxSize) override {
     if (consumeMessageBatchMaxSize >= 1) {
@@ -94,6 +110,9 @@ class DefaultMQPushConsumerConfigImpl : virtual public DefaultMQPushConsumerConf
   int consume_thread_nums_;
 
   int pull_threshold_for_queue_;
+  int pull_threshold_size_for_queue_;  // MiB
+  int pull_threshold_size_for_all_;    // MiB
+  int consume_concurrently_max_span_;
 
   int consume_message_batch_max_size_;  // 1
   int pull_batch_size_;                 // 32
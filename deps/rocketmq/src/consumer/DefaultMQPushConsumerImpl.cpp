@@ -156,6 +156,8 @@ DefaultMQPushConsumerImpl::DefaultMQPushConsumerImpl(DefaultMQPushConsumerConfig
       start_time_(UtilAll::currentTimeMillis()),
       pause_(false),
       consume_orderly_(false),
+      queue_flow_control_times_(0),
+      queue_max_span_flow_control_times_(0),
       message_listener_(nullptr),
       consume_service_(nullptr),
       rebalance_impl_(new RebalancePushImpl(this)),
@@ -421,13 +423,59 @@ void DefaultMQPushConsumerImpl::pullMessage(PullRequestPtr pull_request) {
 
   process_queue->set_last_pull_timestamp(UtilAll::currentTimeMillis());
 
+  auto* config = getDefaultMQPushConsumerConfig();
+
   int cachedMessageCount = process_queue->getCacheMsgCount();
-  if (cachedMessageCount > getDefaultMQPushConsumerConfig()->pull_threshold_for_queue()) {
+  if (cachedMessageCount > config->pull_threshold_for_queue()) {
     // too many message in cache, wait to process
     executePullRequestLater(pull_request, 1000);
     return;
   }
 
+  int64_t cachedMessageSizeInMiB = process_queue->getCacheMsgSize() / (1024 * 1024);
+  if (cachedMessageSizeInMiB > config->pull_threshold_size_for_queue()) {
+    // too large message in cache, wait to process
+    executePullRequestLater(pull_request, 1000);
+    if ((queue_flow_control_times_++ % 1000) == 0) {
+      LOG_WARN_NEW(
+          "the cached message size exceeds the threshold {} MiB, so do flow control, count={}, size={} MiB, "
+          "pullRequest={}, flowControlTimes={}",
+          config->pull_threshold_size_for_queue(), cachedMessageCount, cachedMessageSizeInMiB,
+          pull_request->toString(), queue_flow_control_times_.load());
+    }
+    return;
+  }
+
+  if (config->pull_threshold_size_for_all() > 0) {
+    int64_t totalMessageSizeInMiB = rebalance_impl_->getCachedMessageSize() / (1024 * 1024);
+    if (totalMessageSizeInMiB > config->pull_threshold_size_for_all()) {
+      executePullRequestLater(pull_request, 1000);
+      if ((queue_flow_control_times_++ % 1000) == 0) {
+        LOG_WARN_NEW(
+            "the cached message size of consumer exceeds the threshold {} MiB, so do flow control, size={} MiB, "
+            "flowControlTimes={}",
+            config->pull_threshold_size_for_all(), totalMessageSizeInMiB, queue_flow_control_times_.load());
+      }
+      return;
+    }
+  }
+
+  if (!consume_orderly()) {
+    int64_t maxSpan = process_queue->getMaxSpan();
+    if (maxSpan > config->consume_concurrently_max_span()) {
+      // a slow message blocks the commit offset, don't go too far away
+      executePullRequestLater(pull_request, 1000);
+      if ((queue_max_span_flow_control_times_++ % 1000) == 0) {
+        LOG_WARN_NEW(
+            "the queue's messages, span too long, so do flow control, minOffset={}, maxOffset={}, maxSpan={}, "
+            "pullRequest={}, flowControlTimes={}",
+            process_queue->getCacheMinOffset(), process_queue->getCacheMaxOffset(), maxSpan, pull_request->toString(),
+            queue_max_span_flow_control_times_.load());
+      }
+      return;
+    }
+  }
+
   if (consume_orderly()) {
     if (process_queue->locked()) {
       if (!pull_request->locked_first()) {
@@ -550,6 +598,27 @@ bool DefaultMQPushConsumerImpl::sendMessageBack(MessageExtPtr msg, int delay_lev
   return false;
 }
 
+void DefaultMQPushConsumerImpl::sendMessageBackAsync(MessageExtPtr msg,
+                                                     int delay_level,
+                                                     const std::string& brokerName,
+                                                     std::function<void(bool)> callback) {
+  try {
+    msg->set_topic(NamespaceUtil::wrapNamespace(client_config_->name_space(), msg->topic()));
+
+    std::string brokerAddr =
+        brokerName.empty() ? msg->store_host_string() : client_instance_->findBrokerAddressInPublish(brokerName);
+
+    client_instance_->getMQClientAPIImpl()->consumerSendMessageBackAsync(
+        brokerAddr, msg, getDefaultMQPushConsumerConfig()->group_name(), delay_level, 5000,
+        getDefaultMQPushConsumerConfig()->max_reconsume_times(), callback);
+    return;
+  } catch (const std::exception& e) {
+    LOG_ERROR_NEW("sendMessageBackAsync exception, group: {}, msg: {}. {}",
+                  getDefaultMQPushConsumerConfig()->group_name(), msg->toString(), e.what());
+  }
+  callback(false);
+}
+
 void DefaultMQPushConsumerImpl::persistConsumerOffset() {
   if (isServiceStateOk()) {
     std::vector<MQMessageQueue> mqs = rebalance_impl_->getAllocatedMQ();
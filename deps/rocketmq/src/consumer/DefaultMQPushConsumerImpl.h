@@ -17,6 +17,8 @@
 #ifndef ROCKETMQ_CONSUMER_DEFAULTMQPUSHCONSUMERIMPL_H_
 #define ROCKETMQ_CONSUMER_DEFAULTMQPUSHCONSUMERIMPL_H_
 
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <string>
 #include <thread>
@@ -112,6 +114,12 @@ class DefaultMQPushConsumerImpl : public std::enable_shared_from_this<DefaultMQP
 
   void updateConsumeOffset(const MQMessageQueue& mq, int64_t offset);
 
+  // send back without blocking, callback receives the result and is invoked exactly once
+  virtual void sendMessageBackAsync(MessageExtPtr msg,
+                                    int delayLevel,
+                                    const std::string& brokerName,
+                                    std::function<void(bool)> callback);
+
  private:
   void checkConfig();
   void copySubscription();
@@ -148,6 +156,9 @@ class DefaultMQPushConsumerImpl : public std::enable_shared_from_this<DefaultMQP
   volatile bool pause_;
   bool consume_orderly_;
 
+  std::atomic<long> queue_flow_control_times_;
+  std::atomic<long> queue_max_span_flow_control_times_;
+
   std::map<std::string, std::string> subscription_;
 
   MQMessageListener* message_listener_;
@@ -0,0 +1,311 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ROCKETMQ_CONSUMER_LITEPULLTASK_HPP_
+#define ROCKETMQ_CONSUMER_LITEPULLTASK_HPP_
+
+#include "AssignedMessageQueue.hpp"
+#include "DefaultLitePullConsumerImpl.h"
+#include "FilterAPI.hpp"
+#include "Logging.h"
+#include "PullAPIWrapper.h"
+#include "PullCallback.h"
+#include "PullResult.h"
+
+static const long PULL_TIME_DELAY_MILLS_WHEN_PAUSE = 1000;
+static const long PULL_TIME_DELAY_MILLS_WHEN_FLOW_CONTROL = 50;
+
+namespace rocketmq {
+
+class DefaultLitePullConsumerImpl::ConsumeRequest {
+ public:
+  ConsumeRequest(std::vector<MessageExtPtr>&& message_exts,
+                 const MQMessageQueue& message_queue,
+                 ProcessQueuePtr process_queue)
+      : message_exts_(std::move(message_exts)), message_queue_(message_queue), process_queue_(process_queue) {}
+
+ public:
+  std::vector<MessageExtPtr>& message_exts() { return message_exts_; }
+
+  MQMessageQueue& message_queue() { return message_queue_; }
+
+  ProcessQueuePtr process_queue() { return process_queue_; }
+
+ private:
+  std::vector<MessageExtPtr> message_exts_;
+  MQMessageQueue message_queue_;
+  ProcessQueuePtr process_queue_;
+};
+
+class DefaultLitePullConsumerImpl::AsyncPullCallback : public AutoDeletePullCallback {
+ public:
+  AsyncPullCallback(std::shared_ptr<PullTaskImpl> pull_task,
+                    ProcessQueuePtr process_queue,
+                    SubscriptionData* subscription_data,
+                    std::unique_ptr<SubscriptionData> owned_subscription_data,
+                    int64_t seek_generation)
+      : pull_task_(pull_task),
+        process_queue_(process_queue),
+        subscription_data_(subscription_data),
+        owned_subscription_data_(std::move(owned_subscription_data)),
+        seek_generation_(seek_generation) {}
+
+  ~AsyncPullCallback() = default;
+
+  void onSuccess(std::unique_ptr<PullResult> pull_result) override;
+  void onException(MQException& e) noexcept override;
+
+ private:
+  std::shared_ptr<PullTaskImpl> pull_task_;
+  ProcessQueuePtr process_queue_;
+  SubscriptionData* subscription_data_;
+  std::unique_ptr<SubscriptionData> owned_subscription_data_;  // built for ASSIGN, deleted with the callback
+  int64_t seek_generation_;                                   // seek generation of the queue when pulling
+};
+
+class DefaultLitePullConsumerImpl::PullTaskImpl : public std::enable_shared_from_this<PullTaskImpl> {
+ public:
+  PullTaskImpl(DefaultLitePullConsumerImplPtr pull_consumer, const MQMessageQueue& message_queue)
+      : default_lite_pull_consumer_(pull_consumer), message_queue_(message_queue), cancelled_(false) {}
+
+  void run() {
+    auto consumer = default_lite_pull_consumer_.lock();
+    if (nullptr == consumer) {
+      LOG_WARN_NEW("PullTaskImpl::run: DefaultLitePullConsumerImpl is released.");
+      return;
+    }
+
+    if (cancelled_) {
+      return;
+    }
+
+    if (consumer->assigned_message_queue_->isPaused(message_queue_)) {
+      consumer->scheduled_thread_pool_executor_.schedule(
+          std::bind(&DefaultLitePullConsumerImpl::PullTaskImpl::run, shared_from_this()),
+          PULL_TIME_DELAY_MILLS_WHEN_PAUSE, time_unit::milliseconds);
+      LOG_DEBUG_NEW("Message Queue: {} has been paused!", message_queue_.toString());
+      return;
+    }
+
+    auto process_queue = consumer->assigned_message_queue_->getProcessQueue(message_queue_);
+    if (nullptr == process_queue || process_queue->dropped()) {
+      LOG_INFO_NEW("The message queue not be able to poll, because it's dropped. group={}, messageQueue={}",
+                   consumer->groupName(), message_queue_.toString());
+      return;
+    }
+
+    auto config = consumer->getDefaultLitePullConsumerConfig();
+
+    if (consumer->consume_request_cache_.full()) {
+      consumer->scheduled_thread_pool_executor_.schedule(
+          std::bind(&DefaultLitePullConsumerImpl::PullTaskImpl::run, shared_from_this()),
+          PULL_TIME_DELAY_MILLS_WHEN_FLOW_CONTROL, time_unit::milliseconds);
+      if ((consumer->consume_request_flow_control_times_++ % 1000) == 0) {
+        LOG_WARN_NEW(
+            "The messages waiting for poll exceed the threshold {} / {} MiB, so do flow control, count={}, size={} "
+            "MiB, flowControlTimes={}",
+            config->pull_threshold_for_all(), config->pull_threshold_size_for_all(),
+            consumer->consume_request_cache_.count(), consumer->consume_request_cache_.bytes() / (1024 * 1024),
+            consumer->consume_request_flow_control_times_);
+      }
+      return;
+    }
+
+    auto cached_message_count = process_queue->getCacheMsgCount();
+    auto cached_message_size_in_mib = process_queue->getCacheMsgSize() / (1024 * 1024);
+    if (cached_message_count > config->pull_threshold_for_queue()) {
+      consumer->scheduled_thread_pool_executor_.schedule(
+          std::bind(&DefaultLitePullConsumerImpl::PullTaskImpl::run, shared_from_this()),
+          PULL_TIME_DELAY_MILLS_WHEN_FLOW_CONTROL, time_unit::milliseconds);
+      if ((consumer->queue_flow_control_times_++ % 1000) == 0) {
+        LOG_WARN_NEW(
+            "The cached message count exceeds the threshold {}, so do flow control, minOffset={}, maxOffset={}, "
+            "count={}, size={} MiB, flowControlTimes={}",
+            config->pull_threshold_for_queue(), process_queue->getCacheMinOffset(), process_queue->getCacheMaxOffset(),
+            cached_message_count, cached_message_size_in_mib, consumer->queue_flow_control_times_);
+      }
+      return;
+    }
+
+    if (cached_message_size_in_mib > config->pull_threshold_size_for_queue()) {
+      consumer->scheduled_thread_pool_executor_.schedule(
+          std::bind(&DefaultLitePullConsumerImpl::PullTaskImpl::run, shared_from_this()),
+          PULL_TIME_DELAY_MILLS_WHEN_FLOW_CONTROL, time_unit::milliseconds);
+      if ((consumer->queue_flow_control_times_++ % 1000) == 0) {
+        LOG_WARN_NEW(
+            "The cached message size exceeds the threshold {} MiB, so do flow control, minOffset={}, maxOffset={}, "
+            "count={}, size={} MiB, flowControlTimes={}",
+            config->pull_threshold_size_for_queue(), process_queue->getCacheMinOffset(),
+            process_queue->getCacheMaxOffset(), cached_message_count, cached_message_size_in_mib,
+            consumer->queue_flow_control_times_);
+      }
+      return;
+    }
+
+    auto max_span = process_queue->getMaxSpan();
+    if (max_span > config->consume_max_span()) {
+      consumer->scheduled_thread_pool_executor_.schedule(
+          std::bind(&DefaultLitePullConsumerImpl::PullTaskImpl::run, shared_from_this()),
+          PULL_TIME_DELAY_MILLS_WHEN_FLOW_CONTROL, time_unit::milliseconds);
+      if ((consumer->queue_max_span_flow_control_times_++ % 1000) == 0) {
+        LOG_WARN_NEW(
+            "The queue's messages, span too long, so do flow control, minOffset={}, maxOffset={}, maxSpan={}, "
+            "flowControlTimes={}",
+            process_queue->getCacheMinOffset(), process_queue->getCacheMaxOffset(), max_span,
+            consumer->queue_max_span_flow_control_times_);
+      }
+      return;
+    }
+
+    // seek cancels the task and sets the seek offset under the queue lock, so a cancelled task never consumes the
+    // seek offset and a pull issued before a seek carries the old generation
+    int64_t offset;
+    int64_t seek_generation;
+    {
+      auto objLock = consumer->message_queue_lock_.fetchLockObject(message_queue_);
+      std::lock_guard<std::mutex> lock(*objLock);
+      if (cancelled_) {
+        return;
+      }
+      seek_generation = consumer->assigned_message_queue_->getSeekGeneration(message_queue_);
+      offset = consumer->nextPullOffset(message_queue_);
+    }
+    SubscriptionData* subscription_data = nullptr;
+    std::unique_ptr<SubscriptionData> owned_subscription_data;
+    if (consumer->subscription_type_ == SubscriptionType::SUBSCRIBE) {
+      subscription_data = consumer->rebalance_impl_->getSubscriptionData(message_queue_.topic());
+    } else {
+      subscription_data = FilterAPI::buildSubscriptionData(message_queue_.topic(), SUB_ALL);
+      owned_subscription_data.reset(subscription_data);
+    }
+    if (nullptr == subscription_data) {
+      LOG_WARN_NEW("find the consumer's subscription failed, {}", message_queue_.toString());
+      scheduleNext(consumer, config->pull_time_delay_millis_when_exception());
+      return;
+    }
+
+    try {
+      std::unique_ptr<AsyncPullCallback> callback(new AsyncPullCallback(
+          shared_from_this(), process_queue, subscription_data, std::move(owned_subscription_data), seek_generation));
+      consumer->pullAsyncImpl(message_queue_, subscription_data, offset, config->pull_batch_size(),
+                              config->long_polling_enable(), config->consumer_pull_timeout_millis(), callback.get());
+      (void)callback.release();
+    } catch (std::exception& e) {
+      LOG_ERROR_NEW("An error occurred in pull message process. {}", e.what());
+      scheduleNext(consumer, config->pull_time_delay_millis_when_exception());
+    }
+  }
+
+  // handle the result of an async pull, then schedule the next one
+  void onPullResult(DefaultLitePullConsumerImplPtr consumer,
+                    ProcessQueuePtr process_queue,
+                    PullResult& pull_result,
+                    int64_t seek_generation) {
+    {
+      // a seek since the pull was issued makes its messages and next offset stale
+      auto objLock = consumer->message_queue_lock_.fetchLockObject(message_queue_);
+      std::lock_guard<std::mutex> lock(*objLock);
+      if (cancelled_ || consumer->assigned_message_queue_->getSeekGeneration(message_queue_) != seek_generation) {
+        LOG_WARN_NEW("The Pull Task is cancelled after doPullTask, {}", message_queue_.toString());
+        return;
+      }
+
+      if (pull_result.pull_status() == PullStatus::FOUND && !pull_result.msg_found_list().empty()) {
+        process_queue->putMessage(pull_result.msg_found_list());
+        consumer->submitConsumeRequest(
+            new ConsumeRequest(std::move(pull_result.msg_found_list()), message_queue_, process_queue));
+      }
+      consumer->updatePullOffset(message_queue_, pull_result.next_begin_offset());
+    }
+
+    auto config = consumer->getDefaultLitePullConsumerConfig();
+    long pull_delay_time_millis = 0;
+    switch (pull_result.pull_status()) {
+      case PullStatus::OFFSET_ILLEGAL:
+        LOG_WARN_NEW("The pull request offset illegal, {}", pull_result.toString());
+        break;
+      case PullStatus::NO_NEW_MSG:
+      case PullStatus::NO_MATCHED_MSG:
+        pull_delay_time_millis = 1000;
+        break;
+      case PullStatus::NO_LATEST_MSG:
+        pull_delay_time_millis = config->pull_time_delay_millis_when_exception();
+        break;
+      default:
+        break;
+    }
+
+    scheduleNext(consumer, pull_delay_time_millis);
+  }
+
+  void onPullException(DefaultLitePullConsumerImplPtr consumer, const std::exception& e) {
+    LOG_ERROR_NEW("An error occurred in pull message process. {}", e.what());
+    scheduleNext(consumer, consumer->getDefaultLitePullConsumerConfig()->pull_time_delay_millis_when_exception());
+  }
+
+ public:
+  inline const MQMessageQueue& message_queue() { return message_queue_; }
+  inline DefaultLitePullConsumerImplPtr consumer() { return default_lite_pull_consumer_.lock(); }
+
+  inline bool is_cancelled() const { return cancelled_; }
+  inline void set_cancelled(bool cancelled) { cancelled_ = cancelled; }
+
+ private:
+  void scheduleNext(DefaultLitePullConsumerImplPtr consumer, long delay_millis) {
+    if (!cancelled_) {
+      consumer->scheduled_thread_pool_executor_.schedule(
+          std::bind(&DefaultLitePullConsumerImpl::PullTaskImpl::run, shared_from_this()), delay_millis,
+          time_unit::milliseconds);
+    } else {
+      LOG_WARN_NEW("The Pull Task is cancelled after doPullTask, {}", message_queue_.toString());
+    }
+  }
+
+ private:
+  std::weak_ptr<DefaultLitePullConsumerImpl> default_lite_pull_consumer_;
+  MQMessageQueue message_queue_;
+  volatile bool cancelled_;
+};
+
+inline void DefaultLitePullConsumerImpl::AsyncPullCallback::onSuccess(std::unique_ptr<PullResult> pull_result) {
+  auto consumer = pull_task_->consumer();
+  if (nullptr == consumer) {
+    LOG_WARN_NEW("AsyncPullCallback::onSuccess: DefaultLitePullConsumerImpl is released.");
+    return;
+  }
+
+  try {
+    pull_result.reset(consumer->pull_api_wrapper_->processPullResult(pull_task_->message_queue(),
+                                                                     std::move(pull_result), subscription_data_));
+    pull_task_->onPullResult(consumer, process_queue_, *pull_result, seek_generation_);
+  } catch (std::exception& e) {
+    pull_task_->onPullException(consumer, e);
+  }
+}
+
+inline void DefaultLitePullConsumerImpl::AsyncPullCallback::onException(MQException& e) noexcept {
+  auto consumer = pull_task_->consumer();
+  if (nullptr == consumer) {
+    LOG_WARN_NEW("AsyncPullCallback::onException: DefaultLitePullConsumerImpl is released.");
+    return;
+  }
+
+  pull_task_->onPullException(consumer, e);
+}
+
+}  // namespace rocketmq
+
+#endif  // ROCKETMQ_CONSUMER_LITEPULLTASK_HPP_
@@ -0,0 +1,226 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ROCKETMQ_CONSUMER_MESSAGEOFFSETRING_HPP_
+#define ROCKETMQ_CONSUMER_MESSAGEOFFSETRING_HPP_
+
+#include <algorithm>  // std::max, std::min
+#include <cstddef>    // size_t
+#include <cstdint>    // int64_t
+#include <map>        // std::map
+#include <utility>    // std::move
+#include <vector>     // std::vector
+
+#include "MessageExt.h"
+
+namespace rocketmq {
+
+/**
+ * MessageOffsetRing - messages of one queue, indexed by queue offset
+ *
+ * queue offsets are dense and monotonic, so the messages are kept in a power-of-two ring whose slot is
+ * (offset & mask). all messages live in the window [min_offset, max_offset], which never exceeds the
+ * capacity; the ring grows when the window does. put and remove are O(1), amortized over the empty slots
+ * skipped when the ends of the window move. offsets without message (e.g. filtered by the broker) are
+ * empty slots. when the window would hold more than kMaxSlotsPerMessage slots per message, the messages
+ * move to an ordered map until the ring is empty again, so memory follows the message count rather than
+ * the offset span. not thread-safe.
+ */
+class MessageOffsetRing {
+ public:
+  MessageOffsetRing() : begin_(0), end_(0), count_(0) {}
+
+  inline bool empty() const { return count_ == 0; }
+  inline size_t size() const { return count_; }
+
+  // valid only if not empty
+  inline int64_t min_offset() const { return begin_; }
+  inline int64_t max_offset() const { return end_ - 1; }
+
+  // put msg at its queue offset, return the message it replaced, if any
+  MessageExtPtr put(MessageExtPtr msg) {
+    const int64_t offset = msg->queue_offset();
+    if (sparse_.empty() && count_ > 0) {
+      const int64_t span = std::max(end_, offset + 1) - std::min(begin_, offset);
+      if (static_cast<size_t>(span) > slots_.size() && tooSparse(span, count_ + 1)) {
+        toSparse();
+      }
+    }
+    if (!sparse_.empty()) {
+      return putSparse(std::move(msg));
+    }
+
+    if (count_ == 0) {
+      begin_ = offset;
+      end_ = offset + 1;
+    } else if (offset < begin_) {
+      reserve(end_ - offset);
+      begin_ = offset;
+    } else if (offset >= end_) {
+      reserve(offset + 1 - begin_);
+      end_ = offset + 1;
+    }
+    if (slots_.empty()) {
+      slots_.resize(kInitialCapacity);
+    }
+
+    auto& slot = slots_[index(offset)];
+    MessageExtPtr replaced = std::move(slot);
+    slot = std::move(msg);
+    if (replaced == nullptr) {
+      count_++;
+    }
+    return replaced;
+  }
+
+  // remove the message at offset, return it, or nullptr if there is none
+  MessageExtPtr remove(int64_t offset) {
+    if (count_ == 0 || offset < begin_ || offset >= end_) {
+      return nullptr;
+    }
+    if (!sparse_.empty()) {
+      return removeSparse(offset);
+    }
+
+    MessageExtPtr removed = std::move(slots_[index(offset)]);
+    if (removed == nullptr) {
+      return nullptr;
+    }
+
+    if (--count_ == 0) {
+      begin_ = end_ = 0;
+      if (slots_.size() > kMaxIdleCapacity) {
+        std::vector<MessageExtPtr>().swap(slots_);
+      }
+    } else if (offset == begin_) {
+      while (slots_[index(begin_)] == nullptr) {
+        begin_++;
+      }
+    } else if (offset == end_ - 1) {
+      while (slots_[index(end_ - 1)] == nullptr) {
+        end_--;
+      }
+    }
+    return removed;
+  }
+
+  // remove and return the message with the smallest offset, or nullptr if empty
+  MessageExtPtr pop_front() { return count_ == 0 ? nullptr : remove(begin_); }
+
+  // visit the messages in ascending offset order
+  template <typename Function>
+  void for_each(Function&& function) const {
+    if (!sparse_.empty()) {
+      for (const auto& entry : sparse_) {
+        function(entry.second);
+      }
+      return;
+    }
+    for (int64_t offset = begin_; offset < end_; offset++) {
+      const auto& msg = slots_[index(offset)];
+      if (msg != nullptr) {
+        function(msg);
+      }
+    }
+  }
+
+  void clear() {
+    std::vector<MessageExtPtr>().swap(slots_);
+    sparse_.clear();
+    begin_ = end_ = 0;
+    count_ = 0;
+  }
+
+ private:
+  static const size_t kInitialCapacity = 64;
+  static const size_t kMaxIdleCapacity = 4096;  // release larger rings once they are empty
+  static const size_t kMaxSlotsPerMessage = 8;  // sparser windows are kept in sparse_
+
+  inline size_t index(int64_t offset) const { return static_cast<size_t>(offset) & (slots_.size() - 1); }
+
+  // make room for a window of span offsets
+  void reserve(int64_t span) {
+    if (static_cast<size_t>(span) <= slots_.size()) {
+      return;
+    }
+
+    size_t capacity = slots_.size();
+    while (capacity < static_cast<size_t>(span)) {
+      capacity <<= 1;
+    }
+
+    std::vector<MessageExtPtr> slots(capacity);
+    for (int64_t offset = begin_; offset < end_; offset++) {
+      slots[static_cast<size_t>(offset) & (capacity - 1)] = std::move(slots_[index(offset)]);
+    }
+    slots_.swap(slots);
+  }
+
+  static bool tooSparse(int64_t span, size_t count) {
+    return static_cast<size_t>(span) > kInitialCapacity && static_cast<size_t>(span) / count > kMaxSlotsPerMessage;
+  }
+
+  // move every message from the ring to sparse_, and release the slots
+  void toSparse() {
+    for (int64_t offset = begin_; offset < end_; offset++) {
+      auto& slot = slots_[index(offset)];
+      if (slot != nullptr) {
+        sparse_.emplace(offset, std::move(slot));
+      }
+    }
+    std::vector<MessageExtPtr>().swap(slots_);
+  }
+
+  MessageExtPtr putSparse(MessageExtPtr msg) {
+    auto& slot = sparse_[msg->queue_offset()];
+    MessageExtPtr replaced = std::move(slot);
+    slot = std::move(msg);
+    if (replaced == nullptr) {
+      count_++;
+    }
+    begin_ = sparse_.begin()->first;
+    end_ = sparse_.rbegin()->first + 1;
+    return replaced;
+  }
+
+  // once empty, the next message starts a ring again
+  MessageExtPtr removeSparse(int64_t offset) {
+    auto it = sparse_.find(offset);
+    if (it == sparse_.end()) {
+      return nullptr;
+    }
+    MessageExtPtr removed = std::move(it->second);
+    sparse_.erase(it);
+    if (--count_ == 0) {
+      begin_ = end_ = 0;
+    } else {
+      begin_ = sparse_.begin()->first;
+      end_ = sparse_.rbegin()->first + 1;
+    }
+    return removed;
+  }
+
+ private:
+  std::vector<MessageExtPtr> slots_;
+  std::map<int64_t, MessageExtPtr> sparse_;  // holds every message instead of slots_ when not empty
+  int64_t begin_;  // smallest offset in the ring
+  int64_t end_;    // one past the largest offset in the ring
+  size_t count_;
+};
+
+}  // namespace rocketmq
+
+#endif  // ROCKETMQ_CONSUMER_MESSAGEOFFSETRING_HPP_
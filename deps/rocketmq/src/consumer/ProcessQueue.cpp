@@ -29,6 +29,8 @@ const uint64_t ProcessQueue::REBALANCE_LOCK_INTERVAL = 20000;
 
 ProcessQueue::ProcessQueue()
     : queue_offset_max_(0),
+      msg_size_(0),
+      consuming_(false),
       dropped_(false),
       last_pull_timestamp_(UtilAll::currentTimeMillis()),
       last_consume_timestamp_(UtilAll::currentTimeMillis()),
@@ -51,13 +53,19 @@ bool ProcessQueue::isPullExpired() const {
 void ProcessQueue::putMessage(const std::vector<MessageExtPtr>& msgs) {
   std::lock_guard<std::mutex> lock(lock_tree_map_);
 
+  int64_t size = 0;
   for (const auto& msg : msgs) {
     int64_t offset = msg->queue_offset();
-    msg_tree_map_[offset] = msg;
+    auto replaced = msg_tree_map_.put(msg);
+    if (replaced != nullptr) {
+      size -= replaced->body().size();
+    }
+    size += msg->body().size();
     if (offset > queue_offset_max_) {
       queue_offset_max_ = offset;
     }
   }
+  msg_size_.fetch_add(size);
 
   LOG_DEBUG_NEW("ProcessQueue: putMessage queue_offset_max:{}", queue_offset_max_);
 }
@@ -73,14 +81,18 @@ int64_t ProcessQueue::removeMessage(const std::vector<MessageExtPtr>& msgs) {
     result = queue_offset_max_ + 1;
     LOG_DEBUG_NEW("offset result is:{}, queue_offset_max is:{}, msgs size:{}", result, queue_offset_max_, msgs.size());
 
+    int64_t size = 0;
     for (auto& msg : msgs) {
       LOG_DEBUG_NEW("remove these msg from msg_tree_map, its offset:{}", msg->queue_offset());
-      msg_tree_map_.erase(msg->queue_offset());
+      auto removed = msg_tree_map_.remove(msg->queue_offset());
+      if (removed != nullptr) {
+        size += removed->body().size();
+      }
     }
+    msg_size_.fetch_sub(size);
 
     if (!msg_tree_map_.empty()) {
-      auto it = msg_tree_map_.begin();
-      result = it->first;
+      result = msg_tree_map_.min_offset();
     }
   }
 
@@ -97,9 +109,9 @@ int64_t ProcessQueue::getCacheMinOffset() {
   if (msg_tree_map_.empty() && consuming_msg_orderly_tree_map_.empty()) {
     return 0;
   } else if (!consuming_msg_orderly_tree_map_.empty()) {
-    return consuming_msg_orderly_tree_map_.begin()->first;
+    return consuming_msg_orderly_tree_map_.min_offset();
   } else {
-    return msg_tree_map_.begin()->first;
+    return msg_tree_map_.min_offset();
   }
 }
 
@@ -107,10 +119,21 @@ int64_t ProcessQueue::getCacheMaxOffset() {
   return queue_offset_max_;
 }
 
+int64_t ProcessQueue::getMaxSpan() {
+  std::lock_guard<std::mutex> lock(lock_tree_map_);
+  if (msg_tree_map_.empty()) {
+    return 0;
+  }
+  return msg_tree_map_.max_offset() - msg_tree_map_.min_offset();
+}
+
 int64_t ProcessQueue::commit() {
   std::lock_guard<std::mutex> lock(lock_tree_map_);
   if (!consuming_msg_orderly_tree_map_.empty()) {
-    int64_t offset = (--consuming_msg_orderly_tree_map_.end())->first;
+    int64_t offset = consuming_msg_orderly_tree_map_.max_offset();
+    int64_t size = 0;
+    consuming_msg_orderly_tree_map_.for_each([&size](const MessageExtPtr& msg) { size += msg->body().size(); });
+    msg_size_.fetch_sub(size);
     consuming_msg_orderly_tree_map_.clear();
     return offset + 1;
   } else {
@@ -121,17 +144,17 @@ int64_t ProcessQueue::commit() {
 void ProcessQueue::makeMessageToCosumeAgain(std::vector<MessageExtPtr>& msgs) {
   std::lock_guard<std::mutex> lock(lock_tree_map_);
   for (const auto& msg : msgs) {
-    msg_tree_map_[msg->queue_offset()] = msg;
-    consuming_msg_orderly_tree_map_.erase(msg->queue_offset());
+    msg_tree_map_.put(msg);
+    consuming_msg_orderly_tree_map_.remove(msg->queue_offset());
   }
 }
 
 void ProcessQueue::takeMessages(std::vector<MessageExtPtr>& out_msgs, int batchSize) {
   std::lock_guard<std::mutex> lock(lock_tree_map_);
-  for (auto it = msg_tree_map_.begin(); it != msg_tree_map_.end() && batchSize--;) {
-    out_msgs.push_back(it->second);
-    consuming_msg_orderly_tree_map_[it->first] = it->second;
-    it = msg_tree_map_.erase(it);
+  for (; !msg_tree_map_.empty() && batchSize > 0; batchSize--) {
+    auto msg = msg_tree_map_.pop_front();
+    out_msgs.push_back(msg);
+    consuming_msg_orderly_tree_map_.put(std::move(msg));
   }
 }
 
@@ -143,21 +166,31 @@ void ProcessQueue::clearAllMsgs() {
     msg_tree_map_.clear();
     consuming_msg_orderly_tree_map_.clear();
     queue_offset_max_ = 0;
+    msg_size_.store(0);
   }
 }
 
+void ProcessQueue::clear() {
+  std::lock_guard<std::mutex> lock(lock_tree_map_);
+  msg_tree_map_.clear();
+  consuming_msg_orderly_tree_map_.clear();
+  queue_offset_max_ = 0;
+  msg_size_.store(0);
+}
+
 void ProcessQueue::fillProcessQueueInfo(ProcessQueueInfo& info) {
   std::lock_guard<std::mutex> lock(lock_tree_map_);
 
   if (!msg_tree_map_.empty()) {
-    info.cachedMsgMinOffset = msg_tree_map_.begin()->first;
+    info.cachedMsgMinOffset = msg_tree_map_.min_offset();
     info.cachedMsgMaxOffset = queue_offset_max_;
     info.cachedMsgCount = msg_tree_map_.size();
   }
+  info.cachedMsgSizeInMiB = static_cast<int32_t>(msg_size_.load() / (1024 * 1024));
 
   if (!consuming_msg_orderly_tree_map_.empty()) {
-    info.transactionMsgMinOffset = consuming_msg_orderly_tree_map_.begin()->first;
-    info.transactionMsgMaxOffset = (--consuming_msg_orderly_tree_map_.end())->first;
+    info.transactionMsgMinOffset = consuming_msg_orderly_tree_map_.min_offset();
+    info.transactionMsgMaxOffset = consuming_msg_orderly_tree_map_.max_offset();
     info.transactionMsgCount = consuming_msg_orderly_tree_map_.size();
   }
 
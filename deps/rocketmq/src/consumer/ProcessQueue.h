@@ -18,12 +18,12 @@
 #define ROCKETMQ_CONSUMER_PROCESSQUEUE_H_
 
 #include <atomic>  // std::atomic
-#include <map>     // std::map
 #include <memory>  // std::shared_ptr
 #include <mutex>   // std::mutex
 #include <vector>  // std::vector
 
 #include "MessageExt.h"
+#include "MessageOffsetRing.hpp"
 
 namespace rocketmq {
 
@@ -51,12 +51,20 @@ class ROCKETMQCLIENT_API ProcessQueue {
   int64_t getCacheMinOffset();
   int64_t getCacheMaxOffset();
 
+  // total body size of cached messages, in bytes
+  inline int64_t getCacheMsgSize() const { return msg_size_.load(); }
+  // offset span of messages waiting to be consumed
+  int64_t getMaxSpan();
+
   int64_t commit();
   void makeMessageToCosumeAgain(std::vector<MessageExtPtr>& msgs);
   void takeMessages(std::vector<MessageExtPtr>& out_msgs, int batchSize);
 
   void clearAllMsgs();
 
+  // drop all cached messages, even if the queue is not dropped
+  void clear();
+
   void fillProcessQueueInfo(ProcessQueueInfo& info);
 
  public:
@@ -65,6 +73,10 @@ class ROCKETMQCLIENT_API ProcessQueue {
   inline long try_unlock_times() const { return try_unlock_times_.load(); }
   inline void inc_try_unlock_times() { try_unlock_times_.fetch_add(1); }
 
+  // true while a batch taken by orderly consuming has not been completed by the listener
+  inline bool consuming() const { return consuming_.load(); }
+  inline void set_consuming(bool consuming) { consuming_.store(consuming); }
+
   inline bool dropped() const { return dropped_.load(); }
   inline void set_dropped(bool dropped) { dropped_.store(dropped); }
 
@@ -84,11 +96,13 @@ class ROCKETMQCLIENT_API ProcessQueue {
 
  private:
   std::mutex lock_tree_map_;
-  std::map<int64_t, MessageExtPtr> msg_tree_map_;
+  MessageOffsetRing msg_tree_map_;
   std::timed_mutex lock_consume_;
-  std::map<int64_t, MessageExtPtr> consuming_msg_orderly_tree_map_;
+  MessageOffsetRing consuming_msg_orderly_tree_map_;
   std::atomic<long> try_unlock_times_;
   volatile int64_t queue_offset_max_;
+  std::atomic<int64_t> msg_size_;  // modified with lock_tree_map_
+  std::atomic<bool> consuming_;
   std::atomic<bool> dropped_;
   volatile uint64_t last_pull_timestamp_;
   volatile uint64_t last_consume_timestamp_;
@@ -450,6 +450,15 @@ MQ2PQ RebalanceImpl::getProcessQueueTable() {
   return process_queue_table_;
 }
 
+int64_t RebalanceImpl::getCachedMessageSize() {
+  int64_t size = 0;
+  std::lock_guard<std::mutex> lock(process_queue_table_mutex_);
+  for (const auto& it : process_queue_table_) {
+    size += it.second->getCacheMsgSize();
+  }
+  return size;
+}
+
 std::vector<MQMessageQueue> RebalanceImpl::getAllocatedMQ() {
   std::vector<MQMessageQueue> mqs;
   std::lock_guard<std::mutex> lock(process_queue_table_mutex_);
@@ -85,6 +85,7 @@ class RebalanceImpl {
   ProcessQueuePtr putProcessQueueIfAbsent(const MQMessageQueue& mq, ProcessQueuePtr pq);
   ProcessQueuePtr getProcessQueue(const MQMessageQueue& mq);
   MQ2PQ getProcessQueueTable();
+  int64_t getCachedMessageSize();
   std::vector<MQMessageQueue> getAllocatedMQ();
 
  public:
@@ -35,9 +35,14 @@ bool RebalancePushImpl::removeUnnecessaryMessageQueue(const MQMessageQueue& mq,
     try {
       if (UtilAll::try_lock_for(pq->lock_consume(), 1000)) {
         std::lock_guard<std::timed_mutex> lock(pq->lock_consume(), std::adopt_lock);
-        // TODO: unlockDelay
-        unlock(mq);
-        return true;
+        if (!pq->consuming()) {
+          // TODO: unlockDelay
+          unlock(mq);
+          return true;
+        }
+        LOG_WARN("[WRONG]mq has a batch in consuming, so can not unlock it, %s. %ld", mq.toString().c_str(),
+                 pq->try_unlock_times());
+        pq->inc_try_unlock_times();
       } else {
         LOG_WARN("[WRONG]mq is consuming, so can not unlock it, %s. maybe hanged for a while, %ld",
                  mq.toString().c_str(), pq->try_unlock_times());
@@ -16,6 +16,7 @@
  */
 #include "MessageBatch.h"
 
+#include "CompressionCodec.h"
 #include "MQException.h"
 #include "MessageClientIDSetter.h"
 #include "MessageDecoder.h"
@@ -60,4 +61,31 @@ std::string MessageBatch::encode() {
   return MessageDecoder::encodeMessages(messages_);
 }
 
+bool MessageBatch::compress(const CompressionCodec& codec, int level) {
+  // the broker stores every inner message with the sysFlag of the batch, so each inner body is compressed on its own
+  // and the consumer decompresses them one by one like any other message.
+  std::vector<std::string> compressedBodies(messages_.size());
+  for (size_t i = 0; i < messages_.size(); i++) {
+    const auto& message = messages_[i];
+    if (UtilAll::stob(message.getProperty(MQMessageConst::PROPERTY_ALREADY_COMPRESSED_FLAG))) {
+      continue;
+    }
+    const auto& body = message.body();
+    if (!codec.compress(body.data(), body.size(), level, compressedBodies[i])) {
+      return false;
+    }
+  }
+
+  for (size_t i = 0; i < messages_.size(); i++) {
+    auto& message = messages_[i];
+    if (UtilAll::stob(message.getProperty(MQMessageConst::PROPERTY_ALREADY_COMPRESSED_FLAG))) {
+      continue;
+    }
+    message.set_body(std::move(compressedBodies[i]));
+    message.putProperty(MQMessageConst::PROPERTY_ALREADY_COMPRESSED_FLAG, "true");
+  }
+  set_body(encode());
+  return true;
+}
+
 }  // namespace rocketmq
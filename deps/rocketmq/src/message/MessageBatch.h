@@ -22,6 +22,8 @@
 
 namespace rocketmq {
 
+class CompressionCodec;
+
 class MessageBatch : public MessageImpl {
  public:
   static std::shared_ptr<MessageBatch> generateFromList(std::vector<MQMessage>& messages);
@@ -35,6 +37,9 @@ class MessageBatch : public MessageImpl {
  public:
   std::string encode();
 
+  // compress the body of every inner message and re-encode the batch body, all or nothing.
+  bool compress(const CompressionCodec& codec, int level);
+
   const std::vector<MQMessage>& messages() const { return messages_; }
 
  protected:
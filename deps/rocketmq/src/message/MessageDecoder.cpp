@@ -17,7 +17,9 @@
 #include "MessageDecoder.h"
 
 #include <algorithm>  // std::move
+#include <cstring>    // std::memchr, std::memcpy
 #include <sstream>    // std::stringstream
+#include <stdexcept>  // std::runtime_error
 
 #ifndef WIN32
 #include <arpa/inet.h>   // htons
@@ -27,6 +29,7 @@
 #endif
 
 #include "ByteOrder.h"
+#include "CompressionCodec.h"
 #include "Logging.h"
 #include "MessageAccessor.hpp"
 #include "MessageExtImpl.h"
@@ -39,21 +42,73 @@ static const char PROPERTY_SEPARATOR = 2;
 
 namespace rocketmq {
 
+// returns the next length bytes in place and moves the position past them
+static inline char* nextSlice(ByteBuffer& byteBuffer, int32_t length) {
+  if (length > byteBuffer.remaining()) {
+    throw std::runtime_error("BufferUnderflowException");
+  }
+  char* slice = byteBuffer.array() + byteBuffer.arrayOffset() + byteBuffer.position();
+  byteBuffer.position(byteBuffer.position() + length);
+  return slice;
+}
+
+// name\001value\002... in one pass, entries without exactly one name and one value are dropped.
+// empty fields are skipped like UtilAll::Split does.
+static void parseProperties(const char* data, size_t len, std::map<std::string, std::string>& properties) {
+  const char* end = data + len;
+  while (data < end) {
+    const char* entryEnd = static_cast<const char*>(std::memchr(data, PROPERTY_SEPARATOR, end - data));
+    if (entryEnd == nullptr) {
+      entryEnd = end;
+    }
+
+    const char* fields[2][2];
+    int fieldNums = 0;
+    for (const char* p = data; p < entryEnd;) {
+      if (*p == NAME_VALUE_SEPARATOR) {
+        p++;
+        continue;
+      }
+      const char* fieldEnd = static_cast<const char*>(std::memchr(p, NAME_VALUE_SEPARATOR, entryEnd - p));
+      if (fieldEnd == nullptr) {
+        fieldEnd = entryEnd;
+      }
+      if (fieldNums < 2) {
+        fields[fieldNums][0] = p;
+        fields[fieldNums][1] = fieldEnd;
+      }
+      fieldNums++;
+      p = fieldEnd;
+    }
+
+    if (fieldNums == 2) {
+      properties[std::string(fields[0][0], fields[0][1])].assign(fields[1][0], fields[1][1]);
+    }
+    data = entryEnd + 1;
+  }
+}
+
 std::string MessageDecoder::createMessageId(const struct sockaddr* sa, int64_t offset) {
-  int msgIdLength = IpaddrSize(sa) + /* port field size */ 4 + sizeof(offset);
-  std::unique_ptr<ByteBuffer> byteBuffer(ByteBuffer::allocate(msgIdLength));
+  // IP|PORT|OFFSET, formatted straight from a stack buffer
+  char raw[kIPv6AddrSize + /* port field size */ 4 + sizeof(offset)];
+  size_t ipLength;
+  uint32_t port;
   if (sa->sa_family == AF_INET) {
-    struct sockaddr_in* sin = (struct sockaddr_in*)sa;
-    byteBuffer->put(ByteArray(reinterpret_cast<char*>(&sin->sin_addr), kIPv4AddrSize));
-    byteBuffer->putInt(ntohs(sin->sin_port));
+    const struct sockaddr_in* sin = (const struct sockaddr_in*)sa;
+    ipLength = kIPv4AddrSize;
+    std::memcpy(raw, &sin->sin_addr, ipLength);
+    port = ntohs(sin->sin_port);
   } else {
-    struct sockaddr_in6* sin6 = (struct sockaddr_in6*)sa;
-    byteBuffer->put(ByteArray(reinterpret_cast<char*>(&sin6->sin6_addr), kIPv6AddrSize));
-    byteBuffer->putInt(ntohs(sin6->sin6_port));
+    const struct sockaddr_in6* sin6 = (const struct sockaddr_in6*)sa;
+    ipLength = kIPv6AddrSize;
+    std::memcpy(raw, &sin6->sin6_addr, ipLength);
+    port = ntohs(sin6->sin6_port);
   }
-  byteBuffer->putLong(offset);
-  byteBuffer->flip();
-  return UtilAll::bytes2string(byteBuffer->array(), msgIdLength);
+  uint32_t port_net = ByteOrderUtil::NorminalBigEndian(port);
+  std::memcpy(raw + ipLength, &port_net, sizeof(port_net));
+  uint64_t offset_net = ByteOrderUtil::NorminalBigEndian(static_cast<uint64_t>(offset));
+  std::memcpy(raw + ipLength + sizeof(port_net), &offset_net, sizeof(offset_net));
+  return UtilAll::bytes2string(raw, ipLength + sizeof(port_net) + sizeof(offset_net));
 }
 
 MessageId MessageDecoder::decodeMessageId(const std::string& msgId) {
@@ -126,8 +181,7 @@ MessageExtPtr MessageDecoder::decode(ByteBuffer& byteBuffer, bool readBody, bool
 
   // 10 BORNHOST
   int bornHostLength = (sysFlag & MessageSysFlag::BORNHOST_V6_FLAG) == 0 ? kIPv4AddrSize : kIPv6AddrSize;
-  ByteArray bornHost(bornHostLength);
-  byteBuffer.get(bornHost, 0, bornHostLength);
+  ByteArray bornHost(nextSlice(byteBuffer, bornHostLength), bornHostLength);
   int32_t bornPort = byteBuffer.getInt();
   msgExt->set_born_host(GetSockaddrPtr(IPPortToSockaddr(bornHost, static_cast<uint16_t>(bornPort))));
 
@@ -137,8 +191,7 @@ MessageExtPtr MessageDecoder::decode(ByteBuffer& byteBuffer, bool readBody, bool
 
   // 12 STOREHOST
   int storehostIPLength = (sysFlag & MessageSysFlag::STOREHOST_V6_FLAG) == 0 ? kIPv4AddrSize : kIPv6AddrSize;
-  ByteArray storeHost(storehostIPLength);
-  byteBuffer.get(storeHost, 0, storehostIPLength);
+  ByteArray storeHost(nextSlice(byteBuffer, storehostIPLength), storehostIPLength);
   int32_t storePort = byteBuffer.getInt();
   msgExt->set_store_host(GetSockaddrPtr(IPPortToSockaddr(storeHost, static_cast<uint16_t>(storePort))));
 
@@ -168,13 +221,13 @@ MessageExtPtr MessageDecoder::decode(ByteBuffer& byteBuffer, bool readBody, bool
       return nullptr;
     }
     if (readBody) {
-      ByteArray body(byteBuffer.array() + byteBuffer.arrayOffset() + byteBuffer.position(), bodyLen);
-      byteBuffer.position(byteBuffer.position() + bodyLen);
+      ByteArray body(nextSlice(byteBuffer, bodyLen), bodyLen);
 
       // decompress body
       if (deCompressBody && (sysFlag & MessageSysFlag::COMPRESSED_FLAG) == MessageSysFlag::COMPRESSED_FLAG) {
+        const auto* codec = CompressionCodec::of(MessageSysFlag::getCompressionType(sysFlag));
         std::string origin_body;
-        if (UtilAll::inflate(body, origin_body)) {
+        if (codec != nullptr && codec->uncompress(body.array(), body.size(), origin_body)) {
           msgExt->set_body(std::move(origin_body));
         } else {
           uncompress_failed = true;
@@ -195,9 +248,7 @@ MessageExtPtr MessageDecoder::decode(ByteBuffer& byteBuffer, bool readBody, bool
     LOG_ERROR_NEW("Invalid topic length:{}, remain: {}", topicLen, byteBuffer.remaining());
     return nullptr;
   }
-  ByteArray topic(topicLen);
-  byteBuffer.get(topic);
-  msgExt->set_topic(topic.array(), topic.size());
+  msgExt->set_topic(nextSlice(byteBuffer, topicLen), topicLen);
 
   // 17 properties
   int16_t propertiesLenRaw = byteBuffer.getShort();
@@ -206,16 +257,16 @@ MessageExtPtr MessageDecoder::decode(ByteBuffer& byteBuffer, bool readBody, bool
     return nullptr;
   }
   if (propertiesLenRaw > 0) {
-    ByteArray properties(propertiesLenRaw);
-    byteBuffer.get(properties);
-    std::string propertiesString(properties.array(), properties.size());
-    std::map<std::string, std::string> propertiesMap = string2messageProperties(propertiesString);
+    std::map<std::string, std::string> propertiesMap;
+    parseProperties(nextSlice(byteBuffer, propertiesLenRaw), propertiesLenRaw, propertiesMap);
     MessageAccessor::setProperties(*msgExt, std::move(propertiesMap));
   }
 
-  // 18 msg ID
-  std::string msgId = createMessageId(msgExt->store_host(), (int64_t)msgExt->commit_log_offset());
-  msgExt->MessageExtImpl::set_msg_id(msgId);
+  // 18 msg ID, client messages format it on first access
+  if (!isClient) {
+    std::string msgId = createMessageId(msgExt->store_host(), (int64_t)msgExt->commit_log_offset());
+    msgExt->MessageExtImpl::set_msg_id(msgId);
+  }
 
   if (uncompress_failed) {
     LOG_WARN_NEW("can not uncompress message, id:{}", msgExt->msg_id());
@@ -262,72 +313,100 @@ std::string MessageDecoder::messageProperties2String(const std::map<std::string,
 }
 
 std::map<std::string, std::string> MessageDecoder::string2messageProperties(const std::string& properties) {
-  std::vector<std::string> out;
-  UtilAll::Split(out, properties, PROPERTY_SEPARATOR);
-
   std::map<std::string, std::string> map;
-  for (size_t i = 0; i < out.size(); i++) {
-    std::vector<std::string> outValue;
-    UtilAll::Split(outValue, out[i], NAME_VALUE_SEPARATOR);
+  parseProperties(properties.data(), properties.size(), map);
+  return map;
+}
 
-    if (outValue.size() == 2) {
-      map[outValue[0]] = outValue[1];
+// length of messageProperties2String(properties), without building the string
+static size_t propertiesLength(const std::map<std::string, std::string>& properties) {
+  size_t length = 0;
+  for (const auto& it : properties) {
+    if (MQMessageConst::PROPERTY_ALREADY_COMPRESSED_FLAG == it.first) {
+      continue;
     }
+    length += it.first.size() + 1 + it.second.size() + 1;
   }
-  return map;
+  return length;
 }
 
-std::string MessageDecoder::encodeMessage(Message& message) {
+static inline char* putBytes(char* dst, const char* src, size_t length) {
+  std::memcpy(dst, src, length);
+  return dst + length;
+}
+
+template <typename T>
+static inline char* putBigEndian(char* dst, T value) {
+  auto value_net = ByteOrderUtil::NorminalBigEndian(value);
+  return putBytes(dst, reinterpret_cast<const char*>(&value_net), sizeof(value_net));
+}
+
+// TOTALSIZE|MAGICCODE|BODYCRC|FLAG|BodyLen|Body|propertiesLength|properties
+static inline size_t encodedMessageSize(const Message& message, size_t propertiesLength) {
+  return 4                            // 1 TOTALSIZE
+         + 4                          // 2 MAGICCODE
+         + 4                          // 3 BODYCRC
+         + 4                          // 4 FLAG
+         + 4 + message.body().size()  // 5 BODY
+         + 2 + propertiesLength;      // 6 PROPERTIES
+}
+
+// writes one message at dst, which has room for encodedMessageSize(), and returns the end of it
+static char* encodeMessageTo(const Message& message, size_t propertiesLength, char* dst) {
   const auto& body = message.body();
-  uint32_t bodyLen = body.size();
-  std::string properties = MessageDecoder::messageProperties2String(message.properties());
-  uint16_t propertiesLength = (int16_t)properties.size();
-  uint32_t storeSize = 4                        // 1 TOTALSIZE
-                       + 4                      // 2 MAGICCODE
-                       + 4                      // 3 BODYCRC
-                       + 4                      // 4 FLAG
-                       + 4 + bodyLen            // 5 BODY
-                       + 2 + propertiesLength;  // 6 PROPERTIES
-
-  // TOTALSIZE|MAGICCODE|BODYCRC|FLAG|BodyLen|Body|propertiesLength|properties
-  std::string encodeMsg;
 
   // 1 TOTALSIZE
-  uint32_t storeSize_net = ByteOrderUtil::NorminalBigEndian(storeSize);
-  encodeMsg.append((char*)&storeSize_net, sizeof(uint32_t));
+  dst = putBigEndian(dst, static_cast<uint32_t>(encodedMessageSize(message, propertiesLength)));
 
   // 2 MAGICCODE
-  uint32_t magicCode = 0;
-  uint32_t magicCode_net = ByteOrderUtil::NorminalBigEndian(magicCode);
-  encodeMsg.append((char*)&magicCode_net, sizeof(uint32_t));
+  dst = putBigEndian(dst, static_cast<uint32_t>(0));
 
   // 3 BODYCRC
-  uint32_t bodyCrc = 0;
-  uint32_t bodyCrc_net = ByteOrderUtil::NorminalBigEndian(bodyCrc);
-  encodeMsg.append((char*)&bodyCrc_net, sizeof(uint32_t));
+  dst = putBigEndian(dst, static_cast<uint32_t>(0));
 
   // 4 FLAG
-  uint32_t flag = message.flag();
-  uint32_t flag_net = ByteOrderUtil::NorminalBigEndian(flag);
-  encodeMsg.append((char*)&flag_net, sizeof(uint32_t));
+  dst = putBigEndian(dst, static_cast<uint32_t>(message.flag()));
 
   // 5 BODY
-  uint32_t bodyLen_net = ByteOrderUtil::NorminalBigEndian(bodyLen);
-  encodeMsg.append((char*)&bodyLen_net, sizeof(uint32_t));
-  encodeMsg.append(body.data(), body.size());
+  dst = putBigEndian(dst, static_cast<uint32_t>(body.size()));
+  dst = putBytes(dst, body.data(), body.size());
+
+  // 6 properties, serialized in place
+  dst = putBigEndian(dst, static_cast<uint16_t>(propertiesLength));
+  for (const auto& it : message.properties()) {
+    if (MQMessageConst::PROPERTY_ALREADY_COMPRESSED_FLAG == it.first) {
+      continue;
+    }
+    dst = putBytes(dst, it.first.data(), it.first.size());
+    *dst++ = NAME_VALUE_SEPARATOR;
+    dst = putBytes(dst, it.second.data(), it.second.size());
+    *dst++ = PROPERTY_SEPARATOR;
+  }
 
-  // 6 properties
-  uint16_t propertiesLength_net = ByteOrderUtil::NorminalBigEndian(propertiesLength);
-  encodeMsg.append((char*)&propertiesLength_net, sizeof(uint16_t));
-  encodeMsg.append(std::move(properties));
+  return dst;
+}
 
+std::string MessageDecoder::encodeMessage(const Message& message) {
+  size_t propsLength = propertiesLength(message.properties());
+  std::string encodeMsg(encodedMessageSize(message, propsLength), '\0');
+  encodeMessageTo(message, propsLength, &encodeMsg[0]);
   return encodeMsg;
 }
 
-std::string MessageDecoder::encodeMessages(std::vector<MQMessage>& msgs) {
-  std::string encodedBody;
-  for (auto msg : msgs) {
-    encodedBody.append(encodeMessage(msg));
+std::string MessageDecoder::encodeMessages(const std::vector<MQMessage>& msgs) {
+  // size the whole batch first, then write every message into the one buffer
+  std::vector<size_t> propsLengths;
+  propsLengths.reserve(msgs.size());
+  size_t totalSize = 0;
+  for (const auto& msg : msgs) {
+    propsLengths.push_back(propertiesLength(msg.properties()));
+    totalSize += encodedMessageSize(msg, propsLengths.back());
+  }
+
+  std::string encodedBody(totalSize, '\0');
+  char* dst = &encodedBody[0];
+  for (size_t i = 0; i < msgs.size(); i++) {
+    dst = encodeMessageTo(msgs[i], propsLengths[i], dst);
   }
   return encodedBody;
 }
@@ -45,8 +45,8 @@ class MessageDecoder {
   static std::string messageProperties2String(const std::map<std::string, std::string>& properties);
   static std::map<std::string, std::string> string2messageProperties(const std::string& properties);
 
-  static std::string encodeMessage(Message& message);
-  static std::string encodeMessages(std::vector<MQMessage>& msgs);
+  static std::string encodeMessage(const Message& message);
+  static std::string encodeMessages(const std::vector<MQMessage>& msgs);
 };
 
 }  // namespace rocketmq
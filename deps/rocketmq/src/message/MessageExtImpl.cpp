@@ -19,6 +19,7 @@
 #include <sstream>  // std::stringstream
 
 #include "MessageClientIDSetter.h"
+#include "MessageDecoder.h"
 #include "MessageSysFlag.h"
 #include "SocketUtil.h"
 #include "UtilAll.h"
@@ -198,6 +199,12 @@ void MessageClientExtImpl::set_msg_id(const std::string& msgId) {
 }
 
 const std::string& MessageClientExtImpl::offset_msg_id() const {
+  std::call_once(offset_msg_id_flag_, [this] {
+    if (MessageExtImpl::msg_id().empty() && store_host() != nullptr) {
+      const_cast<MessageClientExtImpl*>(this)->MessageExtImpl::set_msg_id(
+          MessageDecoder::createMessageId(store_host(), commit_log_offset()));
+    }
+  });
   return MessageExtImpl::msg_id();
 }
 
@@ -17,6 +17,8 @@
 #ifndef ROCKETMQ_MESSAGE_MESSAGEEXTIMPL_H_
 #define ROCKETMQ_MESSAGE_MESSAGEEXTIMPL_H_
 
+#include <mutex>  // std::once_flag
+
 #include "MessageExt.h"
 #include "MessageImpl.h"
 #include "TopicFilterType.h"
@@ -108,8 +110,12 @@ class MessageClientExtImpl : public MessageExtImpl {
   void set_msg_id(const std::string& msgId) override;
 
  public:
+  // formatted from store host and commit log offset on first access if not set
   const std::string& offset_msg_id() const;
   void set_offset_msg_id(const std::string& offsetMsgId);
+
+ private:
+  mutable std::once_flag offset_msg_id_flag_;
 };
 
 }  // namespace rocketmq
@@ -20,6 +20,7 @@
 #include <algorithm>  // std::min, std::max
 #include <thread>
 
+#include "CompressionCodec.h"
 #include "DefaultMQProducerConfig.h"
 #include "MQClientConfigImpl.hpp"
 
@@ -35,6 +36,7 @@ class DefaultMQProducerConfigImpl : virtual public DefaultMQProducerConfig, publ
         max_message_size_(1024 * 1024 * 4),         // 4MB
         compress_msg_body_over_howmuch_(1024 * 4),  // 4KB
         compress_level_(5),
+        compression_type_(CompressionType::ZLIB),
         send_msg_timeout_(3000),
         retry_times_(2),
         retry_times_for_async_(2),
@@ -62,6 +64,13 @@ class DefaultMQProducerConfigImpl : virtual public DefaultMQProducerConfig, publ
     }
   }
 
+  CompressionType compression_type() const override { return compression_type_; }
+  void set_compression_type(CompressionType compression_type) override {
+    if (CompressionCodec::of(compression_type) != nullptr) {
+      compression_type_ = compression_type;
+    }
+  }
+
   int send_msg_timeout() const override { return send_msg_timeout_; }
   void set_send_msg_timeout(int send_msg_timeout) override { send_msg_timeout_ = send_msg_timeout; }
 
@@ -83,6 +92,7 @@ class DefaultMQProducerConfigImpl : virtual public DefaultMQProducerConfig, publ
   int max_message_size_;                // default: 4 MB
   int compress_msg_body_over_howmuch_;  // default: 4 KB
   int compress_level_;
+  CompressionType compression_type_;  // default: ZLIB
   int send_msg_timeout_;
   int retry_times_;
   int retry_times_for_async_;
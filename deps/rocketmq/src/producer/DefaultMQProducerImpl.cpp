@@ -26,6 +26,7 @@
 
 #include "ClientErrorCode.h"
 #include "CommunicationMode.h"
+#include "CompressionCodec.h"
 #include "CorrelationIdUtil.hpp"
 #include "Logging.h"
 #include "MQClientAPIImpl.h"
@@ -725,6 +726,8 @@ SendResult* DefaultMQProducerImpl::sendKernelImpl(MessagePtr msg,
       bool msgBodyCompressed = false;
       if (tryToCompressMessage(*msg)) {
         sysFlag |= MessageSysFlag::COMPRESSED_FLAG;
+        sysFlag |= MessageSysFlag::compressionFlag(
+            dynamic_cast<DefaultMQProducerConfig*>(client_config_.get())->compression_type());
         msgBodyCompressed = true;
       }
 
@@ -801,21 +804,27 @@ SendResult* DefaultMQProducerImpl::sendKernelImpl(MessagePtr msg,
 }
 
 bool DefaultMQProducerImpl::tryToCompressMessage(Message& msg) {
-  if (msg.isBatch()) {
-    // batch dose not support compressing right now
-    return false;
-  }
-
   // already compressed
   if (UtilAll::stob(msg.getProperty(MQMessageConst::PROPERTY_ALREADY_COMPRESSED_FLAG))) {
     return true;
   }
 
+  auto* producerConfig = dynamic_cast<DefaultMQProducerConfig*>(client_config_.get());
   const auto& body = msg.body();
-  if (body.size() >= dynamic_cast<DefaultMQProducerConfig*>(client_config_.get())->compress_msg_body_over_howmuch()) {
+  if (body.size() >= producerConfig->compress_msg_body_over_howmuch()) {
+    const auto* codec = CompressionCodec::of(producerConfig->compression_type());
+    if (msg.isBatch()) {
+      // the encoded batch is over the threshold, its inner messages are compressed together
+      auto* batch = dynamic_cast<MessageBatch*>(&msg);
+      if (codec != nullptr && batch != nullptr && batch->compress(*codec, producerConfig->compress_level())) {
+        msg.putProperty(MQMessageConst::PROPERTY_ALREADY_COMPRESSED_FLAG, "true");
+        return true;
+      }
+      return false;
+    }
+
     std::string out_body;
-    if (UtilAll::deflate(body, out_body,
-                         dynamic_cast<DefaultMQProducerConfig*>(client_config_.get())->compress_level())) {
+    if (codec != nullptr && codec->compress(body.data(), body.size(), producerConfig->compress_level(), out_body)) {
       msg.set_body(std::move(out_body));
       msg.putProperty(MQMessageConst::PROPERTY_ALREADY_COMPRESSED_FLAG, "true");
       return true;
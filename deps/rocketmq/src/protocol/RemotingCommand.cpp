@@ -27,6 +27,7 @@
 #include "Logging.h"
 #include "MQVersion.h"
 #include "RemotingSerializable.h"
+#include "UtilAll.h"
 
 namespace rocketmq {
 
@@ -64,6 +65,7 @@ RemotingCommand::RemotingCommand(int32_t code,
       opaque_(opaque),
       flag_(flag),
       remark_(remark),
+      serialize_type_(SerializeType::JSON),
       custom_header_(customHeader) {}
 
 RemotingCommand::RemotingCommand(RemotingCommand&& command) {
@@ -74,13 +76,47 @@ RemotingCommand::RemotingCommand(RemotingCommand&& command) {
   flag_ = command.flag_;
   remark_ = std::move(command.remark_);
   ext_fields_ = std::move(command.ext_fields_);
+  serialize_type_ = command.serialize_type_;
   custom_header_ = std::move(command.custom_header_);
   body_ = std::move(command.body_);
 }
 
 RemotingCommand::~RemotingCommand() = default;
 
-ByteArrayRef RemotingCommand::encode() const {
+// LanguageCode of RocketMQSerializable, indexed by code
+static const char* const kLanguageNames[] = {"JAVA",   "CPP",   "DOTNET", "PYTHON", "DELPHI", "ERLANG",
+                                             "RUBY",   "OTHER", "HTTP",   "GO",     "PHP",    "OMS"};
+static const int8_t kLanguageOther = 7;
+
+static int8_t getLanguageCode(const std::string& language) {
+  for (int8_t i = 0; i < (int8_t)(sizeof(kLanguageNames) / sizeof(kLanguageNames[0])); i++) {
+    if (language == kLanguageNames[i]) {
+      return i;
+    }
+  }
+  return kLanguageOther;
+}
+
+static const char* getLanguageName(int8_t code) {
+  if (code < 0 || code >= (int8_t)(sizeof(kLanguageNames) / sizeof(kLanguageNames[0]))) {
+    code = kLanguageOther;
+  }
+  return kLanguageNames[code];
+}
+
+template <typename T>
+static inline char* writeBigEndian(char* out, T value) {
+  auto raw = ByteOrderUtil::NorminalBigEndian(value);
+  std::memcpy(out, &raw, sizeof(raw));
+  return out + sizeof(raw);
+}
+
+static inline char* writeBytes(char* out, const std::string& value) {
+  std::memcpy(out, value.data(), value.size());
+  return out + value.size();
+}
+
+std::string RemotingCommand::jsonHeaderEncode() const {
   Json::Value root;
   root["code"] = code_;
   root["language"] = language_;
@@ -99,59 +135,91 @@ ByteArrayRef RemotingCommand::encode() const {
   }
   root["extFields"] = ext_fields;
 
+  return RemotingSerializable::toJson(root);
+}
+
+void RemotingCommand::rocketmqHeaderFields(std::map<std::string, std::string>& fields) const {
+  // customHeader has priority over extFields, same as JSON
+  if (custom_header_ != nullptr) {
+    custom_header_->SetDeclaredFieldOfCommandHeader(fields);
+  }
+  fields.insert(ext_fields_.begin(), ext_fields_.end());
+}
+
+ByteArrayRef RemotingCommand::encode() const {
+  return encodePackage(true);
+}
+
+ByteArrayRef RemotingCommand::encodeHeader() const {
+  return encodePackage(false);
+}
+
+ByteArrayRef RemotingCommand::encodePackage(bool withBody) const {
   // serialize header
-  std::string header = RemotingSerializable::toJson(root);
-
-  // 1> header length size
-  uint32_t length = 4;
-  // 2> header data length
-  length += header.size();
-  // 3> body data length
-  if (body_ != nullptr) {
-    length += body_->size();
+  std::string jsonHeader;
+  std::map<std::string, std::string> fields;
+  size_t extLength = 0;
+  size_t headerLength;
+  if (serialize_type_ == SerializeType::ROCKETMQ) {
+    rocketmqHeaderFields(fields);
+    for (const auto& it : fields) {
+      extLength += 6 + it.first.size() + it.second.size();
+    }
+    // code(2) + language(1) + version(2) + opaque(4) + flag(4) + remark(4 + n) + extFields(4 + n)
+    headerLength = 21 + remark_.size() + extLength;
+  } else {
+    jsonHeader = jsonHeaderEncode();
+    headerLength = jsonHeader.size();
   }
+  size_t bodyLength = body_ != nullptr ? body_->size() : 0;
+
+  // 1> header length size + 2> header data length + 3> body data length
+  uint32_t length = 4 + headerLength + bodyLength;
 
-  std::unique_ptr<ByteBuffer> result(ByteBuffer::allocate(4 + length));
+  // only one allocation, header is written in place
+  auto package = std::make_shared<ByteArray>(4 + 4 + headerLength + (withBody ? bodyLength : 0));
+  char* cursor = package->array();
 
   // length
-  result->putInt(length);
-  // header length
-  result->putInt((uint32_t)header.size());
+  cursor = writeBigEndian(cursor, length);
+  // header length, high byte is serialize type
+  cursor = writeBigEndian(cursor, ((uint32_t)serialize_type_ << 24) | ((uint32_t)headerLength & 0x00FFFFFF));
   // header data
-  result->put(ByteArray((char*)header.data(), header.size()));
-  // body data;
-  if (body_ != nullptr) {
-    result->put(*body_);
+  if (serialize_type_ == SerializeType::ROCKETMQ) {
+    cursor = writeBigEndian(cursor, (int16_t)code_);
+    *cursor++ = (char)getLanguageCode(language_);
+    cursor = writeBigEndian(cursor, (int16_t)version_);
+    cursor = writeBigEndian(cursor, opaque_);
+    cursor = writeBigEndian(cursor, flag_);
+    cursor = writeBigEndian(cursor, (int32_t)remark_.size());
+    cursor = writeBytes(cursor, remark_);
+    cursor = writeBigEndian(cursor, (int32_t)extLength);
+    for (const auto& it : fields) {
+      cursor = writeBigEndian(cursor, (int16_t)it.first.size());
+      cursor = writeBytes(cursor, it.first);
+      cursor = writeBigEndian(cursor, (int32_t)it.second.size());
+      cursor = writeBytes(cursor, it.second);
+    }
+  } else {
+    cursor = writeBytes(cursor, jsonHeader);
+  }
+  // body data
+  if (withBody && bodyLength > 0) {
+    std::memcpy(cursor, body_->array(), bodyLength);
   }
 
-  // result->flip();
-
-  return result->byte_array();
+  return package;
 }
 
 static inline int32_t getHeaderLength(int32_t length) {
   return length & 0x00FFFFFF;
 }
 
-static RemotingCommand* Decode(ByteBuffer& byteBuffer, bool hasPackageLength) {
-  // decode package: [4 bytes(packageLength) +] 4 bytes(headerLength) + header + body
-
-  int32_t length = byteBuffer.limit();
-  if (hasPackageLength) {
-    // skip package length
-    (void)byteBuffer.getInt();
-    length -= 4;
-  }
-
-  // decode header
-
-  int32_t oriHeaderLen = byteBuffer.getInt();
-  int32_t headerLength = getHeaderLength(oriHeaderLen);
-
-  // temporary ByteArray
-  ByteArray headerData(byteBuffer.array() + byteBuffer.arrayOffset() + byteBuffer.position(), headerLength);
-  byteBuffer.position(byteBuffer.position() + headerLength);
+static inline SerializeType getProtocolType(int32_t length) {
+  return static_cast<SerializeType>((length >> 24) & 0xFF);
+}
 
+static RemotingCommand* jsonHeaderDecode(const ByteArray& headerData) {
   Json::Value object;
   try {
     object = RemotingSerializable::fromJson(headerData);
@@ -182,6 +250,96 @@ static RemotingCommand* Decode(ByteBuffer& byteBuffer, bool hasPackageLength) {
     }
   }
 
+  return cmd.release();
+}
+
+static RemotingCommand* rocketmqHeaderDecode(const ByteArray& headerData) {
+  const char* cursor = headerData.array();
+  const char* const end = cursor + headerData.size();
+
+  auto require = [&](size_t n) {
+    if ((size_t)(end - cursor) < n) {
+      THROW_MQEXCEPTION(MQClientException, "conn't parse rocketmq header", -1);
+    }
+  };
+  auto readShort = [&]() -> int16_t {
+    require(2);
+    auto value = (int16_t)ByteOrderUtil::NorminalBigEndian(ByteOrderUtil::Read<int16_t>(cursor));
+    cursor += 2;
+    return value;
+  };
+  auto readInt = [&]() -> int32_t {
+    require(4);
+    auto value = (int32_t)ByteOrderUtil::NorminalBigEndian(ByteOrderUtil::Read<int32_t>(cursor));
+    cursor += 4;
+    return value;
+  };
+  auto readString = [&](int32_t length) -> std::string {
+    if (length < 0) {
+      THROW_MQEXCEPTION(MQClientException, "conn't parse rocketmq header", -1);
+    }
+    require(length);
+    std::string value(cursor, length);
+    cursor += length;
+    return value;
+  };
+
+  int32_t code = readShort();
+  require(1);
+  std::string language = getLanguageName((int8_t)*cursor++);
+  int32_t version = readShort();
+  int32_t opaque = readInt();
+  int32_t flag = readInt();
+  std::string remark = readString(readInt());
+
+  std::unique_ptr<RemotingCommand> cmd(new RemotingCommand(code, language, version, opaque, flag, remark, nullptr));
+
+  int32_t extLength = readInt();
+  require(extLength);
+  const char* const extEnd = cursor + extLength;
+  while (cursor < extEnd) {
+    std::string name = readString((uint16_t)readShort());
+    std::string value = readString(readInt());
+    cmd->set_ext_field(name, value);
+  }
+
+  return cmd.release();
+}
+
+static RemotingCommand* Decode(ByteBuffer& byteBuffer, bool hasPackageLength) {
+  // decode package: [4 bytes(packageLength) +] 4 bytes(headerLength) + header + body
+
+  int32_t length = byteBuffer.limit();
+  if (hasPackageLength) {
+    // skip package length
+    (void)byteBuffer.getInt();
+    length -= 4;
+  }
+
+  // decode header
+
+  int32_t oriHeaderLen = byteBuffer.getInt();
+  int32_t headerLength = getHeaderLength(oriHeaderLen);
+  auto serializeType = getProtocolType(oriHeaderLen);
+
+  // temporary ByteArray
+  ByteArray headerData(byteBuffer.array() + byteBuffer.arrayOffset() + byteBuffer.position(), headerLength);
+  byteBuffer.position(byteBuffer.position() + headerLength);
+
+  std::unique_ptr<RemotingCommand> cmd;
+  switch (serializeType) {
+    case SerializeType::JSON:
+      cmd.reset(jsonHeaderDecode(headerData));
+      break;
+    case SerializeType::ROCKETMQ:
+      cmd.reset(rocketmqHeaderDecode(headerData));
+      break;
+    default:
+      THROW_MQEXCEPTION(MQClientException, "unsupported serialize type: " + UtilAll::to_string((int)serializeType),
+                        -1);
+  }
+  cmd->set_serialize_type(serializeType);
+
   // decode body
 
   int32_t bodyLength = length - 4 - headerLength;
@@ -193,8 +351,8 @@ static RemotingCommand* Decode(ByteBuffer& byteBuffer, bool hasPackageLength) {
     cmd->set_body(std::move(bodyData));
   }
 
-  LOG_DEBUG_NEW("code:{}, language:{}, version:{}, opaque:{}, flag:{}, remark:{}, headLen:{}, bodyLen:{}", code,
-                language, version, opaque, flag, remark, headerLength, bodyLength);
+  LOG_DEBUG_NEW("code:{}, language:{}, version:{}, opaque:{}, flag:{}, remark:{}, headLen:{}, bodyLen:{}", cmd->code(),
+                cmd->language(), cmd->version(), cmd->opaque(), cmd->flag(), cmd->remark(), headerLength, bodyLength);
 
   return cmd.release();
 }
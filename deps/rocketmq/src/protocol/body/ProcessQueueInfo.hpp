@@ -30,6 +30,7 @@ class ProcessQueueInfo {
         cachedMsgMinOffset(0),
         cachedMsgMaxOffset(0),
         cachedMsgCount(0),
+        cachedMsgSizeInMiB(0),
         transactionMsgMinOffset(0),
         transactionMsgMaxOffset(0),
         transactionMsgCount(0),
@@ -61,6 +62,7 @@ class ProcessQueueInfo {
     outJson["cachedMsgMinOffset"] = UtilAll::to_string(cachedMsgMinOffset);
     outJson["cachedMsgMaxOffset"] = UtilAll::to_string(cachedMsgMaxOffset);
     outJson["cachedMsgCount"] = cachedMsgCount;
+    outJson["cachedMsgSizeInMiB"] = cachedMsgSizeInMiB;
     outJson["transactionMsgMinOffset"] = UtilAll::to_string(transactionMsgMinOffset);
     outJson["transactionMsgMaxOffset"] = UtilAll::to_string(transactionMsgMaxOffset);
     outJson["transactionMsgCount"] = transactionMsgCount;
@@ -78,6 +80,7 @@ class ProcessQueueInfo {
   uint64_t cachedMsgMinOffset;
   uint64_t cachedMsgMaxOffset;
   int32_t cachedMsgCount;
+  int32_t cachedMsgSizeInMiB;
   uint64_t transactionMsgMinOffset;
   uint64_t transactionMsgMaxOffset;
   int32_t transactionMsgCount;
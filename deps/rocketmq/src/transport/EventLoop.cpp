@@ -227,6 +227,28 @@ int BufferEvent::connect(const std::string& addr) {
   }
 }
 
+static void release_byte_array(const void* data, size_t datalen, void* extra) {
+  delete static_cast<ByteArrayRef*>(extra);
+}
+
+int BufferEvent::write(const ByteArray& header, ByteArrayRef body) {
+  // hold the lock so that other writers can't interleave between header and body
+  bufferevent_lock(buffer_event_);
+  struct evbuffer* output = bufferevent_get_output(buffer_event_);
+  int ret = evbuffer_add(output, header.array(), header.size());
+  if (ret == 0 && body != nullptr && body->size() > 0) {
+    // body keeps alive until libevent has sent it
+    auto* holder = new ByteArrayRef(body);
+    ret = evbuffer_add_reference(output, body->array(), body->size(), release_byte_array, holder);
+    if (ret != 0) {
+      delete holder;
+      ret = evbuffer_add(output, body->array(), body->size());
+    }
+  }
+  bufferevent_unlock(buffer_event_);
+  return ret;
+}
+
 void BufferEvent::close() {
   if (buffer_event_ != nullptr) {
     bufferevent_free(buffer_event_);
@@ -25,6 +25,7 @@
 #include <functional>  // std::function
 #include <memory>      // std::unique_ptr
 
+#include "ByteArray.h"
 #include "concurrent/thread.hpp"
 #include "noncopyable.h"
 
@@ -87,6 +88,9 @@ class BufferEvent : public noncopyable {
 
   inline int write(const void* data, size_t size) { return bufferevent_write(buffer_event_, data, size); }
 
+  // copy header and append body by reference, both are queued atomically
+  int write(const ByteArray& header, ByteArrayRef body);
+
   inline size_t read(void* data, size_t size) { return bufferevent_read(buffer_event_, data, size); }
 
   inline struct evbuffer* getInput() { return bufferevent_get_input(buffer_event_); }
@@ -88,9 +88,11 @@ class ResponseFutureInfo : public TcpTransportInfo {
 
 TcpRemotingClient::TcpRemotingClient(int workerThreadNum,
                                      uint64_t tcpConnectTimeout,
-                                     uint64_t tcpTransportTryLockTimeout)
+                                     uint64_t tcpTransportTryLockTimeout,
+                                     SerializeType serializeType)
     : tcp_connect_timeout_(tcpConnectTimeout),
       tcp_transport_try_lock_timeout_(tcpTransportTryLockTimeout),
+      serialize_type_(serializeType),
       namesrv_index_(0),
       dispatch_executor_("MessageDispatchExecutor", 1, false),
       handle_executor_("MessageHandleExecutor", workerThreadNum, false),
@@ -249,6 +251,7 @@ std::unique_ptr<RemotingCommand> TcpRemotingClient::invokeSync(const std::string
 std::unique_ptr<RemotingCommand> TcpRemotingClient::invokeSyncImpl(TcpTransportPtr channel,
                                                                    RemotingCommand& request,
                                                                    int64_t timeoutMillis) {
+  request.set_serialize_type(serialize_type_);
   int code = request.code();
   int opaque = request.opaque();
 
@@ -305,6 +308,7 @@ void TcpRemotingClient::invokeAsyncImpl(TcpTransportPtr channel,
                                         RemotingCommand& request,
                                         int64_t timeoutMillis,
                                         std::unique_ptr<InvokeCallback>& invokeCallback) {
+  request.set_serialize_type(serialize_type_);
   int code = request.code();
   int opaque = request.opaque();
 
@@ -346,6 +350,7 @@ void TcpRemotingClient::invokeOneway(const std::string& addr, RemotingCommand& r
 
 void TcpRemotingClient::invokeOnewayImpl(TcpTransportPtr channel, RemotingCommand& request) {
   request.markOnewayRPC();
+  request.set_serialize_type(serialize_type_);
   try {
     if (!SendCommand(channel, request)) {
       LOG_WARN_NEW("send a request command to channel <{}> failed.", channel->getPeerAddrAndPort());
@@ -548,8 +553,8 @@ bool TcpRemotingClient::CloseNameServerTransport(TcpTransportPtr channel) {
 }
 
 bool TcpRemotingClient::SendCommand(TcpTransportPtr channel, RemotingCommand& msg) noexcept {
-  auto package = msg.encode();
-  return channel->sendMessage(package->array(), package->size());
+  // body is referenced by the socket buffer instead of being copied into the package
+  return channel->sendMessage(msg.encodeHeader(), msg.body());
 }
 
 void TcpRemotingClient::channelClosed(TcpTransportPtr channel) {
@@ -656,6 +661,8 @@ void TcpRemotingClient::processRequestCommand(std::unique_ptr<RemotingCommand> r
   if (!requestCommand->isOnewayRPC() && response != nullptr) {
     response->set_opaque(requestCommand->opaque());
     response->markResponseType();
+    // answer in the same encoding as the request
+    response->set_serialize_type(requestCommand->serialize_type());
     try {
       if (!SendCommand(channel, *response)) {
         LOG_WARN_NEW("send a response command to channel <{}> failed.", channel->getPeerAddrAndPort());
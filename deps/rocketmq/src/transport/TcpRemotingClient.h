@@ -36,7 +36,10 @@ namespace rocketmq {
 
 class TcpRemotingClient {
  public:
-  TcpRemotingClient(int workerThreadNum, uint64_t tcpConnectTimeout, uint64_t tcpTransportTryLockTimeout);
+  TcpRemotingClient(int workerThreadNum,
+                    uint64_t tcpConnectTimeout,
+                    uint64_t tcpTransportTryLockTimeout,
+                    SerializeType serializeType = SerializeType::JSON);
   virtual ~TcpRemotingClient();
 
   void start();
@@ -114,6 +117,8 @@ class TcpRemotingClient {
   uint64_t tcp_connect_timeout_;             // ms
   uint64_t tcp_transport_try_lock_timeout_;  // s
 
+  SerializeType serialize_type_;  // header encoding of outgoing requests
+
   // NameServer
   std::timed_mutex namesrv_lock_;
   std::vector<std::string> namesrv_addr_list_;
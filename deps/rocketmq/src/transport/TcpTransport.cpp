@@ -267,6 +267,14 @@ bool TcpTransport::sendMessage(const char* data, size_t len) {
   return event_ != nullptr && event_->write(data, len) == 0;
 }
 
+bool TcpTransport::sendMessage(ByteArrayRef header, ByteArrayRef body) {
+  if (getTcpConnectStatus() != TCP_CONNECT_STATUS_CONNECTED) {
+    return false;
+  }
+
+  return event_ != nullptr && event_->write(*header, std::move(body)) == 0;
+}
+
 const std::string& TcpTransport::getPeerAddrAndPort() {
   return event_ != nullptr ? event_->getPeerAddrPort() : null;
 }
@@ -63,6 +63,7 @@ class TcpTransport : public noncopyable, public std::enable_shared_from_this<Tcp
   TcpConnectStatus getTcpConnectStatus();
 
   bool sendMessage(const char* pData, size_t len);
+  bool sendMessage(ByteArrayRef header, ByteArrayRef body);
   const std::string& getPeerAddrAndPort();
   const uint64_t getStartTime() const;
 
@@ -45,6 +45,14 @@ TEST(MQClientConfigImplTest, TryLockTimeoutRoundsDownToSecondsWithFloor) {
   EXPECT_EQ(2u, config.tcp_transport_try_lock_timeout());
 }
 
+TEST(MQClientConfigImplTest, SerializeTypeDefaultsToJson) {
+  MQClientConfigImpl config;
+  EXPECT_EQ(rocketmq::SerializeType::JSON, config.serialize_type());
+
+  config.set_serialize_type(rocketmq::SerializeType::ROCKETMQ);
+  EXPECT_EQ(rocketmq::SerializeType::ROCKETMQ, config.serialize_type());
+}
+
 TEST(MQClientConfigImplTest, ChangeInstanceNameUsesPidOnce) {
   MQClientConfigImpl config;
   config.changeInstanceNameToPID();
@@ -138,6 +138,19 @@ TEST(ClientRPCHookTest, BodyAffectsSignatureAndSkipWhenNotSending) {
   EXPECT_TRUE(ExtractSignature(unsent).empty());
 }
 
+TEST(ClientRPCHookTest, SignatureIsHmacSha1OfHeadersAndBody) {
+  SessionCredentials credentials("ak", "sk", "chan");
+  ClientRPCHook hook(credentials);
+
+  std::string body(100000, 'b');
+  RemotingCommand command(MQRequestCode::SEND_MESSAGE, new RecordingHeader("Declared"));
+  command.set_body(body);
+  hook.doBeforeRequest("remote", command, true);
+
+  // base64(HmacSHA1("sk", "ak" + "Declared" + "chan" + body)), header values are ordered by key
+  EXPECT_EQ("XALecWfkxuZMejvZGOLzanuegSU=", ExtractSignature(command));
+}
+
 TEST(ClientRPCHookTest, SignsResponsesOnlyWhenProvided) {
   SessionCredentials credentials("ak", "sk", "chan");
   ClientRPCHook hook(credentials);
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "CompressionCodec.h"
+#include "UtilAll.h"
+
+using rocketmq::CompressionCodec;
+using rocketmq::CompressionType;
+using rocketmq::UtilAll;
+
+static std::string MakePayload(size_t size) {
+  std::string payload;
+  payload.reserve(size);
+  while (payload.size() < size) {
+    payload.append("{\"id\":");
+    payload.append(std::to_string(payload.size()));
+    payload.append(",\"name\":\"rocketmq\"},");
+  }
+  payload.resize(size);
+  return payload;
+}
+
+TEST(CompressionCodecTest, ZlibRoundTrip) {
+  const auto* codec = CompressionCodec::of(CompressionType::ZLIB);
+  ASSERT_NE(nullptr, codec);
+  EXPECT_EQ(CompressionType::ZLIB, codec->type());
+
+  // large enough that inflate has to grow its first guess of the output size
+  const std::string payload = MakePayload(256 * 1024);
+  std::string compressed;
+  ASSERT_TRUE(codec->compress(payload.data(), payload.size(), 5, compressed));
+  EXPECT_LT(compressed.size(), payload.size() / 4);
+
+  std::string restored = "stale";
+  ASSERT_TRUE(codec->uncompress(compressed.data(), compressed.size(), restored));
+  EXPECT_EQ(payload, restored);
+
+  // the thread local contexts are reset between calls, also when the level changes
+  std::string again;
+  ASSERT_TRUE(codec->compress(payload.data(), payload.size(), 1, again));
+  ASSERT_TRUE(codec->uncompress(again.data(), again.size(), restored));
+  EXPECT_EQ(payload, restored);
+}
+
+TEST(CompressionCodecTest, ZlibMatchesUtilAll) {
+  const std::string payload = MakePayload(10000);
+  std::string compressed;
+  ASSERT_TRUE(UtilAll::deflate(payload, compressed, 5));
+
+  std::string restored;
+  ASSERT_TRUE(CompressionCodec::of(CompressionType::ZLIB)->uncompress(compressed.data(), compressed.size(), restored));
+  EXPECT_EQ(payload, restored);
+}
+
+TEST(CompressionCodecTest, RejectsBrokenInput) {
+  const auto* codec = CompressionCodec::of(CompressionType::ZLIB);
+  const std::string payload = MakePayload(10000);
+  std::string compressed;
+  ASSERT_TRUE(codec->compress(payload.data(), payload.size(), 5, compressed));
+
+  std::string restored;
+  EXPECT_FALSE(codec->uncompress(compressed.data(), compressed.size() / 2, restored));
+  EXPECT_FALSE(codec->uncompress(payload.data(), payload.size(), restored));
+}
+
+TEST(CompressionCodecTest, OptionalCodecs) {
+#ifdef ROCKETMQ_WITH_ZSTD
+  ASSERT_NE(nullptr, CompressionCodec::of(CompressionType::ZSTD));
+#else
+  EXPECT_EQ(nullptr, CompressionCodec::of(CompressionType::ZSTD));
+#endif
+#ifdef ROCKETMQ_WITH_LZ4
+  ASSERT_NE(nullptr, CompressionCodec::of(CompressionType::LZ4));
+#else
+  EXPECT_EQ(nullptr, CompressionCodec::of(CompressionType::LZ4));
+#endif
+
+  const std::string payload = MakePayload(100 * 1024);
+  for (auto type : {CompressionType::ZSTD, CompressionType::LZ4}) {
+    const auto* codec = CompressionCodec::of(type);
+    if (codec == nullptr) {
+      continue;
+    }
+    std::string compressed;
+    ASSERT_TRUE(codec->compress(payload.data(), payload.size(), 3, compressed));
+    std::string restored;
+    ASSERT_TRUE(codec->uncompress(compressed.data(), compressed.size(), restored));
+    EXPECT_EQ(payload, restored);
+  }
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  testing::GTEST_FLAG(throw_on_failure) = true;
+  testing::GTEST_FLAG(filter) = "CompressionCodecTest.*";
+  return RUN_ALL_TESTS();
+}
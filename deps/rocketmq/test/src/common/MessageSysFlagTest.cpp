@@ -2,6 +2,7 @@
 
 #include "MessageSysFlag.h"
 
+using rocketmq::CompressionType;
 using rocketmq::MessageSysFlag;
 
 TEST(MessageSysFlagTest, TransactionValuesRoundTrip) {
@@ -19,6 +20,16 @@ TEST(MessageSysFlagTest, ClearCompressedFlag) {
   EXPECT_EQ(MessageSysFlag::BORNHOST_V6_FLAG, cleared);
 }
 
+TEST(MessageSysFlagTest, CompressionType) {
+  EXPECT_EQ(CompressionType::ZLIB, MessageSysFlag::getCompressionType(MessageSysFlag::COMPRESSED_FLAG));
+
+  int flag = MessageSysFlag::COMPRESSED_FLAG | MessageSysFlag::compressionFlag(CompressionType::ZSTD);
+  EXPECT_EQ(MessageSysFlag::COMPRESSED_FLAG | MessageSysFlag::COMPRESSION_ZSTD_TYPE, flag);
+  EXPECT_EQ(CompressionType::ZSTD, MessageSysFlag::getCompressionType(flag));
+  EXPECT_EQ(CompressionType::LZ4, MessageSysFlag::getCompressionType(MessageSysFlag::COMPRESSION_LZ4_TYPE));
+  EXPECT_EQ(CompressionType::ZLIB, MessageSysFlag::getCompressionType(MessageSysFlag::COMPRESSION_ZLIB_TYPE));
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   testing::GTEST_FLAG(throw_on_failure) = true;
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include "concurrent/executor.hpp"
+
+using rocketmq::sharded_thread_pool_executor;
+
+TEST(ShardedThreadPoolExecutorTest, IdleThreadStealsFromBusyLane) {
+  sharded_thread_pool_executor executor("ShardedTest", 2);
+
+  std::promise<void> release;
+  auto released = release.get_future().share();
+  auto blocking = executor.submit(0, [released]() { released.wait(); });
+
+  // queued behind the blocking task on lane 0, so it can only finish by being stolen
+  auto stolen = executor.submit(2, []() {});
+  EXPECT_EQ(std::future_status::ready, stolen.wait_for(std::chrono::seconds(3)));
+
+  release.set_value();
+  blocking.get();
+  executor.shutdown();
+}
+
+TEST(ShardedThreadPoolExecutorTest, RunsEveryTaskFromConcurrentProducers) {
+  sharded_thread_pool_executor executor("ShardedTest", 4);
+
+  std::atomic<int> executed(0);
+  std::vector<std::thread> producers;
+  for (int p = 0; p < 4; p++) {
+    producers.emplace_back([&executor, &executed, p]() {
+      for (int i = 0; i < 1000; i++) {
+        executor.submit(p * 1000 + i, [&executed]() { executed++; });
+      }
+    });
+  }
+  for (auto& producer : producers) {
+    producer.join();
+  }
+  executor.shutdown(false);
+
+  EXPECT_EQ(4000, executed.load());
+}
+
+TEST(ShardedThreadPoolExecutorTest, RejectsTasksAfterShutdown) {
+  sharded_thread_pool_executor executor("ShardedTest", 2, false);
+  EXPECT_TRUE(executor.is_shutdown());
+  EXPECT_THROW(executor.submit([]() {}).get(), std::logic_error);
+
+  executor.startup();
+  executor.submit([]() {}).get();
+  executor.shutdown();
+  EXPECT_THROW(executor.submit(1, []() {}).get(), std::logic_error);
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  testing::GTEST_FLAG(throw_on_failure) = true;
+  testing::GTEST_FLAG(filter) = "ShardedThreadPoolExecutorTest.*";
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "concurrent/weighted_blocking_queue.hpp"
+
+using rocketmq::weighted_blocking_queue;
+
+namespace {
+
+struct Request {
+  int id;
+  bool dropped;
+};
+
+std::vector<int> Ids(const std::vector<std::unique_ptr<Request>>& batch) {
+  std::vector<int> ids;
+  for (const auto& request : batch) {
+    ids.push_back(request->id);
+  }
+  return ids;
+}
+
+bool Dropped(Request& request) {
+  return request.dropped;
+}
+
+}  // namespace
+
+TEST(WeightedBlockingQueueTest, FullWhenCountOrBytesReachCapacity) {
+  weighted_blocking_queue<Request> queue;
+  queue.set_capacity(10, 100);
+  EXPECT_FALSE(queue.full());
+
+  queue.push_back(new Request{1, false}, 5, 40);
+  EXPECT_FALSE(queue.full());
+  queue.push_back(new Request{2, false}, 5, 40);
+  EXPECT_TRUE(queue.full());
+  EXPECT_EQ(10, queue.count());
+  EXPECT_EQ(80, queue.bytes());
+
+  queue.drain(0, rocketmq::milliseconds, 5, 0, Dropped);
+  EXPECT_FALSE(queue.full());
+
+  queue.push_back(new Request{3, false}, 1, 60);
+  EXPECT_TRUE(queue.full());
+
+  queue.set_capacity(0, 0);
+  EXPECT_FALSE(queue.full());
+}
+
+TEST(WeightedBlockingQueueTest, DrainTakesSeveralElementsWithinBudget) {
+  weighted_blocking_queue<Request> queue;
+  for (int i = 0; i < 5; i++) {
+    queue.push_back(new Request{i, false}, 10, 100);
+  }
+
+  EXPECT_EQ((std::vector<int>{0, 1, 2}), Ids(queue.drain(0, rocketmq::milliseconds, 30, 0, Dropped)));
+  EXPECT_EQ((std::vector<int>{3}), Ids(queue.drain(0, rocketmq::milliseconds, 0, 150, Dropped)));
+  EXPECT_EQ(1u, queue.size());
+  EXPECT_EQ(10, queue.count());
+  EXPECT_EQ(100, queue.bytes());
+
+  // an element heavier than the budget is still returned on its own
+  EXPECT_EQ((std::vector<int>{4}), Ids(queue.drain(0, rocketmq::milliseconds, 1, 1, Dropped)));
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(0, queue.bytes());
+}
+
+TEST(WeightedBlockingQueueTest, DrainSkipsDiscardedElements) {
+  weighted_blocking_queue<Request> queue;
+  queue.push_back(new Request{1, true}, 1, 1);
+  queue.push_back(new Request{2, false}, 1, 1);
+  queue.push_back(new Request{3, true}, 1, 1);
+  queue.push_back(new Request{4, false}, 1, 1);
+
+  EXPECT_EQ((std::vector<int>{2, 4}), Ids(queue.drain(0, rocketmq::milliseconds, 0, 0, Dropped)));
+  EXPECT_EQ(0, queue.count());
+
+  queue.push_back(new Request{5, true}, 1, 1);
+  EXPECT_TRUE(queue.drain(10, rocketmq::milliseconds, 0, 0, Dropped).empty());
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(WeightedBlockingQueueTest, DrainWaitsForProducer) {
+  weighted_blocking_queue<Request> queue;
+  std::thread producer([&queue] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    queue.push_back(new Request{7, false}, 1, 1);
+  });
+
+  EXPECT_EQ((std::vector<int>{7}), Ids(queue.drain(5000, rocketmq::milliseconds, 0, 0, Dropped)));
+  producer.join();
+
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_TRUE(queue.drain(30, rocketmq::milliseconds, 0, 0, Dropped).empty());
+  EXPECT_GE(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count(),
+            25);
+}
+
+TEST(WeightedBlockingQueueTest, RemoveIfReleasesWeight) {
+  weighted_blocking_queue<Request> queue;
+  queue.push_back(new Request{1, false}, 2, 20);
+  queue.push_back(new Request{2, false}, 3, 30);
+
+  EXPECT_EQ(1u, queue.remove_if([](Request& request) { return request.id == 1; }));
+  EXPECT_EQ(3, queue.count());
+  EXPECT_EQ(30, queue.bytes());
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  testing::GTEST_FLAG(throw_on_failure) = true;
+  testing::GTEST_FLAG(filter) = "WeightedBlockingQueueTest.*";
+  return RUN_ALL_TESTS();
+}
@@ -64,6 +64,23 @@ TEST(AssignedMessageQueueTest, TracksOffsetsAndSeekValues) {
   EXPECT_EQ(50, assigned.getSeekOffset(queue));
 }
 
+TEST(AssignedMessageQueueTest, SeekBumpsGenerationButClearingDoesNot) {
+  AssignedMessageQueue assigned;
+  auto queues = MakeQueues(1);
+  assigned.updateAssignedMessageQueue("Topic", queues);
+  const auto& queue = queues[0];
+
+  EXPECT_EQ(0, assigned.getSeekGeneration(queue));
+  assigned.setSeekOffset(queue, 50);
+  EXPECT_EQ(1, assigned.getSeekGeneration(queue));
+  assigned.setSeekOffset(queue, -1);
+  EXPECT_EQ(1, assigned.getSeekGeneration(queue));
+  assigned.setSeekOffset(queue, 0);
+  EXPECT_EQ(2, assigned.getSeekGeneration(queue));
+
+  EXPECT_EQ(-1, assigned.getSeekGeneration(MQMessageQueue("Other", "BrokerA", 0)));
+}
+
 TEST(AssignedMessageQueueTest, UpdateAssignedRemovesStaleQueues) {
   AssignedMessageQueue assigned;
   auto queues = MakeQueues(2);
@@ -79,6 +96,21 @@ TEST(AssignedMessageQueueTest, UpdateAssignedRemovesStaleQueues) {
   EXPECT_TRUE(assigned.isPaused(queues[0]));
 }
 
+TEST(AssignedMessageQueueTest, AssignReplacesQueuesOfAllTopics) {
+  AssignedMessageQueue assigned;
+  auto queues = MakeQueues(2);
+  auto others = MakeQueues(1, "Other");
+  assigned.updateAssignedMessageQueue("Topic", queues);
+  assigned.updateAssignedMessageQueue("Other", others);
+
+  std::vector<MQMessageQueue> assignment = {queues[1]};
+  assigned.updateAssignedMessageQueue(assignment);
+
+  auto snapshot = assigned.messageQueues();
+  ASSERT_EQ(1u, snapshot.size());
+  EXPECT_EQ(queues[1], snapshot[0]);
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   testing::GTEST_FLAG(throw_on_failure) = true;
@@ -1,7 +1,10 @@
 #include <gtest/gtest.h>
 
+#include <chrono>
 #include <deque>
+#include <functional>
 #include <memory>
+#include <thread>
 #include <tuple>
 #include <vector>
 
@@ -53,6 +56,15 @@ class StubMessageListener : public MessageListenerConcurrently {
   std::vector<std::vector<MQMessageExt>> batches;
 };
 
+class DeferredMessageListener : public MessageListenerConcurrently {
+ public:
+  void consumeMessageAsync(std::vector<MQMessageExt>& msgs, ConsumeCallbackPtr callback) override {
+    callbacks.push_back(callback);
+  }
+
+  std::vector<ConsumeCallbackPtr> callbacks;
+};
+
 class StubDefaultMQPushConsumerImpl : public DefaultMQPushConsumerImpl {
  public:
   explicit StubDefaultMQPushConsumerImpl(DefaultMQPushConsumerConfigPtr config)
@@ -72,10 +84,24 @@ class StubDefaultMQPushConsumerImpl : public DefaultMQPushConsumerImpl {
     return result;
   }
 
+  void sendMessageBackAsync(MessageExtPtr msg,
+                            int delayLevel,
+                            const std::string& brokerName,
+                            std::function<void(bool)> callback) override {
+    if (defer_send_back) {
+      send_back_calls.emplace_back(msg, delayLevel, brokerName);
+      pending_send_backs.push_back(std::move(callback));
+      return;
+    }
+    callback(sendMessageBack(msg, delayLevel, brokerName));
+  }
+
   using SendBackCall = std::tuple<MessageExtPtr, int, std::string>;
   std::vector<SendBackCall> send_back_calls;
   std::deque<bool> next_send_results;
   bool default_send_result = true;
+  bool defer_send_back = false;
+  std::vector<std::function<void(bool)>> pending_send_backs;
 };
 
 DefaultMQPushConsumerConfigPtr makeConfig() {
@@ -143,7 +169,6 @@ TEST(ConsumeMessageConcurrentlyServiceTest, ReconsumeLaterSendsBackAndAdvancesTo
   service.ConsumeRequest(msgs, processQueue, mq);
 
   ASSERT_EQ(2u, consumer.send_back_calls.size());
-  EXPECT_EQ(1u, msgs.size());
   EXPECT_EQ(11, std::get<0>(consumer.send_back_calls.back())->queue_offset());
   EXPECT_EQ(1, store_ptr->update_calls);
   EXPECT_EQ(11, store_ptr->last_offset);
@@ -151,5 +176,153 @@ TEST(ConsumeMessageConcurrentlyServiceTest, ReconsumeLaterSendsBackAndAdvancesTo
   EXPECT_EQ(11, processQueue->getCacheMinOffset());
 }
 
+TEST(ConsumeMessageConcurrentlyServiceTest, AsyncCompletionDoesNotHoldConsumeThread) {
+  auto config = makeConfig();
+  StubDefaultMQPushConsumerImpl consumer(config);
+  std::unique_ptr<RecordingOffsetStore> store(new RecordingOffsetStore());
+  auto* store_ptr = store.get();
+  consumer.offset_store_ = std::move(store);
+
+  DeferredMessageListener listener;
+  ConsumeMessageConcurrentlyService service(&consumer, 1, &listener);
+  service.start();
+
+  auto processQueue = std::make_shared<ProcessQueue>();
+  MQMessageQueue mq("TestTopic", "TestBroker", 5);
+  auto first = makeMessages({20, 21});
+  auto second = makeMessages({22});
+  processQueue->putMessage(first);
+  processQueue->putMessage(second);
+
+  // both requests return without waiting for the listener
+  service.ConsumeRequest(first, processQueue, mq);
+  service.ConsumeRequest(second, processQueue, mq);
+  ASSERT_EQ(2u, listener.callbacks.size());
+  EXPECT_EQ(0, store_ptr->update_calls);
+  EXPECT_EQ(3, processQueue->getCacheMsgCount());
+
+  listener.callbacks[1]->onComplete(CONSUME_SUCCESS);
+  listener.callbacks[0]->onComplete(CONSUME_SUCCESS);
+  listener.callbacks[0]->onComplete(RECONSUME_LATER);  // ignored
+
+  for (int i = 0; i < 100 && processQueue->getCacheMsgCount() > 0; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  service.shutdown();
+
+  EXPECT_EQ(0, processQueue->getCacheMsgCount());
+  EXPECT_EQ(23, store_ptr->last_offset);
+  EXPECT_TRUE(consumer.send_back_calls.empty());
+}
+
+TEST(ConsumeMessageConcurrentlyServiceTest, PartialCompleteOnlySendsBackFailedMessages) {
+  auto config = makeConfig();
+  StubDefaultMQPushConsumerImpl consumer(config);
+  std::unique_ptr<RecordingOffsetStore> store(new RecordingOffsetStore());
+  auto* store_ptr = store.get();
+  consumer.offset_store_ = std::move(store);
+  consumer.next_send_results = {false};
+
+  DeferredMessageListener listener;
+  ConsumeMessageConcurrentlyService service(&consumer, 1, &listener);
+
+  auto processQueue = std::make_shared<ProcessQueue>();
+  MQMessageQueue mq("TestTopic", "TestBroker", 2);
+  auto msgs = makeMessages({40, 41, 42, 43});
+  processQueue->putMessage(msgs);
+
+  service.ConsumeRequest(msgs, processQueue, mq);
+  ASSERT_EQ(1u, listener.callbacks.size());
+
+  // ConsumeRequest has returned, so the result is handed to the consume threads
+  service.start();
+  auto callback = listener.callbacks.front();
+  callback->onPartialComplete({true, false, true});  // the missing entry for 43 counts as failed
+  callback->onComplete(CONSUME_SUCCESS);             // ignored
+
+  for (int i = 0; i < 100 && processQueue->getCacheMsgCount() > 1; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  service.shutdown();
+
+  ASSERT_EQ(2u, consumer.send_back_calls.size());
+  EXPECT_EQ(41, std::get<0>(consumer.send_back_calls[0])->queue_offset());
+  EXPECT_EQ(43, std::get<0>(consumer.send_back_calls[1])->queue_offset());
+  // 41 failed to be sent back, so it stays in the process queue and holds the offset
+  EXPECT_EQ(1, processQueue->getCacheMsgCount());
+  EXPECT_EQ(1, store_ptr->update_calls);
+  EXPECT_EQ(41, store_ptr->last_offset);
+}
+
+TEST(ConsumeMessageConcurrentlyServiceTest, SendBackDoesNotBlockAndCommitsOnCompletion) {
+  auto config = makeConfig();
+  StubDefaultMQPushConsumerImpl consumer(config);
+  std::unique_ptr<RecordingOffsetStore> store(new RecordingOffsetStore());
+  auto* store_ptr = store.get();
+  consumer.offset_store_ = std::move(store);
+  consumer.defer_send_back = true;
+
+  StubMessageListener listener(RECONSUME_LATER);
+  ConsumeMessageConcurrentlyService service(&consumer, 1, &listener);
+
+  auto processQueue = std::make_shared<ProcessQueue>();
+  MQMessageQueue mq("TestTopic", "TestBroker", 4);
+  auto msgs = makeMessages({50, 51, 52});
+  processQueue->putMessage(msgs);
+
+  // ConsumeRequest returns while the broker has not answered yet
+  service.ConsumeRequest(msgs, processQueue, mq);
+  ASSERT_EQ(3u, consumer.pending_send_backs.size());
+  EXPECT_EQ("TestBroker", std::get<2>(consumer.send_back_calls.front()));
+  EXPECT_EQ(3, service.send_back_in_flight_.load());
+  EXPECT_EQ(0, store_ptr->update_calls);
+  EXPECT_EQ(3, processQueue->getCacheMsgCount());
+
+  consumer.pending_send_backs[0](true);
+  consumer.pending_send_backs[2](true);
+  EXPECT_EQ(0, store_ptr->update_calls);
+
+  // the last answer commits the consume result, 51 failed and is kept for local reconsumption
+  consumer.pending_send_backs[1](false);
+  EXPECT_EQ(0, service.send_back_in_flight_.load());
+  EXPECT_EQ(1, store_ptr->update_calls);
+  EXPECT_EQ(51, store_ptr->last_offset);
+  EXPECT_EQ(1, processQueue->getCacheMsgCount());
+  EXPECT_EQ(51, processQueue->getCacheMinOffset());
+}
+
+TEST(ConsumeMessageConcurrentlyServiceTest, SubmitSplitsPulledMessagesByBatchSize) {
+  auto config = makeConfig();
+  config->set_consume_message_batch_max_size(2);
+  StubDefaultMQPushConsumerImpl consumer(config);
+  std::unique_ptr<RecordingOffsetStore> store(new RecordingOffsetStore());
+  auto* store_ptr = store.get();
+  consumer.offset_store_ = std::move(store);
+
+  StubMessageListener listener(CONSUME_SUCCESS);
+  ConsumeMessageConcurrentlyService service(&consumer, 1, &listener);
+  service.start();
+
+  auto processQueue = std::make_shared<ProcessQueue>();
+  MQMessageQueue mq("TestTopic", "TestBroker", 1);
+  auto msgs = makeMessages({30, 31, 32, 33, 34});
+  processQueue->putMessage(msgs);
+
+  service.submitConsumeRequest(msgs, processQueue, mq, true);
+
+  for (int i = 0; i < 100 && processQueue->getCacheMsgCount() > 0; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  service.shutdown();
+
+  EXPECT_EQ(0, processQueue->getCacheMsgCount());
+  EXPECT_EQ(3, store_ptr->update_calls);
+  EXPECT_EQ(35, store_ptr->last_offset);
+  ASSERT_EQ(3u, listener.batches.size());
+  EXPECT_EQ(2u, listener.batches[0].size());
+  EXPECT_EQ(2u, listener.batches[1].size());
+  EXPECT_EQ(1u, listener.batches[2].size());
+}
+
 }  // namespace
 }  // namespace rocketmq
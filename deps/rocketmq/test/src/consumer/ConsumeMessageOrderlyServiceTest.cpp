@@ -1,7 +1,10 @@
 #include <gtest/gtest.h>
 
+#include <chrono>
 #include <deque>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 #define private public
@@ -58,6 +61,24 @@ class SequentialMessageListener : public MessageListenerOrderly {
   std::vector<std::vector<MQMessageExt>> invocations;
 };
 
+class DeferredOrderlyListener : public MessageListenerOrderly {
+ public:
+  void consumeMessageAsync(std::vector<MQMessageExt>& msgs, ConsumeCallbackPtr callback) override {
+    std::lock_guard<std::mutex> lock(mutex);
+    batches.push_back(msgs);
+    callbacks.push_back(callback);
+  }
+
+  size_t size() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return callbacks.size();
+  }
+
+  std::mutex mutex;
+  std::vector<std::vector<MQMessageExt>> batches;
+  std::vector<ConsumeCallbackPtr> callbacks;
+};
+
 class StubDefaultMQPushConsumerImpl : public DefaultMQPushConsumerImpl {
  public:
   explicit StubDefaultMQPushConsumerImpl(DefaultMQPushConsumerConfigPtr config)
@@ -146,5 +167,77 @@ TEST(ConsumeMessageOrderlyServiceTest, ReconsumeLaterRequeuesMessagesAndSkipsOff
   EXPECT_EQ(2u, listener.invocations.front().size());
 }
 
+TEST(ConsumeMessageOrderlyServiceTest, AsyncCompletionKeepsQueueOrderWithoutHoldingThread) {
+  auto config = makeConfig();
+  config->set_consume_message_batch_max_size(2);
+  StubDefaultMQPushConsumerImpl consumer(config);
+  std::unique_ptr<RecordingOffsetStore> store(new RecordingOffsetStore());
+  auto* store_ptr = store.get();
+  consumer.offset_store_ = std::move(store);
+
+  DeferredOrderlyListener listener;
+  ConsumeMessageOrderlyService service(&consumer, 1, &listener);
+
+  auto processQueue = prepareProcessQueue(makeMessages({300, 301, 302, 303}));
+  MQMessageQueue mq("OrderedTopic", "BrokerA", 1);
+
+  // returns without waiting for the listener, the second request finds the batch in flight
+  service.ConsumeRequest(processQueue, mq);
+  service.ConsumeRequest(processQueue, mq);
+  ASSERT_EQ(1u, listener.size());
+  EXPECT_TRUE(processQueue->consuming());
+  EXPECT_EQ(0, store_ptr->update_calls);
+
+  service.start();
+  listener.callbacks[0]->onComplete(CONSUME_SUCCESS);
+  for (int i = 0; i < 100 && listener.size() < 2; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  ASSERT_EQ(2u, listener.size());
+  EXPECT_EQ(302, listener.batches[1].front().queue_offset());
+
+  listener.callbacks[1]->onComplete(CONSUME_SUCCESS);
+  for (int i = 0; i < 100 && processQueue->getCacheMsgCount() > 0; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  service.stopThreadPool();
+
+  EXPECT_FALSE(processQueue->consuming());
+  EXPECT_EQ(0, processQueue->getCacheMsgCount());
+  EXPECT_EQ(304, store_ptr->last_offset);
+  EXPECT_EQ(2u, listener.size());
+}
+
+TEST(ConsumeMessageOrderlyServiceTest, PartialCompleteCommitsAcknowledgedPrefix) {
+  auto config = makeConfig();
+  StubDefaultMQPushConsumerImpl consumer(config);
+  std::unique_ptr<RecordingOffsetStore> store(new RecordingOffsetStore());
+  auto* store_ptr = store.get();
+  consumer.offset_store_ = std::move(store);
+
+  DeferredOrderlyListener listener;
+  ConsumeMessageOrderlyService service(&consumer, 1, &listener);
+
+  auto processQueue = prepareProcessQueue(makeMessages({400, 401, 402, 403}));
+  MQMessageQueue mq("OrderedTopic", "BrokerB", 2);
+
+  service.ConsumeRequest(processQueue, mq);
+  ASSERT_EQ(1u, listener.size());
+
+  service.start();
+  listener.callbacks[0]->onPartialComplete({true, false, true, true});
+  for (int i = 0; i < 100 && store_ptr->update_calls == 0; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  service.stopThreadPool();
+
+  // everything from the first failure is consumed again, in order
+  EXPECT_EQ(1, store_ptr->update_calls);
+  EXPECT_EQ(401, store_ptr->last_offset);
+  EXPECT_EQ(3, processQueue->getCacheMsgCount());
+  EXPECT_EQ(401, processQueue->getCacheMinOffset());
+  EXPECT_FALSE(processQueue->consuming());
+}
+
 }  // namespace
 }  // namespace rocketmq
@@ -50,8 +50,13 @@ TEST(DefaultLitePullConsumerConfigImplTest, DefaultsMatchExpectations) {
   EXPECT_EQ(20000, config.broker_suspend_max_time_millis());
   EXPECT_EQ(10000, config.pull_threshold_for_all());
   EXPECT_EQ(1000, config.pull_threshold_for_queue());
+  EXPECT_EQ(100, config.pull_threshold_size_for_queue());
+  EXPECT_EQ(-1, config.pull_threshold_size_for_all());
+  EXPECT_EQ(2000, config.consume_max_span());
   EXPECT_EQ(1000, config.pull_time_delay_millis_when_exception());
   EXPECT_EQ(5000, config.poll_timeout_millis());
+  EXPECT_EQ(32, config.poll_batch_max_size());
+  EXPECT_EQ(4 * 1024 * 1024, config.poll_batch_max_bytes());
   EXPECT_EQ(30000, config.topic_metadata_check_interval_millis());
   ASSERT_NE(nullptr, config.allocate_mq_strategy());
   EXPECT_NE(nullptr, dynamic_cast<AllocateMQAveragely*>(config.allocate_mq_strategy()));
@@ -74,6 +79,8 @@ TEST(DefaultLitePullConsumerConfigImplTest, SettersApplyNewValues) {
   config.set_pull_threshold_for_queue(666);
   config.set_pull_time_delay_millis_when_exception(777);
   config.set_poll_timeout_millis(888);
+  config.set_poll_batch_max_size(64);
+  config.set_poll_batch_max_bytes(1024);
   config.set_topic_metadata_check_interval_millis(999);
 
   EXPECT_EQ(rocketmq::MessageModel::BROADCASTING, config.message_model());
@@ -90,6 +97,8 @@ TEST(DefaultLitePullConsumerConfigImplTest, SettersApplyNewValues) {
   EXPECT_EQ(666, config.pull_threshold_for_queue());
   EXPECT_EQ(777, config.pull_time_delay_millis_when_exception());
   EXPECT_EQ(888, config.poll_timeout_millis());
+  EXPECT_EQ(64, config.poll_batch_max_size());
+  EXPECT_EQ(1024, config.poll_batch_max_bytes());
   EXPECT_EQ(999, config.topic_metadata_check_interval_millis());
 }
 
@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 
+#include <chrono>
+
 #define private public
 #define protected public
 #include "consumer/DefaultLitePullConsumerImpl.h"
@@ -8,7 +10,13 @@
 
 #include "consumer/AssignedMessageQueue.hpp"
 #include "consumer/DefaultLitePullConsumerConfigImpl.hpp"
+#include "consumer/LitePullTask.hpp"
+#include "consumer/PullAPIWrapper.h"
+#include "consumer/PullResult.h"
+#include "MQException.h"
+#include "MQMessageExt.h"
 #include "MQMessageQueue.h"
+#include "protocol/heartbeat/SubscriptionData.hpp"
 
 namespace rocketmq {
 
@@ -20,6 +28,30 @@ DefaultLitePullConsumerImplPtr makeConsumerImpl(MessageModel message_model = Mes
   return DefaultLitePullConsumerImpl::create(config);
 }
 
+// a consumer that was never started: its pull executor only queues scheduled tasks, so they can be counted
+DefaultLitePullConsumerImplPtr makeAssignedConsumer(const MQMessageQueue& mq) {
+  auto consumer = makeConsumerImpl();
+  consumer->pull_api_wrapper_.reset(new PullAPIWrapper(nullptr, "GID_unit_test"));
+  consumer->auto_commit_ = false;
+  std::vector<MQMessageQueue> assigned{mq};
+  consumer->assigned_message_queue_->updateAssignedMessageQueue(mq.topic(), assigned);
+  return consumer;
+}
+
+size_t scheduledPulls(const DefaultLitePullConsumerImplPtr& consumer) {
+  return consumer->scheduled_thread_pool_executor_.time_queue_.size();
+}
+
+std::unique_ptr<PullResult> makeFoundResult(int64_t begin, int64_t end) {
+  std::vector<MessageExtPtr> messages;
+  for (int64_t offset = begin; offset < end; offset++) {
+    auto message = std::make_shared<MQMessageExt>();
+    message->set_queue_offset(offset);
+    messages.push_back(message);
+  }
+  return std::unique_ptr<PullResult>(new PullResult(FOUND, end, 0, end, std::move(messages)));
+}
+
 std::vector<MQMessageQueue> sortedQueues(std::vector<MQMessageQueue> queues) {
   std::sort(queues.begin(), queues.end());
   return queues;
@@ -74,4 +106,92 @@ TEST(DefaultLitePullConsumerImplTest, MessageQueueListenerUsesAllQueuesForBroadc
   EXPECT_EQ(mq_all.size(), consumer->task_table_.size());
 }
 
+TEST(DefaultLitePullConsumerImplTest, AsyncPullCallbackAdvancesOffsetsAndSchedulesNextPull) {
+  MQMessageQueue mq("TopicTest", "BrokerA", 0);
+  auto consumer = makeAssignedConsumer(mq);
+  auto task = std::make_shared<DefaultLitePullConsumerImpl::PullTaskImpl>(consumer, mq);
+  SubscriptionData subscription(mq.topic(), "*");
+
+  DefaultLitePullConsumerImpl::AsyncPullCallback callback(
+      task, consumer->assigned_message_queue_->getProcessQueue(mq), &subscription, nullptr, 0);
+  callback.onSuccess(makeFoundResult(10, 12));
+
+  EXPECT_EQ(12, consumer->assigned_message_queue_->getPullOffset(mq));
+  EXPECT_EQ(1U, scheduledPulls(consumer));
+
+  auto messages = consumer->poll(0);
+  ASSERT_EQ(2U, messages.size());
+  EXPECT_EQ(10, messages[0].queue_offset());
+  EXPECT_EQ(12, consumer->assigned_message_queue_->getConsumerOffset(mq));
+}
+
+TEST(DefaultLitePullConsumerImplTest, AsyncPullCallbackSchedulesNextPullOnException) {
+  MQMessageQueue mq("TopicTest", "BrokerA", 0);
+  auto consumer = makeAssignedConsumer(mq);
+  auto task = std::make_shared<DefaultLitePullConsumerImpl::PullTaskImpl>(consumer, mq);
+  SubscriptionData subscription(mq.topic(), "*");
+
+  DefaultLitePullConsumerImpl::AsyncPullCallback callback(
+      task, consumer->assigned_message_queue_->getProcessQueue(mq), &subscription, nullptr, 0);
+  MQException exception("pull failed", -1, __FILE__, __LINE__);
+  callback.onException(exception);
+
+  EXPECT_EQ(-1, consumer->assigned_message_queue_->getPullOffset(mq));
+  EXPECT_EQ(1U, scheduledPulls(consumer));
+}
+
+TEST(DefaultLitePullConsumerImplTest, CancelledPullTaskStopsRescheduling) {
+  MQMessageQueue mq("TopicTest", "BrokerA", 0);
+  auto consumer = makeAssignedConsumer(mq);
+  auto task = std::make_shared<DefaultLitePullConsumerImpl::PullTaskImpl>(consumer, mq);
+  task->set_cancelled(true);
+  SubscriptionData subscription(mq.topic(), "*");
+
+  DefaultLitePullConsumerImpl::AsyncPullCallback callback(
+      task, consumer->assigned_message_queue_->getProcessQueue(mq), &subscription, nullptr, 0);
+  callback.onSuccess(makeFoundResult(10, 12));
+  MQException exception("pull failed", -1, __FILE__, __LINE__);
+  callback.onException(exception);
+  task->run();
+
+  EXPECT_EQ(-1, consumer->assigned_message_queue_->getPullOffset(mq));
+  EXPECT_EQ(0, consumer->consume_request_cache_.count());
+  EXPECT_EQ(0U, scheduledPulls(consumer));
+}
+
+TEST(DefaultLitePullConsumerImplTest, PullIssuedBeforeSeekIsDropped) {
+  MQMessageQueue mq("TopicTest", "BrokerA", 0);
+  auto consumer = makeAssignedConsumer(mq);
+  auto task = std::make_shared<DefaultLitePullConsumerImpl::PullTaskImpl>(consumer, mq);
+  SubscriptionData subscription(mq.topic(), "*");
+
+  DefaultLitePullConsumerImpl::AsyncPullCallback callback(
+      task, consumer->assigned_message_queue_->getProcessQueue(mq), &subscription, nullptr,
+      consumer->assigned_message_queue_->getSeekGeneration(mq));
+  // the seek lands while the pull is in flight and before the old task sees it is cancelled
+  consumer->assigned_message_queue_->setSeekOffset(mq, 5);
+  callback.onSuccess(makeFoundResult(10, 12));
+
+  EXPECT_EQ(-1, consumer->assigned_message_queue_->getPullOffset(mq));
+  EXPECT_EQ(5, consumer->assigned_message_queue_->getSeekOffset(mq));
+  EXPECT_EQ(0, consumer->consume_request_cache_.count());
+  EXPECT_EQ(0U, scheduledPulls(consumer));
+}
+
+TEST(DefaultLitePullConsumerImplTest, PausedQueueIsOnlyRecheckedAfterPauseDelay) {
+  MQMessageQueue mq("TopicTest", "BrokerA", 0);
+  auto consumer = makeAssignedConsumer(mq);
+  auto task = std::make_shared<DefaultLitePullConsumerImpl::PullTaskImpl>(consumer, mq);
+  consumer->assigned_message_queue_->pause({mq});
+
+  auto before = std::chrono::steady_clock::now();
+  task->run();
+
+  // no pull is issued, the task only checks the queue again after the pause delay
+  EXPECT_EQ(-1, consumer->assigned_message_queue_->getPullOffset(mq));
+  ASSERT_EQ(1U, scheduledPulls(consumer));
+  auto wakeup = consumer->scheduled_thread_pool_executor_.time_queue_.top()->wakeup_time_;
+  EXPECT_GE(wakeup - before, std::chrono::milliseconds(PULL_TIME_DELAY_MILLS_WHEN_PAUSE));
+}
+
 }  // namespace rocketmq
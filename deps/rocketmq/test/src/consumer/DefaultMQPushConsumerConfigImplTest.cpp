@@ -44,6 +44,9 @@ TEST(DefaultMQPushConsumerConfigImplTest, DefaultsMatchExpectations) {
   const int expected_threads = std::min(8, static_cast<int>(std::thread::hardware_concurrency()));
   EXPECT_EQ(expected_threads, config.consume_thread_nums());
   EXPECT_EQ(1000, config.pull_threshold_for_queue());
+  EXPECT_EQ(100, config.pull_threshold_size_for_queue());
+  EXPECT_EQ(-1, config.pull_threshold_size_for_all());
+  EXPECT_EQ(2000, config.consume_concurrently_max_span());
   EXPECT_EQ(1, config.consume_message_batch_max_size());
   EXPECT_EQ(32, config.pull_batch_size());
   EXPECT_EQ(16, config.max_reconsume_times());
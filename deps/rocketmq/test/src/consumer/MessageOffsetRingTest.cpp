@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "MQMessageExt.h"
+#include "consumer/MessageOffsetRing.hpp"
+
+using rocketmq::MessageExtPtr;
+using rocketmq::MessageOffsetRing;
+using rocketmq::MQMessageExt;
+
+namespace {
+
+MessageExtPtr MakeMessage(int64_t offset) {
+  auto msg = std::make_shared<MQMessageExt>();
+  msg->set_queue_offset(offset);
+  return msg;
+}
+
+std::vector<int64_t> Offsets(const MessageOffsetRing& ring) {
+  std::vector<int64_t> offsets;
+  ring.for_each([&offsets](const MessageExtPtr& msg) { offsets.push_back(msg->queue_offset()); });
+  return offsets;
+}
+
+}  // namespace
+
+TEST(MessageOffsetRingTest, PutAndRemoveKeepWindow) {
+  MessageOffsetRing ring;
+  EXPECT_TRUE(ring.empty());
+  EXPECT_EQ(nullptr, ring.remove(0));
+
+  for (int64_t offset : {12, 10, 11, 15}) {
+    EXPECT_EQ(nullptr, ring.put(MakeMessage(offset)));
+  }
+  EXPECT_EQ(4u, ring.size());
+  EXPECT_EQ(10, ring.min_offset());
+  EXPECT_EQ(15, ring.max_offset());
+  EXPECT_EQ((std::vector<int64_t>{10, 11, 12, 15}), Offsets(ring));
+
+  // replacing a message doesn't change the count
+  auto replacement = MakeMessage(11);
+  EXPECT_NE(nullptr, ring.put(replacement));
+  EXPECT_EQ(4u, ring.size());
+
+  EXPECT_EQ(nullptr, ring.remove(13));
+  EXPECT_EQ(replacement, ring.remove(11));
+  EXPECT_EQ(10, ring.min_offset());
+  EXPECT_NE(nullptr, ring.remove(10));
+  EXPECT_EQ(12, ring.min_offset());
+  EXPECT_NE(nullptr, ring.remove(15));
+  EXPECT_EQ(12, ring.max_offset());
+
+  EXPECT_EQ(12, ring.pop_front()->queue_offset());
+  EXPECT_TRUE(ring.empty());
+  EXPECT_EQ(nullptr, ring.pop_front());
+}
+
+TEST(MessageOffsetRingTest, SparseOffsetsDontAllocateTheSpan) {
+  MessageOffsetRing ring;
+  // a slot per offset of this span would need terabytes
+  const int64_t far = int64_t(1) << 40;
+  for (int64_t offset : {int64_t(7), far, int64_t(5), far + 3}) {
+    EXPECT_EQ(nullptr, ring.put(MakeMessage(offset)));
+  }
+  EXPECT_EQ(4u, ring.size());
+  EXPECT_EQ(5, ring.min_offset());
+  EXPECT_EQ(far + 3, ring.max_offset());
+  EXPECT_EQ((std::vector<int64_t>{5, 7, far, far + 3}), Offsets(ring));
+
+  EXPECT_NE(nullptr, ring.put(MakeMessage(far)));
+  EXPECT_EQ(4u, ring.size());
+  EXPECT_EQ(nullptr, ring.remove(6));
+  EXPECT_NE(nullptr, ring.remove(far + 3));
+  EXPECT_EQ(far, ring.max_offset());
+  EXPECT_EQ(5, ring.pop_front()->queue_offset());
+  EXPECT_EQ(7, ring.min_offset());
+  EXPECT_NE(nullptr, ring.remove(7));
+  EXPECT_NE(nullptr, ring.remove(far));
+  EXPECT_TRUE(ring.empty());
+
+  // once empty, dense offsets go back to the ring
+  for (int64_t offset = 100; offset < 110; offset++) {
+    ring.put(MakeMessage(offset));
+  }
+  EXPECT_EQ(10u, ring.size());
+  EXPECT_EQ(100, ring.min_offset());
+  EXPECT_EQ(109, ring.max_offset());
+  EXPECT_EQ(100, ring.pop_front()->queue_offset());
+}
+
+TEST(MessageOffsetRingTest, GrowsWithWindow) {
+  MessageOffsetRing ring;
+  ring.put(MakeMessage(1000));
+  for (int64_t offset = 1000 + 1; offset < 1000 + 300; offset++) {
+    ring.put(MakeMessage(offset));
+  }
+  ring.put(MakeMessage(900));
+  ring.put(MakeMessage(5000));
+
+  EXPECT_EQ(302u, ring.size());
+  EXPECT_EQ(900, ring.min_offset());
+  EXPECT_EQ(5000, ring.max_offset());
+
+  auto offsets = Offsets(ring);
+  ASSERT_EQ(302u, offsets.size());
+  EXPECT_EQ(900, offsets.front());
+  EXPECT_EQ(1000, offsets[1]);
+  EXPECT_EQ(1299, offsets[300]);
+  EXPECT_EQ(5000, offsets.back());
+
+  EXPECT_NE(nullptr, ring.remove(900));
+  EXPECT_EQ(1000, ring.min_offset());
+
+  ring.clear();
+  EXPECT_TRUE(ring.empty());
+  EXPECT_TRUE(Offsets(ring).empty());
+}
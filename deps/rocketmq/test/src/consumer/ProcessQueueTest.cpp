@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "MQMessageExt.h"
@@ -15,10 +16,11 @@ using rocketmq::ProcessQueueInfo;
 
 namespace {
 
-MessageExtPtr MakeMessage(int64_t offset, int queue_id = 0) {
+MessageExtPtr MakeMessage(int64_t offset, int queue_id = 0, size_t body_size = 0) {
   auto msg = std::make_shared<MQMessageExt>();
   msg->set_queue_offset(offset);
   msg->set_queue_id(queue_id);
+  msg->set_body(std::string(body_size, 'x'));
   return msg;
 }
 
@@ -80,6 +82,48 @@ TEST(ProcessQueueTest, ClearAllMsgsRequiresDroppedFlag) {
   EXPECT_EQ(0, pq.getCacheMaxOffset());
 }
 
+TEST(ProcessQueueTest, ClearDropsMessagesOfLiveQueue) {
+  ProcessQueue pq;
+  pq.putMessage({MakeMessage(2, 0, 10), MakeMessage(3, 0, 10)});
+  std::vector<MessageExtPtr> batch;
+  pq.takeMessages(batch, 1);
+
+  pq.clear();
+  EXPECT_FALSE(pq.dropped());
+  EXPECT_EQ(0, pq.getCacheMsgCount());
+  EXPECT_EQ(0, pq.getCacheMsgSize());
+  EXPECT_EQ(0, pq.getCacheMinOffset());
+}
+
+TEST(ProcessQueueTest, CacheSizeAndSpanAreTracked) {
+  ProcessQueue pq;
+  pq.putMessage({MakeMessage(3, 0, 100), MakeMessage(4, 0, 200), MakeMessage(9, 0, 300)});
+  EXPECT_EQ(600, pq.getCacheMsgSize());
+  EXPECT_EQ(6, pq.getMaxSpan());
+
+  // re-put replaces the cached message
+  pq.putMessage({MakeMessage(4, 0, 50)});
+  EXPECT_EQ(450, pq.getCacheMsgSize());
+
+  // removing unknown offsets changes nothing
+  pq.removeMessage({MakeMessage(3, 0, 100), MakeMessage(5, 0, 1000)});
+  EXPECT_EQ(350, pq.getCacheMsgSize());
+  EXPECT_EQ(5, pq.getMaxSpan());
+
+  // orderly: size is released on commit
+  std::vector<MessageExtPtr> batch;
+  pq.takeMessages(batch, 1);
+  EXPECT_EQ(350, pq.getCacheMsgSize());
+  EXPECT_EQ(0, pq.getMaxSpan());
+  pq.commit();
+  EXPECT_EQ(300, pq.getCacheMsgSize());
+
+  pq.set_dropped(true);
+  pq.clearAllMsgs();
+  EXPECT_EQ(0, pq.getCacheMsgSize());
+  EXPECT_EQ(0, pq.getMaxSpan());
+}
+
 TEST(ProcessQueueTest, FillProcessQueueInfoReflectsState) {
   ProcessQueue pq;
   pq.putMessage({MakeMessage(7), MakeMessage(8)});
@@ -101,6 +145,7 @@ TEST(ProcessQueueTest, FillProcessQueueInfoReflectsState) {
   EXPECT_EQ(8, info.cachedMsgMinOffset);
   EXPECT_EQ(8, info.cachedMsgMaxOffset);
   EXPECT_EQ(1, info.cachedMsgCount);
+  EXPECT_EQ(0, info.cachedMsgSizeInMiB);
 
   EXPECT_EQ(7, info.transactionMsgMinOffset);
   EXPECT_EQ(7, info.transactionMsgMaxOffset);
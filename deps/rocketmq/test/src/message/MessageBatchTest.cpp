@@ -19,19 +19,24 @@
 
 #include <memory>
 
+#include "CompressionCodec.h"
 #include "MessageDecoder.h"
 #include "MQException.h"
 #include "MQMessage.h"
+#include "MQMessageConst.h"
 #include "MessageBatch.h"
 
 using testing::InitGoogleMock;
 using testing::InitGoogleTest;
 using testing::Return;
 
+using rocketmq::CompressionCodec;
+using rocketmq::CompressionType;
 using rocketmq::MessageBatch;
 using rocketmq::MessageDecoder;
 using rocketmq::MQClientException;
 using rocketmq::MQMessage;
+using rocketmq::MQMessageConst;
 using rocketmq::stoba;
 
 TEST(MessageBatchTest, Encode) {
@@ -53,6 +58,65 @@ TEST(MessageBatchTest, Encode) {
   EXPECT_EQ(encodeMessage.size(), 132);  // 44 * 3
 }
 
+TEST(MessageBatchTest, EncodeLayout) {
+  std::vector<MQMessage> msgs;
+  msgs.push_back(MQMessage("topic", "tagA", "keyA", 7, "body1", true));
+  msgs.push_back(MQMessage("topic", "*", ""));
+  msgs[1].putProperty(MQMessageConst::PROPERTY_ALREADY_COMPRESSED_FLAG, "true");
+
+  std::string expected;
+  for (const auto& msg : msgs) {
+    auto props = MessageDecoder::messageProperties2String(msg.properties());
+    auto putInt = [&expected](uint32_t value) {
+      for (int shift = 24; shift >= 0; shift -= 8) {
+        expected.push_back(static_cast<char>((value >> shift) & 0xFF));
+      }
+    };
+    putInt(4 + 4 + 4 + 4 + 4 + msg.body().size() + 2 + props.size());
+    putInt(0);
+    putInt(0);
+    putInt(msg.flag());
+    putInt(msg.body().size());
+    expected.append(msg.body());
+    expected.push_back(static_cast<char>(props.size() >> 8));
+    expected.push_back(static_cast<char>(props.size() & 0xFF));
+    expected.append(props);
+  }
+
+  auto encoded = MessageDecoder::encodeMessages(msgs);
+  EXPECT_EQ(expected, encoded);
+  EXPECT_EQ(encoded, MessageDecoder::encodeMessage(msgs[0]) + MessageDecoder::encodeMessage(msgs[1]));
+}
+
+TEST(MessageBatchTest, Compress) {
+  const std::string body(4096, 'a');
+  std::vector<MQMessage> msgs;
+  msgs.push_back(MQMessage("topic", "*", body));
+  msgs.push_back(MQMessage("topic", "*", body + "b"));
+  auto msgBatch = MessageBatch::generateFromList(msgs);
+  msgBatch->set_body(msgBatch->encode());
+  auto plainSize = msgBatch->body().size();
+
+  const auto* codec = CompressionCodec::of(CompressionType::ZLIB);
+  ASSERT_TRUE(msgBatch->compress(*codec, 5));
+  EXPECT_LT(msgBatch->body().size(), plainSize / 10);
+  EXPECT_EQ(msgBatch->body(), msgBatch->encode());
+
+  // inner messages are compressed one by one, the flag itself is not encoded
+  std::string restored;
+  ASSERT_TRUE(codec->uncompress(msgBatch->messages()[0].body().data(), msgBatch->messages()[0].body().size(), restored));
+  EXPECT_EQ(body, restored);
+  ASSERT_TRUE(codec->uncompress(msgBatch->messages()[1].body().data(), msgBatch->messages()[1].body().size(), restored));
+  EXPECT_EQ(body + "b", restored);
+  EXPECT_EQ("true", msgBatch->messages()[0].getProperty(MQMessageConst::PROPERTY_ALREADY_COMPRESSED_FLAG));
+  EXPECT_EQ(std::string::npos, msgBatch->body().find(MQMessageConst::PROPERTY_ALREADY_COMPRESSED_FLAG));
+
+  // compressed messages are not compressed twice
+  auto compressedBody = msgBatch->messages()[0].body();
+  ASSERT_TRUE(msgBatch->compress(*codec, 5));
+  EXPECT_EQ(compressedBody, msgBatch->messages()[0].body());
+}
+
 TEST(MessageBatchTest, RejectsRetryTopic) {
   std::vector<MQMessage> msgs;
   msgs.emplace_back("%RETRY%GID_group", "*", "body");
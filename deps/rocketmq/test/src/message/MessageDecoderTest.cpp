@@ -26,6 +26,7 @@
 
 #include "ByteArray.h"
 #include "ByteBuffer.hpp"
+#include "CompressionCodec.h"
 #include "MQMessage.h"
 #include "MQMessageConst.h"
 #include "MQMessageExt.h"
@@ -41,6 +42,8 @@ using testing::Return;
 
 using rocketmq::ByteArray;
 using rocketmq::ByteBuffer;
+using rocketmq::CompressionCodec;
+using rocketmq::CompressionType;
 using rocketmq::MessageDecoder;
 using rocketmq::MessageId;
 using rocketmq::MessageSysFlag;
@@ -238,6 +241,88 @@ TEST(MessageDecoderTest, MessagePropertiesAndToString) {
 
   auto properties2 = MessageDecoder::string2messageProperties(props);
   EXPECT_EQ(properties, properties2);
+
+  // empty fields are skipped, entries without exactly a name and a value are dropped
+  auto properties3 = MessageDecoder::string2messageProperties(
+      "\002a\001\0011\002b\002c\0013\001x\002\001d\002e\0015");
+  EXPECT_EQ(2, properties3.size());
+  EXPECT_EQ("1", properties3["a"]);
+  EXPECT_EQ("5", properties3["e"]);
+}
+
+TEST(MessageDecoderTest, OffsetMsgIdOnFirstAccess) {
+  std::unique_ptr<ByteBuffer> byteBuffer(ByteBuffer::allocate(128));
+
+  byteBuffer->putInt(0);     // TOTALSIZE
+  byteBuffer->putInt(0);     // MAGICCODE
+  byteBuffer->putInt(0);     // BODYCRC
+  byteBuffer->putInt(0);     // QUEUEID
+  byteBuffer->putInt(0);     // FLAG
+  byteBuffer->putLong(0);    // QUEUEOFFSET
+  byteBuffer->putLong(1024); // PHYSICALOFFSET
+  byteBuffer->putInt(0);     // SYSFLAG (IPv4)
+  byteBuffer->putLong(0);    // BORNTIMESTAMP
+  byteBuffer->putInt(ntohl(inet_addr("127.0.0.1")));
+  byteBuffer->putInt(10091);
+  byteBuffer->putLong(0);    // STORETIMESTAMP
+  byteBuffer->putInt(ntohl(inet_addr("127.0.0.1")));
+  byteBuffer->putInt(10091);
+  byteBuffer->putInt(0);     // RECONSUMETIMES
+  byteBuffer->putLong(0);    // PREPARED TRANSACTION OFFSET
+  byteBuffer->putInt(0);     // BODYLEN
+  byteBuffer->put((int8_t)1);
+  byteBuffer->put('T');      // TOPIC
+  byteBuffer->putShort(0);   // PROPERTIES
+
+  byteBuffer->flip();
+
+  auto msgs = MessageDecoder::decodes(*byteBuffer);
+  ASSERT_EQ(msgs.size(), 1);
+  EXPECT_EQ("T", msgs[0]->topic());
+  EXPECT_EQ("7F0000010000276B0000000000000400", msgs[0]->msg_id());
+}
+
+TEST(MessageDecoderTest, DecodesCompressedBatch) {
+  // the broker stores each message of a compressed batch with the sysFlag of the batch
+  const auto* codec = CompressionCodec::of(CompressionType::ZLIB);
+  int32_t sysFlag = MessageSysFlag::COMPRESSED_FLAG | MessageSysFlag::compressionFlag(CompressionType::ZLIB);
+  std::vector<std::string> bodies = {std::string(1024, 'x'), std::string(2048, 'y')};
+
+  std::unique_ptr<ByteBuffer> byteBuffer(ByteBuffer::allocate(1024));
+  for (size_t i = 0; i < bodies.size(); i++) {
+    std::string compressedBody;
+    ASSERT_TRUE(codec->compress(bodies[i].data(), bodies[i].size(), 5, compressedBody));
+
+    byteBuffer->putInt(0);       // TOTALSIZE
+    byteBuffer->putInt(0);       // MAGICCODE
+    byteBuffer->putInt(0);       // BODYCRC
+    byteBuffer->putInt(0);       // QUEUEID
+    byteBuffer->putInt(0);       // FLAG
+    byteBuffer->putLong(i);      // QUEUEOFFSET
+    byteBuffer->putLong(0);      // PHYSICALOFFSET
+    byteBuffer->putInt(sysFlag); // SYSFLAG
+    byteBuffer->putLong(0);      // BORNTIMESTAMP
+    byteBuffer->putInt(ntohl(inet_addr("127.0.0.1")));
+    byteBuffer->putInt(10091);
+    byteBuffer->putLong(0);      // STORETIMESTAMP
+    byteBuffer->putInt(ntohl(inet_addr("127.0.0.1")));
+    byteBuffer->putInt(10091);
+    byteBuffer->putInt(0);       // RECONSUMETIMES
+    byteBuffer->putLong(0);      // PREPARED TRANSACTION OFFSET
+    byteBuffer->putInt(compressedBody.size());
+    byteBuffer->put(*stoba(compressedBody));
+    byteBuffer->put((int8_t)1);
+    byteBuffer->put('T');        // TOPIC
+    byteBuffer->putShort(0);     // PROPERTIES
+  }
+
+  byteBuffer->flip();
+
+  auto msgs = MessageDecoder::decodes(*byteBuffer);
+  ASSERT_EQ(msgs.size(), 2);
+  EXPECT_EQ(bodies[0], msgs[0]->body());
+  EXPECT_EQ(bodies[1], msgs[1]->body());
+  EXPECT_EQ(1, msgs[1]->queue_offset());
 }
 
 int main(int argc, char* argv[]) {
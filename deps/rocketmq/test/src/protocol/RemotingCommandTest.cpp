@@ -45,6 +45,7 @@ using rocketmq::RemotingCommand;
 using rocketmq::ResetOffsetRequestHeader;
 using rocketmq::SearchOffsetResponseHeader;
 using rocketmq::SendMessageResponseHeader;
+using rocketmq::SerializeType;
 
 TEST(RemotingCommandTest, Init) {
   RemotingCommand remotingCommand;
@@ -163,6 +164,81 @@ TEST(RemotingCommandTest, EncodeAndDecode) {
   EXPECT_EQ(requestHeader->getConsumerGroup(), header->getConsumerGroup());
 }
 
+TEST(RemotingCommandTest, EncodeAndDecodeRocketMQHeader) {
+  GetConsumerRunningInfoRequestHeader* requestHeader = new GetConsumerRunningInfoRequestHeader();
+  requestHeader->setClientId("client");
+  requestHeader->setConsumerGroup("consumerGroup");
+  requestHeader->setJstackEnable(false);
+
+  RemotingCommand remotingCommand(MQRequestCode::GET_CONSUMER_RUNNING_INFO, MQVersion::CURRENT_LANGUAGE,
+                                  MQVersion::CURRENT_VERSION, 12, 3, "remark", requestHeader);
+  remotingCommand.set_ext_field("extKey", "extValue");
+  remotingCommand.set_body("123123");
+  remotingCommand.set_serialize_type(SerializeType::ROCKETMQ);
+
+  auto package = remotingCommand.encode();
+
+  // high byte of header length is serialize type
+  EXPECT_EQ(package->array()[4], 1);
+  // code is a big-endian short right after header length
+  EXPECT_EQ(((uint8_t)package->array()[8] << 8) | (uint8_t)package->array()[9],
+            (int)MQRequestCode::GET_CONSUMER_RUNNING_INFO);
+  EXPECT_EQ(package->array()[10], 1);  // LanguageCode.CPP
+
+  std::unique_ptr<RemotingCommand> decodeRemtingCommand(RemotingCommand::Decode(package, true));
+
+  EXPECT_EQ(decodeRemtingCommand->serialize_type(), SerializeType::ROCKETMQ);
+  EXPECT_EQ(remotingCommand.code(), decodeRemtingCommand->code());
+  EXPECT_EQ(MQVersion::CURRENT_LANGUAGE, decodeRemtingCommand->language());
+  EXPECT_EQ(remotingCommand.opaque(), decodeRemtingCommand->opaque());
+  EXPECT_EQ(remotingCommand.remark(), decodeRemtingCommand->remark());
+  EXPECT_EQ(remotingCommand.version(), decodeRemtingCommand->version());
+  EXPECT_EQ(remotingCommand.flag(), decodeRemtingCommand->flag());
+  EXPECT_EQ(std::string(decodeRemtingCommand->body()->array(), decodeRemtingCommand->body()->size()), "123123");
+
+  auto* header = decodeRemtingCommand->decodeCommandCustomHeader<GetConsumerRunningInfoRequestHeader>();
+  EXPECT_EQ(requestHeader->getClientId(), header->getClientId());
+  EXPECT_EQ(requestHeader->getConsumerGroup(), header->getConsumerGroup());
+  EXPECT_EQ(requestHeader->isJstackEnable(), header->isJstackEnable());
+
+  // truncated header
+  auto headerLength = ((uint8_t)package->array()[5] << 16) | ((uint8_t)package->array()[6] << 8) |
+                      (uint8_t)package->array()[7];
+  auto truncated = rocketmq::catoba(package->array(), 8 + headerLength - 1);
+  truncated->array()[7] -= 1;
+  EXPECT_THROW(RemotingCommand::Decode(truncated, true), rocketmq::MQException);
+}
+
+TEST(RemotingCommandTest, JsonHeaderIsDefault) {
+  RemotingCommand remotingCommand(MQRequestCode::QUERY_BROKER_OFFSET, MQVersion::CURRENT_LANGUAGE,
+                                  MQVersion::CURRENT_VERSION, 12, 3, "remark", nullptr);
+  EXPECT_EQ(remotingCommand.serialize_type(), SerializeType::JSON);
+
+  auto package = remotingCommand.encode();
+  EXPECT_EQ(package->array()[4], 0);
+  EXPECT_EQ(package->array()[8], '{');
+
+  std::unique_ptr<RemotingCommand> decodeRemtingCommand(RemotingCommand::Decode(package, true));
+  EXPECT_EQ(decodeRemtingCommand->serialize_type(), SerializeType::JSON);
+}
+
+TEST(RemotingCommandTest, EncodeHeaderWithoutBody) {
+  for (auto serializeType : {SerializeType::JSON, SerializeType::ROCKETMQ}) {
+    RemotingCommand remotingCommand(MQRequestCode::GET_CONSUMER_RUNNING_INFO, MQVersion::CURRENT_LANGUAGE,
+                                    MQVersion::CURRENT_VERSION, 12, 3, "remark", new GetRouteInfoRequestHeader("topic"));
+    remotingCommand.set_body("123123");
+    remotingCommand.set_serialize_type(serializeType);
+
+    auto package = remotingCommand.encode();
+    auto header = remotingCommand.encodeHeader();
+
+    // header + body is exactly the whole package
+    ASSERT_EQ(header->size() + 6, package->size());
+    EXPECT_EQ(std::string(header->array(), header->size()), std::string(package->array(), header->size()));
+    EXPECT_EQ(std::string(package->array() + header->size(), 6), "123123");
+  }
+}
+
 TEST(RemotingCommandTest, SetExtHeader) {
   std::unique_ptr<RemotingCommand> remotingCommand(new RemotingCommand());
 
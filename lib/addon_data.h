@@ -24,7 +24,9 @@ namespace __node_rocketmq__ {
 struct AddonData {
   Napi::FunctionReference producer_constructor;
   Napi::FunctionReference push_consumer_constructor;
+  Napi::FunctionReference lite_pull_consumer_constructor;
   Napi::FunctionReference consumer_ack_constructor;
+  Napi::FunctionReference message_view_constructor;
 };
 
 AddonData* GetAddonData(Napi::Env env);
@@ -17,6 +17,7 @@
 #ifndef __ROCKETMQ_COMMON_UTILS_H__
 #define __ROCKETMQ_COMMON_UTILS_H__
 
+#include <cstddef>
 #include <cstdlib>
 #include <chrono>
 #include <napi.h>
@@ -37,6 +38,8 @@ inline bool IsEnvEnabled(const char* name) {
 namespace config {
   constexpr std::chrono::seconds DEFAULT_MESSAGE_TIMEOUT{30};
   constexpr int MAX_BACKTRACE_FRAMES = 64;
+  // 客户端攒批默认的单批字节上限
+  constexpr size_t DEFAULT_BATCH_BYTES = 64 * 1024;
 }
 
 // 通用工具函数
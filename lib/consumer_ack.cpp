@@ -52,12 +52,72 @@ Napi::Object ConsumerAck::NewInstance(Napi::Env env) {
 ConsumerAck::ConsumerAck(const Napi::CallbackInfo& info)
     : Napi::ObjectWrap<ConsumerAck>(info) {}
 
+ConsumerAck::~ConsumerAck() {
+  // 异步模式下 JS 未调用 done() 就被 GC，按消费失败处理，避免消息一直占用 ProcessQueue
+  if (callback_ && !done_called_.exchange(true)) {
+    callback_->onComplete(rocketmq::ConsumeStatus::RECONSUME_LATER);
+  }
+}
+
 void ConsumerAck::SetPromise(std::promise<bool>&& promise) {
   promise_ = std::move(promise);
 }
 
+void ConsumerAck::SetCallback(rocketmq::ConsumeCallbackPtr callback) {
+  callback_ = std::move(callback);
+}
+
+void ConsumerAck::SetAcks(std::shared_ptr<std::vector<bool>> acks) {
+  acks_ = std::move(acks);
+}
+
+void ConsumerAck::Complete(const std::vector<bool>& acks) {
+  if (callback_) {
+    callback_->onPartialComplete(acks);
+    return;
+  }
+
+  bool ack = !acks.empty();
+  for (auto each : acks) {
+    ack = ack && each;
+  }
+  if (acks_) {
+    // 先写入逐条结果，promise 唤醒消费线程后它才会读取
+    *acks_ = acks;
+  }
+  Complete(ack);
+}
+
+void ConsumerAck::Complete(bool ack) {
+  if (callback_) {
+    callback_->onComplete(ack ? rocketmq::ConsumeStatus::CONSUME_SUCCESS
+                              : rocketmq::ConsumeStatus::RECONSUME_LATER);
+    return;
+  }
+
+#if defined(ROCKETMQ_COVERAGE) || defined(ROCKETMQ_USE_STUB)
+  if (IsEnvEnabled("ROCKETMQ_STUB_CONSUMER_ACK_FORCE_FUTURE_ERROR")) {
+    try {
+      promise_.set_value(true);
+    } catch (const std::future_error&) {
+    }
+  }
+#endif
+  try {
+    promise_.set_value(ack);
+  } catch (const std::future_error& e) {
+    fprintf(stderr, "[RocketMQ] Warning: Failed to set value in ConsumerAck::Done: %s\n", e.what());
+  } catch (const std::exception& e) {
+    fprintf(stderr, "[RocketMQ] Warning: Unexpected error in ConsumerAck::Done: %s\n", e.what());
+  }
+}
+
 void ConsumerAck::Done(std::exception_ptr exception) {
   if (!done_called_.exchange(true)) {
+    if (callback_) {
+      callback_->onComplete(rocketmq::ConsumeStatus::RECONSUME_LATER);
+      return;
+    }
     try {
       promise_.set_exception(exception);
     } catch (const std::future_error& e) {
@@ -77,26 +137,22 @@ Napi::Value ConsumerAck::Done(const Napi::CallbackInfo& info) {
   bool ack = true;
   if (info.Length() >= 1) {
     Napi::Value ack_value = info[0];
+    if (ack_value.IsArray()) {
+      // 批量消息逐条确认：acks[i] 为真值表示第 i 条消费成功，其余（包括缺省的）稍后重新消费
+      Napi::Array ack_array = ack_value.As<Napi::Array>();
+      std::vector<bool> acks(ack_array.Length());
+      for (uint32_t i = 0; i < ack_array.Length(); i++) {
+        acks[i] = ack_array.Get(i).ToBoolean();
+      }
+      Complete(acks);
+      return info.Env().Undefined();
+    }
     if (ack_value.IsBoolean() && !ack_value.ToBoolean()) {
       ack = false;
     }
   }
 
-#if defined(ROCKETMQ_COVERAGE) || defined(ROCKETMQ_USE_STUB)
-  if (IsEnvEnabled("ROCKETMQ_STUB_CONSUMER_ACK_FORCE_FUTURE_ERROR")) {
-    try {
-      promise_.set_value(true);
-    } catch (const std::future_error&) {
-    }
-  }
-#endif
-  try {
-    promise_.set_value(ack);
-  } catch (const std::future_error& e) {
-    fprintf(stderr, "[RocketMQ] Warning: Failed to set value in ConsumerAck::Done: %s\n", e.what());
-  } catch (const std::exception& e) {
-    fprintf(stderr, "[RocketMQ] Warning: Unexpected error in ConsumerAck::Done: %s\n", e.what());
-  }
+  Complete(ack);
   return info.Env().Undefined();
 }
 
@@ -19,9 +19,13 @@
 
 #include <atomic>
 #include <future>
+#include <memory>
+#include <vector>
 
 #include <napi.h>
 
+#include <MQMessageListener.h>
+
 namespace __node_rocketmq__ {
 
 struct AddonData;
@@ -32,16 +36,26 @@ class ConsumerAck : public Napi::ObjectWrap<ConsumerAck> {
   static Napi::Object NewInstance(Napi::Env env);
 
   ConsumerAck(const Napi::CallbackInfo& info);
+  ~ConsumerAck();
 
   void SetPromise(std::promise<bool>&& promise);
+  // 异步消费模式：ack 结果直接回报给 ConsumeCallback，而不是唤醒阻塞的消费线程
+  void SetCallback(rocketmq::ConsumeCallbackPtr callback);
+  // 同步批量模式：done() 传入数组时逐条结果写到这里，再唤醒消费线程
+  void SetAcks(std::shared_ptr<std::vector<bool>> acks);
 
   void Done(std::exception_ptr exception);
 
  private:
   Napi::Value Done(const Napi::CallbackInfo& info);
 
+  void Complete(bool ack);
+  void Complete(const std::vector<bool>& acks);
+
  private:
   std::promise<bool> promise_;
+  rocketmq::ConsumeCallbackPtr callback_;
+  std::shared_ptr<std::vector<bool>> acks_;
   std::atomic<bool> done_called_{false};
 };
 
@@ -0,0 +1,751 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "lite_pull_consumer.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <napi.h>
+
+#include <ClientRPCHook.h>
+#include <LoggerConfig.h>
+#include <MQMessageQueue.h>
+
+#include "addon_data.h"
+#include "common_utils.h"
+#include "message_view.h"
+
+namespace __node_rocketmq__ {
+
+// JS 侧的队列以 { topic, brokerName, queueId } 表示
+static bool ToMessageQueue(const Napi::Value& value, rocketmq::MQMessageQueue* queue) {
+  if (!value.IsObject()) {
+    return false;
+  }
+  Napi::Object object = value.As<Napi::Object>();
+  Napi::Value topic = object.Get("topic");
+  Napi::Value broker_name = object.Get("brokerName");
+  Napi::Value queue_id = object.Get("queueId");
+  if (!topic.IsString() || !broker_name.IsString() || !queue_id.IsNumber()) {
+    return false;
+  }
+  *queue = rocketmq::MQMessageQueue(topic.As<Napi::String>(), broker_name.As<Napi::String>(),
+                                    queue_id.As<Napi::Number>().Int32Value());
+  return true;
+}
+
+static bool ToMessageQueues(const Napi::Value& value, std::vector<rocketmq::MQMessageQueue>* queues) {
+  if (!value.IsArray()) {
+    return false;
+  }
+  Napi::Array array = value.As<Napi::Array>();
+  queues->resize(array.Length());
+  for (uint32_t i = 0; i < array.Length(); i++) {
+    if (!ToMessageQueue(array.Get(i), &(*queues)[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static Napi::Object NewMessageQueue(Napi::Env env, const rocketmq::MQMessageQueue& queue) {
+  Napi::Object object = Napi::Object::New(env);
+  object.Set("topic", queue.topic());
+  object.Set("brokerName", queue.broker_name());
+  object.Set("queueId", queue.queue_id());
+  return object;
+}
+
+Napi::Object RocketMQLitePullConsumer::Init(Napi::Env env, Napi::Object exports, AddonData* addon_data) {
+  Napi::Function func = DefineClass(
+      env,
+      "RocketMQLitePullConsumer",
+      {
+          InstanceMethod<&RocketMQLitePullConsumer::Start>("start"),
+          InstanceMethod<&RocketMQLitePullConsumer::Shutdown>("shutdown"),
+          InstanceMethod<&RocketMQLitePullConsumer::Subscribe>("subscribe"),
+          InstanceMethod<&RocketMQLitePullConsumer::Assign>("assign"),
+          InstanceMethod<&RocketMQLitePullConsumer::Pause>("pause"),
+          InstanceMethod<&RocketMQLitePullConsumer::Resume>("resume"),
+          InstanceMethod<&RocketMQLitePullConsumer::Poll>("poll"),
+          InstanceMethod<&RocketMQLitePullConsumer::Seek>("seek"),
+          InstanceMethod<&RocketMQLitePullConsumer::Commit>("commit"),
+          InstanceMethod<&RocketMQLitePullConsumer::FetchMessageQueues>("fetchMessageQueues"),
+          InstanceMethod<&RocketMQLitePullConsumer::SetSessionCredentials>(
+              "setSessionCredentials"),
+      });
+
+  addon_data->lite_pull_consumer_constructor = Napi::Persistent(func);
+
+  exports.Set("LitePullConsumer", func);
+  return exports;
+}
+
+RocketMQLitePullConsumer::RocketMQLitePullConsumer(const Napi::CallbackInfo& info)
+    : Napi::ObjectWrap<RocketMQLitePullConsumer>(info), consumer_("") {
+  const Napi::Value group_name = info[0];
+  if (group_name.IsString()) {
+    consumer_.set_group_name(group_name.ToString());
+  }
+
+  const Napi::Value instance_name = info[1];
+  if (instance_name.IsString()) {
+    consumer_.set_instance_name(instance_name.ToString());
+  }
+
+  const Napi::Value options = info[2];
+  if (options.IsObject()) {
+    // try to set options
+    SetOptions(options.ToObject());
+  }
+}
+
+RocketMQLitePullConsumer::~RocketMQLitePullConsumer() {
+  SafeShutdown();
+}
+
+void RocketMQLitePullConsumer::SafeShutdown() {
+  std::lock_guard<std::mutex> lock(state_mutex_);
+
+  if (is_destroyed_.exchange(true)) {
+    return; // Already destroyed
+  }
+
+  if (is_started_.load() && !is_shutting_down_.exchange(true)) {
+    try {
+      consumer_.shutdown();
+    } catch (const std::exception& e) {
+      // Log error but don't throw in destructor
+      fprintf(stderr, "[RocketMQ] Warning: Lite pull consumer shutdown failed in destructor: %s\n", e.what());
+    } catch (...) {
+      fprintf(stderr, "[RocketMQ] Warning: Unknown error during lite pull consumer shutdown in destructor\n");
+    }
+  }
+
+  is_started_.store(false);
+}
+
+void RocketMQLitePullConsumer::SetOptions(const Napi::Object& options) {
+  // set name server
+  Napi::Value name_server = options.Get("nameServer");
+  if (name_server.IsString()) {
+    consumer_.set_namesrv_addr(name_server.ToString());
+  }
+
+  // set group name
+  Napi::Value group_name = options.Get("groupName");
+  if (group_name.IsString()) {
+    consumer_.set_group_name(group_name.ToString());
+  }
+
+  // 每次向 broker 拉取的最大消息数
+  Napi::Value pull_batch_size = options.Get("pullBatchSize");
+  if (pull_batch_size.IsNumber()) {
+    consumer_.set_pull_batch_size(pull_batch_size.ToNumber());
+  }
+
+  Napi::Value pull_thread_nums = options.Get("pullThreadNums");
+  if (pull_thread_nums.IsNumber()) {
+    consumer_.set_pull_thread_nums(pull_thread_nums.ToNumber());
+  }
+
+  // 为 false 时需要调用 commit() 手动提交已 poll 到的位点
+  Napi::Value auto_commit = options.Get("autoCommit");
+  if (auto_commit.IsBoolean()) {
+    consumer_.setAutoCommit(auto_commit.ToBoolean());
+  }
+
+  Napi::Value auto_commit_interval = options.Get("autoCommitIntervalMillis");
+  if (auto_commit_interval.IsNumber()) {
+    consumer_.set_auto_commit_interval_millis(auto_commit_interval.ToNumber().Int64Value());
+  }
+
+  // poll() 未指定超时时间时使用的默认值
+  Napi::Value poll_timeout = options.Get("pollTimeoutMillis");
+  if (poll_timeout.IsNumber()) {
+    consumer_.set_poll_timeout_millis(poll_timeout.ToNumber().Int64Value());
+  }
+
+  // 一次 poll 最多返回的消息条数和 body 字节数，可以跨多个队列凑成一批
+  Napi::Value poll_batch_max_size = options.Get("pollBatchMaxSize");
+  if (poll_batch_max_size.IsNumber()) {
+    consumer_.set_poll_batch_max_size(poll_batch_max_size.ToNumber());
+  }
+
+  Napi::Value poll_batch_max_bytes = options.Get("pollBatchMaxBytes");
+  if (poll_batch_max_bytes.IsNumber()) {
+    consumer_.set_poll_batch_max_bytes(poll_batch_max_bytes.ToNumber());
+  }
+
+  // pullThresholdForAll 和 pullThresholdSizeForAll 限制等待 poll 的消息总量，超过后暂停拉取
+  Napi::Value pull_threshold_for_all = options.Get("pullThresholdForAll");
+  if (pull_threshold_for_all.IsNumber()) {
+    consumer_.set_pull_threshold_for_all(pull_threshold_for_all.ToNumber().Int64Value());
+  }
+
+  // 按字节数限制每个队列以及整个 consumer 缓存的消息，避免大消息撑爆内存（单位 MiB）
+  Napi::Value pull_threshold_size_for_queue = options.Get("pullThresholdSizeForQueue");
+  if (pull_threshold_size_for_queue.IsNumber()) {
+    consumer_.set_pull_threshold_size_for_queue(pull_threshold_size_for_queue.ToNumber());
+  }
+
+  Napi::Value pull_threshold_size_for_all = options.Get("pullThresholdSizeForAll");
+  if (pull_threshold_size_for_all.IsNumber()) {
+    consumer_.set_pull_threshold_size_for_all(pull_threshold_size_for_all.ToNumber());
+  }
+
+  Napi::Value consume_max_span = options.Get("consumeMaxSpan");
+  if (consume_max_span.IsNumber()) {
+    consumer_.set_consume_max_span(consume_max_span.ToNumber());
+  }
+
+  // binaryHeader 为 true 时请求头使用 ROCKETMQ 二进制编码，省去 JSON 序列化
+  Napi::Value binary_header = options.Get("binaryHeader");
+  if (binary_header.IsBoolean() && binary_header.ToBoolean()) {
+    consumer_.set_serialize_type(rocketmq::SerializeType::ROCKETMQ);
+  }
+
+  // binaryBody 为 true 时 body 以 Buffer 交付，避免 UTF-8 转码
+  Napi::Value binary_body = options.Get("binaryBody");
+  binary_ = binary_body.IsBoolean() && binary_body.ToBoolean();
+
+  // lazyMessage 为 true 时交付 MessageView，只有被访问的字段才会创建 JS 值
+  Napi::Value lazy_message = options.Get("lazyMessage");
+  lazy_ = lazy_message.IsBoolean() && lazy_message.ToBoolean();
+
+  // 使用通用的日志配置函数
+  utils::SetLoggerOptions(options);
+}
+
+Napi::Value RocketMQLitePullConsumer::SetSessionCredentials(
+    const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  // 使用通用的参数验证函数
+  if (!utils::ValidateStringArguments(info, 3, "All arguments must be strings")) {
+    return env.Undefined();
+  }
+
+  Napi::String access_key = info[0].As<Napi::String>();
+  Napi::String secret_key = info[1].As<Napi::String>();
+  Napi::String ons_channel = info[2].As<Napi::String>();
+
+  auto rpc_hook = std::make_shared<rocketmq::ClientRPCHook>(
+      rocketmq::SessionCredentials(access_key, secret_key, ons_channel));
+  consumer_.setRPCHook(rpc_hook);
+
+  return env.Undefined();
+}
+
+bool RocketMQLitePullConsumer::CheckRunning(Napi::Env env) {
+  std::lock_guard<std::mutex> lock(state_mutex_);
+  if (is_destroyed_.load()) {
+    Napi::Error::New(env, "Consumer has been destroyed").ThrowAsJavaScriptException();
+    return false;
+  }
+
+  if (!is_started_.load()) {
+    Napi::Error::New(env, "Consumer is not started").ThrowAsJavaScriptException();
+    return false;
+  }
+
+  if (is_shutting_down_.load()) {
+    Napi::Error::New(env, "Consumer is shutting down").ThrowAsJavaScriptException();
+    return false;
+  }
+  return true;
+}
+
+class LitePullConsumerStartWorker : public Napi::AsyncWorker {
+ public:
+  LitePullConsumerStartWorker(const Napi::Function& callback,
+                              RocketMQLitePullConsumer* wrapper)
+      : Napi::AsyncWorker(callback),
+        wrapper_ref_(Napi::Persistent(wrapper->Value())),
+        consumer_(&wrapper->consumer_),
+        wrapper_(wrapper) {}
+
+  void Execute() override {
+    // 在整个操作期间持有锁以避免竞态条件
+    std::lock_guard<std::mutex> lock(wrapper_->state_mutex_);
+
+    if (wrapper_->is_destroyed_.load()) {
+      SetError("Consumer has been destroyed");
+      return;
+    }
+
+    if (wrapper_->is_started_.load()) {
+      SetError("Consumer is already started");
+      return;
+    }
+
+    if (wrapper_->is_shutting_down_.load()) {
+      SetError("Consumer is shutting down");
+      return;
+    }
+
+    try {
+      consumer_->start();
+      wrapper_->is_started_.store(true);
+    } catch (const std::exception& e) {
+      SetError(e.what());
+    }
+  }
+
+ private:
+  Napi::ObjectReference wrapper_ref_;
+  rocketmq::DefaultLitePullConsumer* consumer_;
+  RocketMQLitePullConsumer* wrapper_;
+};
+
+Napi::Value RocketMQLitePullConsumer::Start(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  // 使用通用的回调验证函数
+  if (!utils::ValidateCallback(info, 0, "Function expected as first argument")) {
+    return env.Undefined();
+  }
+
+  Napi::Function callback = info[0].As<Napi::Function>();
+
+  auto* worker = new LitePullConsumerStartWorker(callback, this);
+  worker->Queue();
+  return env.Undefined();
+}
+
+class LitePullConsumerShutdownWorker : public Napi::AsyncWorker {
+ public:
+  LitePullConsumerShutdownWorker(const Napi::Function& callback,
+                                 RocketMQLitePullConsumer* wrapper)
+      : Napi::AsyncWorker(callback),
+        wrapper_ref_(Napi::Persistent(wrapper->Value())),
+        consumer_(&wrapper->consumer_),
+        wrapper_(wrapper) {}
+
+  void Execute() override {
+    // 在整个操作期间持有锁以避免竞态条件
+    std::lock_guard<std::mutex> lock(wrapper_->state_mutex_);
+
+    if (wrapper_->is_destroyed_.load()) {
+      SetError("Consumer has been destroyed");
+      return;
+    }
+
+    if (!wrapper_->is_started_.load()) {
+      SetError("Consumer is not started");
+      return;
+    }
+
+    if (wrapper_->is_shutting_down_.exchange(true)) {
+      SetError("Consumer is already shutting down");
+      return;
+    }
+
+    try {
+      consumer_->shutdown();
+      wrapper_->is_started_.store(false);
+      wrapper_->is_shutting_down_.store(false); // Reset shutdown flag after successful shutdown
+    } catch (const std::exception& e) {
+      wrapper_->is_shutting_down_.store(false); // Reset on error
+      SetError(e.what());
+    }
+  }
+
+ private:
+  Napi::ObjectReference wrapper_ref_;
+  rocketmq::DefaultLitePullConsumer* consumer_;
+  RocketMQLitePullConsumer* wrapper_;
+};
+
+Napi::Value RocketMQLitePullConsumer::Shutdown(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  // 使用通用的回调验证函数
+  if (!utils::ValidateCallback(info, 0, "Function expected as first argument")) {
+    return env.Undefined();
+  }
+
+  Napi::Function callback = info[0].As<Napi::Function>();
+
+  auto* worker = new LitePullConsumerShutdownWorker(callback, this);
+  worker->Queue();
+  return env.Undefined();
+}
+
+Napi::Value RocketMQLitePullConsumer::Subscribe(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  // Check if required parameters are provided FIRST (before state checks)
+  if (info.Length() < 2) {
+    Napi::TypeError::New(env, "Wrong number of arguments").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (!info[0].IsString() || !info[1].IsString()) {
+    Napi::TypeError::New(env, "Topic and expression must be strings").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  // Check if consumer is in valid state AFTER parameter validation
+  {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    if (is_destroyed_.load()) {
+      Napi::Error::New(env, "Consumer has been destroyed").ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+
+    if (is_shutting_down_.load()) {
+      Napi::Error::New(env, "Consumer is shutting down").ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+  }
+
+  Napi::String topic = info[0].As<Napi::String>();
+  Napi::String expression = info[1].As<Napi::String>();
+
+  try {
+    consumer_.subscribe(topic, expression);
+  } catch (const std::exception& e) {
+    Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return env.Undefined();
+}
+
+Napi::Value RocketMQLitePullConsumer::Assign(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  std::vector<rocketmq::MQMessageQueue> queues;
+  if (!ToMessageQueues(info[0], &queues)) {
+    Napi::TypeError::New(env, "Message queues must be an array of { topic, brokerName, queueId }")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    if (is_destroyed_.load()) {
+      Napi::Error::New(env, "Consumer has been destroyed").ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+
+    if (is_shutting_down_.load()) {
+      Napi::Error::New(env, "Consumer is shutting down").ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+  }
+
+  try {
+    consumer_.assign(queues);
+  } catch (const std::exception& e) {
+    Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+  }
+  return env.Undefined();
+}
+
+Napi::Value RocketMQLitePullConsumer::Pause(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  std::vector<rocketmq::MQMessageQueue> queues;
+  if (!ToMessageQueues(info[0], &queues)) {
+    Napi::TypeError::New(env, "Message queues must be an array of { topic, brokerName, queueId }")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    if (is_destroyed_.load()) {
+      Napi::Error::New(env, "Consumer has been destroyed").ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+
+    if (is_shutting_down_.load()) {
+      Napi::Error::New(env, "Consumer is shutting down").ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+  }
+
+  try {
+    consumer_.pause(queues);
+  } catch (const std::exception& e) {
+    Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+  }
+  return env.Undefined();
+}
+
+Napi::Value RocketMQLitePullConsumer::Resume(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  std::vector<rocketmq::MQMessageQueue> queues;
+  if (!ToMessageQueues(info[0], &queues)) {
+    Napi::TypeError::New(env, "Message queues must be an array of { topic, brokerName, queueId }")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    if (is_destroyed_.load()) {
+      Napi::Error::New(env, "Consumer has been destroyed").ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+
+    if (is_shutting_down_.load()) {
+      Napi::Error::New(env, "Consumer is shutting down").ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+  }
+
+  try {
+    consumer_.resume(queues);
+  } catch (const std::exception& e) {
+    Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+  }
+  return env.Undefined();
+}
+
+// 在工作线程执行、以 Promise 回报结果的操作的公共部分
+class LitePullConsumerPromiseWorker : public Napi::AsyncWorker {
+ public:
+  LitePullConsumerPromiseWorker(Napi::Env env, const Napi::Object& wrapper, rocketmq::DefaultLitePullConsumer* consumer)
+      : Napi::AsyncWorker(env),
+        deferred_(Napi::Promise::Deferred::New(env)),
+        wrapper_ref_(Napi::Persistent(wrapper)),
+        consumer_(consumer) {}
+
+  Napi::Promise Promise() const { return deferred_.Promise(); }
+
+ protected:
+  void OnOK() override { deferred_.Resolve(Env().Undefined()); }
+
+  void OnError(const Napi::Error& error) override { deferred_.Reject(error.Value()); }
+
+  Napi::Promise::Deferred deferred_;
+  Napi::ObjectReference wrapper_ref_;
+  rocketmq::DefaultLitePullConsumer* consumer_;
+};
+
+class LitePullConsumerPollWorker : public LitePullConsumerPromiseWorker {
+ public:
+  LitePullConsumerPollWorker(Napi::Env env,
+                             RocketMQLitePullConsumer* wrapper,
+                             long timeout)
+      : LitePullConsumerPromiseWorker(env, wrapper->Value(), &wrapper->consumer_),
+        wrapper_(wrapper),
+        timeout_(timeout),
+        binary_(wrapper->binary_),
+        lazy_(wrapper->lazy_) {}
+
+  void Execute() override {
+    try {
+      // 阻塞等待直到拿到一批消息或超时，期间不占用 JS 线程
+      messages_ = timeout_ < 0 ? consumer_->poll() : consumer_->poll(timeout_);
+    } catch (const std::exception& e) {
+      SetError(e.what());
+    }
+  }
+
+ protected:
+  void OnOK() override {
+    wrapper_->is_polling_.store(false);
+    Napi::Env env = Env();
+    Napi::HandleScope scope(env);
+    Napi::Array messages = Napi::Array::New(env, messages_.size());
+    for (size_t i = 0; i < messages_.size(); i++) {
+      messages.Set(static_cast<uint32_t>(i), NewConsumedMessage(env, messages_[i], binary_, lazy_));
+    }
+    deferred_.Resolve(messages);
+  }
+
+  void OnError(const Napi::Error& error) override {
+    wrapper_->is_polling_.store(false);
+    LitePullConsumerPromiseWorker::OnError(error);
+  }
+
+ private:
+  RocketMQLitePullConsumer* wrapper_;
+  long timeout_;
+  bool binary_;
+  bool lazy_;
+  std::vector<rocketmq::MQMessageExt> messages_;
+};
+
+Napi::Value RocketMQLitePullConsumer::Poll(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  // 未指定超时时间时使用 pollTimeoutMillis
+  long timeout = -1;
+  if (info.Length() > 0 && !info[0].IsUndefined()) {
+    if (!info[0].IsNumber()) {
+      Napi::TypeError::New(env, "Timeout must be a number").ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+    timeout = static_cast<long>(info[0].As<Napi::Number>().Int64Value());
+    if (timeout < 0) {
+      timeout = 0;
+    }
+  }
+
+  if (!CheckRunning(env)) {
+    return env.Undefined();
+  }
+
+  // 等待中的 poll 会一直占用一个 libuv 线程池线程（默认共 4 个），每个消费者同时只允许一个，
+  // 避免并发 poll 耗尽线程池、阻塞其他异步操作；并发 poll 本来也只是瓜分同一批消息
+  if (is_polling_.exchange(true)) {
+    Napi::Error::New(env, "Consumer is already polling").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  auto* worker = new LitePullConsumerPollWorker(env, this, timeout);
+  Napi::Promise promise = worker->Promise();
+  worker->Queue();
+  return promise;
+}
+
+class LitePullConsumerSeekWorker : public LitePullConsumerPromiseWorker {
+ public:
+  LitePullConsumerSeekWorker(Napi::Env env,
+                             const Napi::Object& wrapper,
+                             rocketmq::DefaultLitePullConsumer* consumer,
+                             const rocketmq::MQMessageQueue& queue,
+                             int64_t offset)
+      : LitePullConsumerPromiseWorker(env, wrapper, consumer), queue_(queue), offset_(offset) {}
+
+  void Execute() override {
+    try {
+      consumer_->seek(queue_, offset_);
+    } catch (const std::exception& e) {
+      SetError(e.what());
+    }
+  }
+
+ private:
+  rocketmq::MQMessageQueue queue_;
+  int64_t offset_;
+};
+
+Napi::Value RocketMQLitePullConsumer::Seek(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  rocketmq::MQMessageQueue queue;
+  if (!ToMessageQueue(info[0], &queue)) {
+    Napi::TypeError::New(env, "Message queue must be { topic, brokerName, queueId }").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (!info[1].IsNumber()) {
+    Napi::TypeError::New(env, "Offset must be a number").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  int64_t offset = info[1].As<Napi::Number>().Int64Value();
+
+  if (!CheckRunning(env)) {
+    return env.Undefined();
+  }
+
+  auto* worker = new LitePullConsumerSeekWorker(env, Value(), &consumer_, queue, offset);
+  Napi::Promise promise = worker->Promise();
+  worker->Queue();
+  return promise;
+}
+
+class LitePullConsumerCommitWorker : public LitePullConsumerPromiseWorker {
+ public:
+  using LitePullConsumerPromiseWorker::LitePullConsumerPromiseWorker;
+
+  void Execute() override {
+    try {
+      consumer_->commitSync();
+    } catch (const std::exception& e) {
+      SetError(e.what());
+    }
+  }
+};
+
+Napi::Value RocketMQLitePullConsumer::Commit(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!CheckRunning(env)) {
+    return env.Undefined();
+  }
+
+  auto* worker = new LitePullConsumerCommitWorker(env, Value(), &consumer_);
+  Napi::Promise promise = worker->Promise();
+  worker->Queue();
+  return promise;
+}
+
+class LitePullConsumerFetchQueuesWorker : public LitePullConsumerPromiseWorker {
+ public:
+  LitePullConsumerFetchQueuesWorker(Napi::Env env,
+                                    const Napi::Object& wrapper,
+                                    rocketmq::DefaultLitePullConsumer* consumer,
+                                    const std::string& topic)
+      : LitePullConsumerPromiseWorker(env, wrapper, consumer), topic_(topic) {}
+
+  void Execute() override {
+    try {
+      queues_ = consumer_->fetchMessageQueues(topic_);
+    } catch (const std::exception& e) {
+      SetError(e.what());
+    }
+  }
+
+ protected:
+  void OnOK() override {
+    Napi::Env env = Env();
+    Napi::HandleScope scope(env);
+    Napi::Array queues = Napi::Array::New(env, queues_.size());
+    for (size_t i = 0; i < queues_.size(); i++) {
+      queues.Set(static_cast<uint32_t>(i), NewMessageQueue(env, queues_[i]));
+    }
+    deferred_.Resolve(queues);
+  }
+
+ private:
+  std::string topic_;
+  std::vector<rocketmq::MQMessageQueue> queues_;
+};
+
+Napi::Value RocketMQLitePullConsumer::FetchMessageQueues(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || !info[0].IsString()) {
+    Napi::TypeError::New(env, "Topic must be a string").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  std::string topic = info[0].As<Napi::String>();
+
+  if (!CheckRunning(env)) {
+    return env.Undefined();
+  }
+
+  auto* worker = new LitePullConsumerFetchQueuesWorker(env, Value(), &consumer_, topic);
+  Napi::Promise promise = worker->Promise();
+  worker->Queue();
+  return promise;
+}
+
+}  // namespace __node_rocketmq__
@@ -0,0 +1,86 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __ROCKETMQ_LITE_PULL_CONSUMER_H__
+#define __ROCKETMQ_LITE_PULL_CONSUMER_H__
+
+#include <string>
+#include <atomic>
+#include <mutex>
+
+#include <napi.h>
+
+#include <DefaultLitePullConsumer.h>
+
+namespace __node_rocketmq__ {
+
+struct AddonData;
+class LitePullConsumerStartWorker;
+class LitePullConsumerShutdownWorker;
+class LitePullConsumerPollWorker;
+
+class RocketMQLitePullConsumer : public Napi::ObjectWrap<RocketMQLitePullConsumer> {
+  friend class LitePullConsumerStartWorker;
+  friend class LitePullConsumerShutdownWorker;
+  friend class LitePullConsumerPollWorker;
+ public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports, AddonData* addon_data);
+
+  RocketMQLitePullConsumer(const Napi::CallbackInfo& info);
+  ~RocketMQLitePullConsumer();
+
+ private:
+  Napi::Value SetSessionCredentials(const Napi::CallbackInfo& info);
+
+  Napi::Value Start(const Napi::CallbackInfo& info);
+  Napi::Value Shutdown(const Napi::CallbackInfo& info);
+
+  Napi::Value Subscribe(const Napi::CallbackInfo& info);
+  Napi::Value Assign(const Napi::CallbackInfo& info);
+  Napi::Value Pause(const Napi::CallbackInfo& info);
+  Napi::Value Resume(const Napi::CallbackInfo& info);
+
+  // 以下操作会访问网络或阻塞等待，均在工作线程执行并返回 Promise
+  Napi::Value Poll(const Napi::CallbackInfo& info);
+  Napi::Value Seek(const Napi::CallbackInfo& info);
+  Napi::Value Commit(const Napi::CallbackInfo& info);
+  Napi::Value FetchMessageQueues(const Napi::CallbackInfo& info);
+
+ private:
+  void SetOptions(const Napi::Object& options);
+  void SafeShutdown();
+  // 运行中才允许 poll/seek/commit，否则抛出 JS 异常并返回 false
+  bool CheckRunning(Napi::Env env);
+
+ private:
+  rocketmq::DefaultLitePullConsumer consumer_;
+  // 为 true 时 body 以 Buffer 形式交给 JS
+  bool binary_ = false;
+  // 为 true 时以 MessageView 交付，字段按需转换
+  bool lazy_ = false;
+  std::atomic<bool> is_started_{false};
+  std::atomic<bool> is_shutting_down_{false};
+  std::atomic<bool> is_destroyed_{false};
+  // 有 poll 在等待时为 true，只在 JS 线程读写
+  std::atomic<bool> is_polling_{false};
+  // state_mutex_ 用于保护状态转换的原子性
+  // 注意：start()/shutdown() 期间会持有锁，调用方应避免在回调中访问状态
+  mutable std::mutex state_mutex_;
+};
+
+}  // namespace __node_rocketmq__
+
+#endif
@@ -0,0 +1,193 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "message_view.h"
+
+#include <napi.h>
+
+#include "addon_data.h"
+#include "common_utils.h"
+
+namespace __node_rocketmq__ {
+
+Napi::Value NewMessageBody(Napi::Env env, const rocketmq::MQMessageExt& msg, bool binary) {
+  if (!binary) {
+    return Napi::String::New(env, msg.body());
+  }
+
+  // body 与重投、回发 broker 的消息共享同一份内存，必须拷贝给 JS，防止 handler 改写 Buffer 污染重投内容
+  const std::string& body = msg.body();
+  return Napi::Buffer<char>::Copy(env, body.data(), body.size());
+}
+
+Napi::Object NewConsumedMessage(Napi::Env env, const rocketmq::MQMessageExt& msg, bool binary, bool lazy) {
+  if (lazy) {
+    return MessageView::NewInstance(env, msg, binary);
+  }
+
+  Napi::Object message = Napi::Object::New(env);
+  message.Set("topic", msg.topic());
+  message.Set("tags", msg.tags());
+  message.Set("keys", msg.keys());
+  message.Set("body", NewMessageBody(env, msg, binary));
+  message.Set("msgId", msg.msg_id());
+  return message;
+}
+
+Napi::Object MessageView::Init(Napi::Env env, Napi::Object exports, AddonData* addon_data) {
+  Napi::Function func = DefineClass(
+      env, "MessageView",
+      {InstanceAccessor<&MessageView::GetTopic>("topic"),
+       InstanceAccessor<&MessageView::GetTags>("tags"),
+       InstanceAccessor<&MessageView::GetKeys>("keys"),
+       InstanceAccessor<&MessageView::GetBody>("body"),
+       InstanceAccessor<&MessageView::GetMsgId>("msgId"),
+       InstanceAccessor<&MessageView::GetProperties>("properties"),
+       InstanceAccessor<&MessageView::GetQueueId>("queueId"),
+       InstanceAccessor<&MessageView::GetQueueOffset>("queueOffset"),
+       InstanceAccessor<&MessageView::GetBornTimestamp>("bornTimestamp"),
+       InstanceAccessor<&MessageView::GetStoreTimestamp>("storeTimestamp"),
+       InstanceAccessor<&MessageView::GetReconsumeTimes>("reconsumeTimes"),
+       InstanceMethod<&MessageView::ToJSON>("toJSON")});
+
+  addon_data->message_view_constructor = Napi::Persistent(func);
+
+  exports.Set("MessageView", func);
+  return exports;
+}
+
+Napi::Object MessageView::NewInstance(Napi::Env env, const rocketmq::MQMessageExt& msg, bool binary) {
+  AddonData* addon_data = GetAddonData(env);
+  if (addon_data == nullptr) {
+    Napi::Error::New(env, "MessageView constructor not initialized").ThrowAsJavaScriptException();
+    return Napi::Object();
+  }
+
+  Napi::Object object = addon_data->message_view_constructor.New({});
+  MessageView* view = MessageView::Unwrap(object);
+  view->message_ = msg;
+  view->binary_ = binary;
+  return object;
+}
+
+MessageView::MessageView(const Napi::CallbackInfo& info)
+    : Napi::ObjectWrap<MessageView>(info), binary_(false) {}
+
+Napi::Value MessageView::Cached(Napi::Env env, const char* key) {
+  if (cache_.IsEmpty()) {
+    cache_ = Napi::Persistent(Napi::Object::New(env));
+    return Napi::Value();
+  }
+  Napi::Value value = cache_.Value().Get(key);
+  return value.IsUndefined() ? Napi::Value() : value;
+}
+
+Napi::Value MessageView::Cache(const char* key, Napi::Value value) {
+  cache_.Value().Set(key, value);
+  return value;
+}
+
+Napi::Value MessageView::GetTopic(const Napi::CallbackInfo& info) {
+  Napi::Value cached = Cached(info.Env(), "topic");
+  if (!cached.IsEmpty()) {
+    return cached;
+  }
+  return Cache("topic", Napi::String::New(info.Env(), message_.topic()));
+}
+
+Napi::Value MessageView::GetTags(const Napi::CallbackInfo& info) {
+  Napi::Value cached = Cached(info.Env(), "tags");
+  if (!cached.IsEmpty()) {
+    return cached;
+  }
+  return Cache("tags", Napi::String::New(info.Env(), message_.tags()));
+}
+
+Napi::Value MessageView::GetKeys(const Napi::CallbackInfo& info) {
+  Napi::Value cached = Cached(info.Env(), "keys");
+  if (!cached.IsEmpty()) {
+    return cached;
+  }
+  return Cache("keys", Napi::String::New(info.Env(), message_.keys()));
+}
+
+Napi::Value MessageView::GetBody(const Napi::CallbackInfo& info) {
+  Napi::Value cached = Cached(info.Env(), "body");
+  if (!cached.IsEmpty()) {
+    return cached;
+  }
+  return Cache("body", NewMessageBody(info.Env(), message_, binary_));
+}
+
+Napi::Value MessageView::GetMsgId(const Napi::CallbackInfo& info) {
+  Napi::Value cached = Cached(info.Env(), "msgId");
+  if (!cached.IsEmpty()) {
+    return cached;
+  }
+  return Cache("msgId", Napi::String::New(info.Env(), message_.msg_id()));
+}
+
+Napi::Value MessageView::GetProperties(const Napi::CallbackInfo& info) {
+  Napi::Value cached = Cached(info.Env(), "properties");
+  if (!cached.IsEmpty()) {
+    return cached;
+  }
+  Napi::Object properties = Napi::Object::New(info.Env());
+  for (const auto& entry : message_.properties()) {
+    properties.Set(entry.first, entry.second);
+  }
+  return Cache("properties", properties);
+}
+
+Napi::Value MessageView::GetQueueId(const Napi::CallbackInfo& info) {
+  return Napi::Number::New(info.Env(), message_.queue_id());
+}
+
+Napi::Value MessageView::GetQueueOffset(const Napi::CallbackInfo& info) {
+  return Napi::Number::New(info.Env(), static_cast<double>(message_.queue_offset()));
+}
+
+Napi::Value MessageView::GetBornTimestamp(const Napi::CallbackInfo& info) {
+  return Napi::Number::New(info.Env(), static_cast<double>(message_.born_timestamp()));
+}
+
+Napi::Value MessageView::GetStoreTimestamp(const Napi::CallbackInfo& info) {
+  return Napi::Number::New(info.Env(), static_cast<double>(message_.store_timestamp()));
+}
+
+Napi::Value MessageView::GetReconsumeTimes(const Napi::CallbackInfo& info) {
+  return Napi::Number::New(info.Env(), message_.reconsume_times());
+}
+
+// 访问器定义在原型上，JSON.stringify 和日志输出需要显式展开
+Napi::Value MessageView::ToJSON(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::Object json = Napi::Object::New(env);
+  json.Set("topic", GetTopic(info));
+  json.Set("tags", GetTags(info));
+  json.Set("keys", GetKeys(info));
+  json.Set("body", GetBody(info));
+  json.Set("msgId", GetMsgId(info));
+  json.Set("properties", GetProperties(info));
+  json.Set("queueId", GetQueueId(info));
+  json.Set("queueOffset", GetQueueOffset(info));
+  json.Set("bornTimestamp", GetBornTimestamp(info));
+  json.Set("storeTimestamp", GetStoreTimestamp(info));
+  json.Set("reconsumeTimes", GetReconsumeTimes(info));
+  return json;
+}
+
+}  // namespace __node_rocketmq__
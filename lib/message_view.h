@@ -0,0 +1,71 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __ROCKETMQ_MESSAGE_VIEW_H__
+#define __ROCKETMQ_MESSAGE_VIEW_H__
+
+#include <napi.h>
+
+#include <MQMessageListener.h>
+
+namespace __node_rocketmq__ {
+
+struct AddonData;
+
+// 构造消息 body：binary 为 true 时返回 body 的 Buffer 副本，否则返回字符串
+Napi::Value NewMessageBody(Napi::Env env, const rocketmq::MQMessageExt& msg, bool binary);
+
+// 构造交给 JS 的消费消息：lazy 为 true 时返回 MessageView，否则返回普通对象
+Napi::Object NewConsumedMessage(Napi::Env env, const rocketmq::MQMessageExt& msg, bool binary, bool lazy);
+
+// 消费消息的惰性视图，字段只在 JS 访问时才转换成 JS 值
+class MessageView : public Napi::ObjectWrap<MessageView> {
+ public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports, AddonData* addon_data);
+  static Napi::Object NewInstance(Napi::Env env, const rocketmq::MQMessageExt& msg, bool binary);
+
+  MessageView(const Napi::CallbackInfo& info);
+
+ private:
+  Napi::Value GetTopic(const Napi::CallbackInfo& info);
+  Napi::Value GetTags(const Napi::CallbackInfo& info);
+  Napi::Value GetKeys(const Napi::CallbackInfo& info);
+  Napi::Value GetBody(const Napi::CallbackInfo& info);
+  Napi::Value GetMsgId(const Napi::CallbackInfo& info);
+  Napi::Value GetProperties(const Napi::CallbackInfo& info);
+  Napi::Value GetQueueId(const Napi::CallbackInfo& info);
+  Napi::Value GetQueueOffset(const Napi::CallbackInfo& info);
+  Napi::Value GetBornTimestamp(const Napi::CallbackInfo& info);
+  Napi::Value GetStoreTimestamp(const Napi::CallbackInfo& info);
+  Napi::Value GetReconsumeTimes(const Napi::CallbackInfo& info);
+  Napi::Value ToJSON(const Napi::CallbackInfo& info);
+
+  // 读取/写入首次访问时创建的 JS 值，未缓存时返回空值
+  Napi::Value Cached(Napi::Env env, const char* key);
+  Napi::Value Cache(const char* key, Napi::Value value);
+
+ private:
+  // MQMessageExt 只是共享实现的句柄，拷贝不会复制消息内容
+  rocketmq::MQMessageExt message_;
+  bool binary_;
+  // 保证 msg.body === msg.body，且字符串和属性不会重复转换。
+  // 较旧的 Node-API 不能对原始值建立引用，因此统一存放在一个普通对象里
+  Napi::ObjectReference cache_;
+};
+
+}  // namespace __node_rocketmq__
+
+#endif
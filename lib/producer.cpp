@@ -21,6 +21,7 @@
 #include <cstdlib>
 #include <exception>
 #include <string>
+#include <vector>
 
 #include <napi.h>
 
@@ -32,6 +33,8 @@
 
 #include "addon_data.h"
 #include "common_utils.h"
+#include "send_accumulator.h"
+#include "send_completion_queue.h"
 
 namespace __node_rocketmq__ {
 
@@ -43,6 +46,9 @@ Napi::Object RocketMQProducer::Init(Napi::Env env, Napi::Object exports, AddonDa
                       InstanceMethod<&RocketMQProducer::Start>("start"),
                       InstanceMethod<&RocketMQProducer::Shutdown>("shutdown"),
                       InstanceMethod<&RocketMQProducer::Send>("send"),
+                      InstanceMethod<&RocketMQProducer::SendAsync>("sendAsync"),
+                      InstanceMethod<&RocketMQProducer::SendMany>("sendMany"),
+                      InstanceMethod<&RocketMQProducer::SendBatch>("sendBatch"),
                       InstanceMethod<&RocketMQProducer::SetSessionCredentials>(
                           "setSessionCredentials"),
                   });
@@ -55,6 +61,8 @@ Napi::Object RocketMQProducer::Init(Napi::Env env, Napi::Object exports, AddonDa
 
 RocketMQProducer::RocketMQProducer(const Napi::CallbackInfo& info)
     : Napi::ObjectWrap<RocketMQProducer>(info), producer_("") {
+  completions_ = SendCompletionQueue::New(info.Env(), info.This().As<Napi::Object>());
+
   const Napi::Value group_name = info[0];
   if (group_name.IsString()) {
     producer_.set_group_name(group_name.ToString());
@@ -74,6 +82,7 @@ RocketMQProducer::RocketMQProducer(const Napi::CallbackInfo& info)
 
 RocketMQProducer::~RocketMQProducer() {
   SafeShutdown();
+  completions_->Close();
 }
 
 void RocketMQProducer::SafeShutdown() {
@@ -85,6 +94,9 @@ void RocketMQProducer::SafeShutdown() {
   
   if (is_started_.load() && !is_shutting_down_.exchange(true)) {
     try {
+      if (accumulator_) {
+        accumulator_->Flush();
+      }
       producer_.shutdown();
     } catch (const std::exception& e) {
       // Log error but don't throw in destructor
@@ -122,12 +134,58 @@ void RocketMQProducer::SetOptions(const Napi::Object& options) {
     producer_.set_compress_level(compress_level.ToNumber());
   }
 
+  // compressionType 选择压缩超过阈值的消息体所用的算法，zstd/lz4 需要客户端编译时开启
+  Napi::Value compression_type = options.Get("compressionType");
+  if (!compression_type.IsUndefined()) {
+    std::string name = compression_type.IsString() ? compression_type.As<Napi::String>().Utf8Value() : "";
+    rocketmq::CompressionType type;
+    if (name == "zlib") {
+      type = rocketmq::CompressionType::ZLIB;
+    } else if (name == "zstd") {
+      type = rocketmq::CompressionType::ZSTD;
+    } else if (name == "lz4") {
+      type = rocketmq::CompressionType::LZ4;
+    } else {
+      Napi::TypeError::New(Env(), "compressionType must be one of 'zlib', 'zstd', 'lz4'").ThrowAsJavaScriptException();
+      return;
+    }
+    // 核心会忽略未编译进来的算法，构造时就报错，避免等到第一条大消息才发现
+    producer_.set_compression_type(type);
+    if (producer_.compression_type() != type) {
+      Napi::Error::New(Env(), "compressionType '" + name + "' is not available in this build").ThrowAsJavaScriptException();
+      return;
+    }
+  }
+
   // set send message timeout
   Napi::Value send_message_timeout = options.Get("sendMessageTimeout");
   if (send_message_timeout.IsNumber()) {
     producer_.set_send_msg_timeout(send_message_timeout.ToNumber());
   }
 
+  // binaryHeader 为 true 时请求头使用 ROCKETMQ 二进制编码，省去 JSON 序列化
+  Napi::Value binary_header = options.Get("binaryHeader");
+  if (binary_header.IsBoolean() && binary_header.ToBoolean()) {
+    producer_.set_serialize_type(rocketmq::SerializeType::ROCKETMQ);
+  }
+
+  // lingerMs > 0 时开启客户端攒批，同一 topic 的消息最多等待 lingerMs 后合并发送
+  Napi::Value linger_ms = options.Get("lingerMs");
+  if (linger_ms.IsNumber() && linger_ms.ToNumber().Int64Value() > 0) {
+    size_t batch_bytes = config::DEFAULT_BATCH_BYTES;
+    Napi::Value batch_bytes_v = options.Get("batchBytes");
+    if (batch_bytes_v.IsNumber() && batch_bytes_v.ToNumber().Int64Value() > 0) {
+      batch_bytes = static_cast<size_t>(batch_bytes_v.ToNumber().Int64Value());
+    }
+    // 攒出的批量消息同样受 maxMessageSize 限制
+    int max_message_size = producer_.max_message_size();
+    if (max_message_size > 0 && batch_bytes > static_cast<size_t>(max_message_size)) {
+      batch_bytes = static_cast<size_t>(max_message_size);
+    }
+    accumulator_.reset(new SendAccumulator(
+        &producer_, std::chrono::milliseconds(linger_ms.ToNumber().Int64Value()), batch_bytes));
+  }
+
   // 使用通用的日志配置函数
   utils::SetLoggerOptions(options);
 }
@@ -238,6 +296,9 @@ class ProducerShutdownWorker : public Napi::AsyncWorker {
     }
     
     try {
+      if (wrapper_->accumulator_) {
+        wrapper_->accumulator_->Flush();
+      }
       producer_->shutdown();
       wrapper_->is_started_.store(false);
       wrapper_->is_shutting_down_.store(false); // Reset shutdown flag after successful shutdown
@@ -268,171 +329,356 @@ Napi::Value RocketMQProducer::Shutdown(const Napi::CallbackInfo& info) {
   return env.Undefined();
 }
 
-class ProducerSendCallback : public rocketmq::AutoDeleteSendCallback {
- public:
-  struct CallbackData {
-    std::unique_ptr<rocketmq::SendResult> result;
-    std::exception_ptr exception;
-    std::unique_ptr<Napi::ObjectReference> prevent_gc;
-  };
+static void ApplySendOptions(const Napi::Value& options_v, rocketmq::MQMessage& message) {
+  if (!options_v.IsObject()) {
+    return;
+  }
+  const Napi::Object options = options_v.ToObject();
 
- private:
-  struct CleanupContext {
-    std::unique_ptr<CallbackData> pending;
-  };
+  Napi::Value tags = options.Get("tags");
+  if (tags.IsString()) {
+    message.set_tags(tags.ToString());
+  }
 
- public:
-  ProducerSendCallback(Napi::Env env, Napi::ObjectReference&& producer_ref, Napi::Function&& callback)
-      : prevent_gc_(new Napi::ObjectReference(std::move(producer_ref))),
-        cleanup_ctx_(nullptr),
-        callback_(),
-        prevent_prevent_release_(false),
-        callback_scheduled_(false),
-        callback_completed_(false) {
-    std::unique_ptr<CleanupContext> ctx(new CleanupContext());
-    try {
-      callback_ = Callback::New(env,
-                                callback,
-                                "RocketMQ Send Callback",
-                                0,
-                                1,
-                                ctx.get(),
-                                &Finalize,
-                                static_cast<void*>(nullptr));
-      // 只有在 Callback::New 成功后才释放所有权
-      cleanup_ctx_ = ctx.release();
-    } catch (...) {
-      // 如果 Callback::New 失败，智能指针会自动清理
-      throw;
+  Napi::Value keys = options.Get("keys");
+  if (keys.IsString()) {
+    message.set_keys(keys.ToString());
+  }
+}
+
+static bool ToMessageBody(const Napi::Value& body, std::string* out) {
+  if (body.IsString()) {
+    *out = body.ToString();
+    return true;
+  }
+  if (body.IsBuffer()) {
+    Napi::Buffer<char> buffer = body.As<Napi::Buffer<char>>();
+    out->assign(buffer.Data(), buffer.Length());
+    return true;
+  }
+  return false;
+}
+
+void RocketMQProducer::DispatchSend(rocketmq::MQMessage& message, ProducerSendCallback* callback) {
+  if (accumulator_) {
+    accumulator_->Append(std::move(message), callback);
+  } else {
+    producer_.send(message, callback);
+  }
+}
+
+bool RocketMQProducer::CheckSendable(Napi::Env env) {
+  std::lock_guard<std::mutex> lock(state_mutex_);
+  if (is_destroyed_.load()) {
+    Napi::Error::New(env, "Producer has been destroyed").ThrowAsJavaScriptException();
+    return false;
+  }
+
+  if (!is_started_.load()) {
+    Napi::Error::New(env, "Producer is not started").ThrowAsJavaScriptException();
+    return false;
+  }
+
+  if (is_shutting_down_.load()) {
+    Napi::Error::New(env, "Producer is shutting down").ThrowAsJavaScriptException();
+    return false;
+  }
+  return true;
+}
+
+Napi::Value RocketMQProducer::Send(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  // Check if required parameters are provided FIRST (before state checks)
+  if (info.Length() < 4) {
+    Napi::TypeError::New(env, "Wrong number of arguments").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (!info[0].IsString()) {
+    Napi::TypeError::New(env, "Topic must be a string").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (!info[3].IsFunction()) {
+    Napi::TypeError::New(env, "Callback must be a function").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  // Check if producer is in valid state AFTER parameter validation
+  if (!CheckSendable(env)) {
+    return env.Undefined();
+  }
+
+  rocketmq::MQMessage message = [&]() {
+    Napi::String topic = info[0].As<Napi::String>();
+    Napi::Value body = info[1];
+    if (body.IsString()) {
+      return rocketmq::MQMessage(topic, body.ToString());
+    } else if (body.IsBuffer()) {
+      Napi::Buffer<char> buffer = body.As<Napi::Buffer<char>>();
+      return rocketmq::MQMessage(topic,
+                                 std::string(buffer.Data(), buffer.Length()));
+    } else {
+      Napi::TypeError::New(env, "Message body must be a string or buffer").ThrowAsJavaScriptException();
+      return rocketmq::MQMessage("", "");
     }
+  }();
+
+  // If there was an error creating the message, return early
+  if (message.topic().empty() && message.body().empty()) {
+    return env.Undefined();
   }
 
-  ~ProducerSendCallback() {
-    if (!prevent_prevent_release_.exchange(true)) {
-      try {
-        callback_.Abort();
-      } catch (const std::exception& e) {
-        fprintf(stderr, "[RocketMQ] Warning: Error aborting send callback: %s\n", e.what());
-      } catch (...) {
-        fprintf(stderr, "[RocketMQ] Warning: Unknown error aborting send callback\n");
-      }
+  ApplySendOptions(info[2], message);
+
+  // 回调登记到完成队列的槽位表中，发送线程只回报槽位 id
+  uint64_t callback_id = completions_->Register(info[3].As<Napi::Function>());
+  std::unique_ptr<ProducerSendCallback> send_callback(new ProducerSendCallback(completions_, callback_id));
+
+  try {
+    DispatchSend(message, send_callback.get());
+    // 只有在 send() 成功后才释放所有权
+    send_callback.release();
+  } catch (const std::exception& e) {
+    // 失败时智能指针自动清理，无内存泄漏
+    completions_->Unregister(callback_id);
+    Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return env.Undefined();
+}
+
+Napi::Value RocketMQProducer::SendAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!info[0].IsString()) {
+    Napi::TypeError::New(env, "Topic must be a string").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  std::string body;
+  if (!ToMessageBody(info[1], &body)) {
+    Napi::TypeError::New(env, "Message body must be a string or buffer").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (!CheckSendable(env)) {
+    return env.Undefined();
+  }
+
+  rocketmq::MQMessage message(info[0].As<Napi::String>(), body);
+  ApplySendOptions(info[2], message);
+
+  uint64_t id = 0;
+  Napi::Promise promise = completions_->RegisterPromise(env, 1, false, &id);
+  std::unique_ptr<ProducerSendCallback> send_callback(new ProducerSendCallback(completions_, id));
+  try {
+    DispatchSend(message, send_callback.get());
+    send_callback.release();
+  } catch (const std::exception& e) {
+    // Promise 风格下同步失败同样以 reject 回报
+    completions_->Fail(id, e.what());
+  }
+  return promise;
+}
+
+Napi::Value RocketMQProducer::SendMany(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!info[0].IsString()) {
+    Napi::TypeError::New(env, "Topic must be a string").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (!info[1].IsArray()) {
+    Napi::TypeError::New(env, "Bodies must be an array").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  std::string topic = info[0].As<Napi::String>();
+  Napi::Array bodies = info[1].As<Napi::Array>();
+  std::vector<rocketmq::MQMessage> messages;
+  messages.reserve(bodies.Length());
+  for (uint32_t i = 0; i < bodies.Length(); i++) {
+    std::string body;
+    if (!ToMessageBody(bodies.Get(i), &body)) {
+      Napi::TypeError::New(env, "Message body must be a string or buffer").ThrowAsJavaScriptException();
+      return env.Undefined();
     }
+    messages.emplace_back(topic, body);
+    ApplySendOptions(info[2], messages.back());
   }
 
-  void onSuccess(rocketmq::SendResult& send_result) override {
-    ScheduleCallback(std::unique_ptr<rocketmq::SendResult>(
-                         new rocketmq::SendResult(send_result)),
-                     nullptr);
+  if (!CheckSendable(env)) {
+    return env.Undefined();
   }
 
-  void onException(rocketmq::MQException& exception) noexcept override {
-    ScheduleCallback(nullptr, std::make_exception_ptr(exception));
+  if (messages.empty()) {
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    deferred.Resolve(Napi::Array::New(env));
+    return deferred.Promise();
+  }
+
+  // 每条消息独立发送（开启 lingerMs 时会被攒批），结果按输入顺序汇总
+  uint64_t first_id = 0;
+  Napi::Promise promise = completions_->RegisterPromise(env, messages.size(), true, &first_id);
+  for (size_t i = 0; i < messages.size(); i++) {
+    std::unique_ptr<ProducerSendCallback> send_callback(new ProducerSendCallback(completions_, first_id + i));
+    try {
+      DispatchSend(messages[i], send_callback.get());
+      send_callback.release();
+    } catch (const std::exception& e) {
+      completions_->Fail(first_id + i, e.what());
+    }
+  }
+  return promise;
+}
+
+// 一次 sendBatch 调用的共享状态：每个分批各占一个结果槽位，全部完成后只回调一次 JS
+class BatchSendState {
+ public:
+  struct Entry {
+    size_t count = 0;
+    std::unique_ptr<rocketmq::SendResult> result;
+    std::string error;
+  };
+
+  BatchSendState(Napi::ObjectReference&& producer_ref, size_t batches)
+      : prevent_gc_(std::move(producer_ref)), entries_(batches), remaining_(batches) {}
+
+  // TSFN 的 context 就是本对象，只在 JS 线程的 Finalize 中释放
+  static BatchSendState* New(Napi::Env env,
+                             Napi::ObjectReference&& producer_ref,
+                             Napi::Function callback,
+                             size_t batches) {
+    std::unique_ptr<BatchSendState> state(new BatchSendState(std::move(producer_ref), batches));
+    state->callback_ = Callback::New(env,
+                                     callback,
+                                     "RocketMQ Batch Send Callback",
+                                     0,
+                                     1,
+                                     state.get(),
+                                     &Finalize,
+                                     static_cast<void*>(nullptr));
+    return state.release();
+  }
+
+  void SetCount(size_t index, size_t count) { entries_[index].count = count; }
+
+  void Succeed(size_t index, const rocketmq::SendResult& result) {
+    entries_[index].result.reset(new rocketmq::SendResult(result));
+    Finish();
+  }
+
+  void Fail(size_t index, const char* error) {
+    entries_[index].error = error;
+    Finish();
   }
 
  private:
-  void ScheduleCallback(std::unique_ptr<rocketmq::SendResult> result,
-                        std::exception_ptr exception) {
-    // Prevent multiple callback scheduling
-    if (callback_scheduled_.exchange(true)) {
-      fprintf(stderr, "[RocketMQ] Warning: Callback already scheduled, ignoring duplicate\n");
+  void Finish() {
+    if (remaining_.fetch_sub(1) != 1) {
       return;
     }
-    
-    auto prevent_gc = std::move(prevent_gc_);
-    auto* data = new CallbackData{
-        std::move(result),
-        std::move(exception),
-        std::move(prevent_gc)
-    };
 
+    // 最后一个分批完成：本对象此后可能随时被 Finalize 释放，先把 TSFN 句柄拷贝出来
+    Callback callback = callback_;
     napi_status status = napi_ok;
 #if defined(ROCKETMQ_COVERAGE) || defined(ROCKETMQ_USE_STUB)
     if (IsEnvEnabled("ROCKETMQ_STUB_PRODUCER_BLOCKING_FAIL")) {
       status = napi_generic_failure;
     } else {
-      status = callback_.BlockingCall(data);
+      status = callback.BlockingCall(this);
     }
 #else
-    status = callback_.BlockingCall(data);
+    status = callback.BlockingCall(this);
 #endif
     if (status != napi_ok) {
-      fprintf(stderr, "[RocketMQ] Failed to schedule JavaScript callback: %d\n", status);
-      cleanup_ctx_->pending.reset(data);
-    } else {
-      callback_completed_.store(true);
-    }
-
-    if (!prevent_prevent_release_.exchange(true)) {
-      try {
-        callback_.Release();
-      } catch (const std::exception& e) {
-        fprintf(stderr, "[RocketMQ] Warning: Error releasing send callback: %s\n", e.what());
-      } catch (...) {
-        fprintf(stderr, "[RocketMQ] Warning: Unknown error releasing send callback\n");
-      }
+      fprintf(stderr, "[RocketMQ] Failed to schedule JavaScript batch callback: %d\n", status);
     }
+    callback.Release();
   }
 
-  static void CallJs(Napi::Env env, Napi::Function callback, CleanupContext*, CallbackData* data) {
-    std::unique_ptr<CallbackData> guard(data);
-#if defined(ROCKETMQ_COVERAGE) || defined(ROCKETMQ_USE_STUB)
-    if (env == nullptr || callback == nullptr || IsEnvEnabled("ROCKETMQ_STUB_PRODUCER_CALLJS_NULL_ENV")) {
-#else
+  static void CallJs(Napi::Env env, Napi::Function callback, BatchSendState*, BatchSendState* state) {
     if (env == nullptr || callback == nullptr) {
-#endif
       return;
     }
 
     Napi::HandleScope scope(env);
     try {
-#if defined(ROCKETMQ_COVERAGE) || defined(ROCKETMQ_USE_STUB)
-      if (IsEnvEnabled("ROCKETMQ_STUB_PRODUCER_CALLJS_THROW")) {
-        throw Napi::Error::New(env, "producer calljs throw");
-      }
-#endif
-      if (data->exception) {
-        try {
-          std::rethrow_exception(data->exception);
-        } catch (const std::exception& e) {
-          callback.Call(env.Global(),
-                        {Napi::Error::New(env, e.what()).Value()});
+      Napi::Array results = Napi::Array::New(env, state->entries_.size());
+      for (size_t i = 0; i < state->entries_.size(); i++) {
+        const Entry& entry = state->entries_[i];
+        Napi::Object result = Napi::Object::New(env);
+        result.Set("count", Napi::Number::New(env, static_cast<double>(entry.count)));
+        if (entry.result) {
+          result.Set("status", Napi::Number::New(env, entry.result->send_status()));
+          result.Set("msgId", Napi::String::New(env, entry.result->msg_id()));
+          result.Set("offset", Napi::Number::New(env, static_cast<double>(entry.result->queue_offset())));
+        } else {
+          result.Set("error", Napi::Error::New(env, entry.error).Value());
         }
-      } else {
-        callback.Call(env.Global(),
-                      {env.Undefined(),
-                       Napi::Number::New(env, data->result->send_status()),
-                       Napi::String::New(env, data->result->msg_id()),
-                       Napi::Number::New(env, data->result->queue_offset())});
+        results.Set(static_cast<uint32_t>(i), result);
       }
+      callback.Call(env.Global(), {env.Null(), results});
     } catch (const Napi::Error& e) {
       e.ThrowAsJavaScriptException();
     } catch (const std::exception& e) {
-      fprintf(stderr, "[RocketMQ] Warning: Exception in send callback: %s\n", e.what());
-    } catch (...) {
-      fprintf(stderr, "[RocketMQ] Warning: Unknown exception in send callback\n");
+      fprintf(stderr, "[RocketMQ] Warning: Exception in batch send callback: %s\n", e.what());
     }
   }
 
-  static void Finalize(Napi::Env, void*, CleanupContext* ctx) {
-    delete ctx;
+  static void Finalize(Napi::Env, void*, BatchSendState* state) {
+    delete state;
   }
 
-  using Callback = Napi::TypedThreadSafeFunction<CleanupContext,
-                                                 CallbackData,
-                                                 &CallJs>;
+  using Callback = Napi::TypedThreadSafeFunction<BatchSendState, BatchSendState, &CallJs>;
 
-  std::unique_ptr<Napi::ObjectReference> prevent_gc_;
-  CleanupContext* cleanup_ctx_;
+  Napi::ObjectReference prevent_gc_;
+  std::vector<Entry> entries_;
+  std::atomic<size_t> remaining_;
   Callback callback_;
-  std::atomic<bool> prevent_prevent_release_;
-  std::atomic<bool> callback_scheduled_;
-  std::atomic<bool> callback_completed_;
 };
 
-Napi::Value RocketMQProducer::Send(const Napi::CallbackInfo& info) {
+class BatchSendCallback : public rocketmq::AutoDeleteSendCallback {
+ public:
+  BatchSendCallback(BatchSendState* state, size_t index) : state_(state), index_(index) {}
+
+  void onSuccess(rocketmq::SendResult& send_result) override {
+    state_->Succeed(index_, send_result);
+  }
+
+  void onException(rocketmq::MQException& exception) noexcept override {
+    state_->Fail(index_, exception.what());
+  }
+
+ private:
+  BatchSendState* state_;
+  size_t index_;
+};
+
+// 按 max_message_size 把消息切成多批，单条超限的消息独占一批并由核心校验报错
+static std::vector<std::vector<rocketmq::MQMessage>> SplitBatch(std::vector<rocketmq::MQMessage>&& messages,
+                                                                size_t max_bytes) {
+  std::vector<std::vector<rocketmq::MQMessage>> batches;
+  size_t batch_bytes = 0;
+  for (auto& message : messages) {
+    size_t size = EstimateBatchEntrySize(message);
+    if (batches.empty() || (max_bytes > 0 && batch_bytes + size > max_bytes)) {
+      batches.emplace_back();
+      batch_bytes = 0;
+    }
+    batches.back().push_back(std::move(message));
+    batch_bytes += size;
+  }
+  return batches;
+}
+
+Napi::Value RocketMQProducer::SendBatch(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
 
-  // Check if required parameters are provided FIRST (before state checks)
   if (info.Length() < 4) {
     Napi::TypeError::New(env, "Wrong number of arguments").ThrowAsJavaScriptException();
     return env.Undefined();
@@ -443,81 +689,86 @@ Napi::Value RocketMQProducer::Send(const Napi::CallbackInfo& info) {
     return env.Undefined();
   }
 
+  if (!info[1].IsArray() || info[1].As<Napi::Array>().Length() == 0) {
+    Napi::TypeError::New(env, "Bodies must be a non-empty array").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
   if (!info[3].IsFunction()) {
     Napi::TypeError::New(env, "Callback must be a function").ThrowAsJavaScriptException();
     return env.Undefined();
   }
 
-  // Check if producer is in valid state AFTER parameter validation
-  {
-    std::lock_guard<std::mutex> lock(state_mutex_);
-    if (is_destroyed_.load()) {
-      Napi::Error::New(env, "Producer has been destroyed").ThrowAsJavaScriptException();
-      return env.Undefined();
-    }
-    
-    if (!is_started_.load()) {
-      Napi::Error::New(env, "Producer is not started").ThrowAsJavaScriptException();
-      return env.Undefined();
+  if (!CheckSendable(env)) {
+    return env.Undefined();
+  }
+
+  std::string topic = info[0].As<Napi::String>();
+  std::string tags;
+  std::string keys;
+  const Napi::Value options_v = info[2];
+  if (options_v.IsObject()) {
+    const Napi::Object options = options_v.ToObject();
+
+    Napi::Value tags_v = options.Get("tags");
+    if (tags_v.IsString()) {
+      tags = tags_v.ToString();
     }
-    
-    if (is_shutting_down_.load()) {
-      Napi::Error::New(env, "Producer is shutting down").ThrowAsJavaScriptException();
-      return env.Undefined();
+
+    Napi::Value keys_v = options.Get("keys");
+    if (keys_v.IsString()) {
+      keys = keys_v.ToString();
     }
   }
 
-  rocketmq::MQMessage message = [&]() {
-    Napi::String topic = info[0].As<Napi::String>();
-    Napi::Value body = info[1];
+  Napi::Array bodies = info[1].As<Napi::Array>();
+  std::vector<rocketmq::MQMessage> messages;
+  messages.reserve(bodies.Length());
+  for (uint32_t i = 0; i < bodies.Length(); i++) {
+    Napi::Value body = bodies.Get(i);
     if (body.IsString()) {
-      return rocketmq::MQMessage(topic, body.ToString());
+      messages.emplace_back(topic, body.ToString());
     } else if (body.IsBuffer()) {
       Napi::Buffer<char> buffer = body.As<Napi::Buffer<char>>();
-      return rocketmq::MQMessage(topic,
-                                 std::string(buffer.Data(), buffer.Length()));
+      messages.emplace_back(topic, std::string(buffer.Data(), buffer.Length()));
     } else {
       Napi::TypeError::New(env, "Message body must be a string or buffer").ThrowAsJavaScriptException();
-      return rocketmq::MQMessage("", "");
+      return env.Undefined();
     }
-  }();
-
-  // If there was an error creating the message, return early
-  if (message.topic().empty() && message.body().empty()) {
-    return env.Undefined();
-  }
-
-  const Napi::Value options_v = info[2];
-  if (options_v.IsObject()) {
-    const Napi::Object options = options_v.ToObject();
-
-    Napi::Value tags = options.Get("tags");
-    if (tags.IsString()) {
-      message.set_tags(tags.ToString());
+    if (!tags.empty()) {
+      messages.back().set_tags(tags);
     }
-
-    Napi::Value keys = options.Get("keys");
-    if (keys.IsString()) {
-      message.set_keys(keys.ToString());
+    if (!keys.empty()) {
+      messages.back().set_keys(keys);
     }
   }
 
-  // 使用智能指针管理回调对象的生命周期
-  std::unique_ptr<ProducerSendCallback> send_callback(
-      new ProducerSendCallback(env, Napi::Persistent(Value()), info[3].As<Napi::Function>()));
-  
-  // 先获取原始指针，但保持智能指针的所有权
-  auto* raw_callback = send_callback.get();
+  int max_message_size = producer_.max_message_size();
+  auto batches = SplitBatch(std::move(messages), max_message_size > 0 ? max_message_size : 0);
+
+  BatchSendState* state = nullptr;
   try {
-    producer_.send(message, raw_callback);
-    // 只有在 send() 成功后才释放所有权
-    send_callback.release();
+    state = BatchSendState::New(env, Napi::Persistent(Value()), info[3].As<Napi::Function>(), batches.size());
   } catch (const std::exception& e) {
-    // 失败时智能指针自动清理，无内存泄漏
     Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
     return env.Undefined();
   }
 
+  for (size_t i = 0; i < batches.size(); i++) {
+    state->SetCount(i, batches[i].size());
+  }
+
+  // 从这里开始结果都经由 state 回报，不再同步抛出
+  for (size_t i = 0; i < batches.size(); i++) {
+    std::unique_ptr<BatchSendCallback> send_callback(new BatchSendCallback(state, i));
+    try {
+      producer_.send(batches[i], send_callback.get());
+      send_callback.release();
+    } catch (const std::exception& e) {
+      state->Fail(i, e.what());
+    }
+  }
+
   return env.Undefined();
 }
 
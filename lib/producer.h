@@ -19,6 +19,7 @@
 
 #include <napi.h>
 #include <atomic>
+#include <memory>
 #include <mutex>
 
 #include <DefaultMQProducer.h>
@@ -28,6 +29,9 @@ namespace __node_rocketmq__ {
 struct AddonData;
 class ProducerStartWorker;
 class ProducerShutdownWorker;
+class SendAccumulator;
+class SendCompletionQueue;
+class ProducerSendCallback;
 
 class RocketMQProducer : public Napi::ObjectWrap<RocketMQProducer> {
   friend class ProducerStartWorker;
@@ -45,13 +49,27 @@ class RocketMQProducer : public Napi::ObjectWrap<RocketMQProducer> {
   Napi::Value Shutdown(const Napi::CallbackInfo& info);
 
   Napi::Value Send(const Napi::CallbackInfo& info);
+  // 不带回调的发送，直接返回 Promise，结果对象在原生层构造
+  Napi::Value SendAsync(const Napi::CallbackInfo& info);
+  // 逐条发送多条消息，返回按输入顺序 resolve 结果数组的 Promise
+  Napi::Value SendMany(const Napi::CallbackInfo& info);
+  // 同一 topic 的多条消息按 maxMessageSize 拆成若干批发送，回调按批给出结果
+  Napi::Value SendBatch(const Napi::CallbackInfo& info);
 
  private:
   void SetOptions(const Napi::Object& options);
+  // 发送前检查生产者状态，不可发送时抛出 JS 异常并返回 false
+  bool CheckSendable(Napi::Env env);
+  // 开启攒批时交给 accumulator，否则直接异步发送；抛异常时 callback 的所有权仍在调用方
+  void DispatchSend(rocketmq::MQMessage& message, ProducerSendCallback* callback);
   void SafeShutdown();
 
  private:
   rocketmq::DefaultMQProducer producer_;
+  // 未配置 lingerMs 时为空；声明在 producer_ 之后，保证先于 producer_ 析构
+  std::unique_ptr<SendAccumulator> accumulator_;
+  // 所有 send() 共用的完成通道，替代每次发送创建的 TSFN
+  std::shared_ptr<SendCompletionQueue> completions_;
   std::atomic<bool> is_started_{false};
   std::atomic<bool> is_shutting_down_{false};
   std::atomic<bool> is_destroyed_{false};
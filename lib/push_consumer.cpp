@@ -20,7 +20,10 @@
 #include <cstdlib>
 #include <exception>
 #include <future>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
+#include <vector>
 
 #include <napi.h>
 
@@ -31,6 +34,7 @@
 #include "addon_data.h"
 #include "consumer_ack.h"
 #include "common_utils.h"
+#include "message_view.h"
 
 namespace __node_rocketmq__ {
 
@@ -132,6 +136,28 @@ void RocketMQPushConsumer::SetOptions(const Napi::Object& options) {
     consumer_.set_max_reconsume_times(max_reconsume_times.ToNumber());
   }
 
+  // 按字节数限制每个队列以及整个 consumer 缓存的消息，避免大消息撑爆内存（单位 MiB）
+  Napi::Value pull_threshold_size_for_queue = options.Get("pullThresholdSizeForQueue");
+  if (pull_threshold_size_for_queue.IsNumber()) {
+    consumer_.set_pull_threshold_size_for_queue(pull_threshold_size_for_queue.ToNumber());
+  }
+
+  Napi::Value pull_threshold_size_for_all = options.Get("pullThresholdSizeForAll");
+  if (pull_threshold_size_for_all.IsNumber()) {
+    consumer_.set_pull_threshold_size_for_all(pull_threshold_size_for_all.ToNumber());
+  }
+
+  Napi::Value consume_max_span = options.Get("consumeMaxSpan");
+  if (consume_max_span.IsNumber()) {
+    consumer_.set_consume_concurrently_max_span(consume_max_span.ToNumber());
+  }
+
+  // binaryHeader 为 true 时请求头使用 ROCKETMQ 二进制编码，省去 JSON 序列化
+  Napi::Value binary_header = options.Get("binaryHeader");
+  if (binary_header.IsBoolean() && binary_header.ToBoolean()) {
+    consumer_.set_serialize_type(rocketmq::SerializeType::ROCKETMQ);
+  }
+
   // 使用通用的日志配置函数
   utils::SetLoggerOptions(options);
 }
@@ -319,10 +345,31 @@ Napi::Value RocketMQPushConsumer::Subscribe(const Napi::CallbackInfo& info) {
 }
 
 struct MessageAndPromise {
-  rocketmq::MQMessageExt message;
+  // 单条模式下只有一条消息；批量模式下为整批消息，并以数组形式交给 JS
+  std::vector<rocketmq::MQMessageExt> messages;
+  bool batch;
+  // 为 true 时 body 以 Buffer 形式交给 JS，省去 UTF-8 转码
+  bool binary;
+  // 为 true 时以 MessageView 交付，字段按需转换
+  bool lazy;
   std::promise<bool> promise;
+  // 异步消费模式下非空，ack 结果通过它回报，promise 不再使用
+  rocketmq::ConsumeCallbackPtr callback;
+  // 同步批量模式下非空，用于带回 ack.done([...]) 的逐条结果
+  std::shared_ptr<std::vector<bool>> acks;
 };
 
+static void FailDispatch(MessageAndPromise* data) {
+  if (data->callback) {
+    data->callback->onComplete(rocketmq::ConsumeStatus::RECONSUME_LATER);
+    return;
+  }
+  try {
+    data->promise.set_value(false);
+  } catch (const std::future_error&) {
+  }
+}
+
 void CallConsumerMessageJsListener(Napi::Env env,
                                    Napi::Function listener,
                                    std::nullptr_t*,
@@ -334,10 +381,7 @@ void CallConsumerMessageJsListener(Napi::Env env,
   if (data == nullptr) {
 #endif
     if (data != nullptr) {
-      try {
-        data->promise.set_value(false);
-      } catch (const std::future_error&) {
-      }
+      FailDispatch(data);
     }
     return;
   }
@@ -347,14 +391,13 @@ void CallConsumerMessageJsListener(Napi::Env env,
 #else
   if (env == nullptr || listener == nullptr) {
 #endif
-    try {
-      data->promise.set_value(false);
-    } catch (const std::future_error&) {
-    }
+    FailDispatch(data);
     return;
   }
 
   Napi::HandleScope scope(env);
+  // ack 对象接管 promise/callback 后，失败结果只能经由它回报一次
+  ConsumerAck* ack_owner = nullptr;
   try {
 #if defined(ROCKETMQ_COVERAGE) || defined(ROCKETMQ_USE_STUB)
     if (IsEnvEnabled("ROCKETMQ_STUB_CONSUMER_THROW")) {
@@ -362,12 +405,16 @@ void CallConsumerMessageJsListener(Napi::Env env,
     }
 #endif
 
-    Napi::Object message = Napi::Object::New(env);
-    message.Set("topic", data->message.topic());
-    message.Set("tags", data->message.tags());
-    message.Set("keys", data->message.keys());
-    message.Set("body", data->message.body());
-    message.Set("msgId", data->message.msg_id());
+    Napi::Value message;
+    if (data->batch) {
+      Napi::Array messages = Napi::Array::New(env, data->messages.size());
+      for (size_t i = 0; i < data->messages.size(); i++) {
+        messages.Set(static_cast<uint32_t>(i), NewConsumedMessage(env, data->messages[i], data->binary, data->lazy));
+      }
+      message = messages;
+    } else {
+      message = NewConsumedMessage(env, data->messages.front(), data->binary, data->lazy);
+    }
 
 #if defined(ROCKETMQ_COVERAGE) || defined(ROCKETMQ_USE_STUB)
     Napi::Object ack = IsEnvEnabled("ROCKETMQ_STUB_CONSUMER_ACK_EMPTY") ? Napi::Object()
@@ -376,7 +423,7 @@ void CallConsumerMessageJsListener(Napi::Env env,
     Napi::Object ack = ConsumerAck::NewInstance(env);
 #endif
     if (ack.IsEmpty()) {
-      data->promise.set_value(false);
+      FailDispatch(data);
       return;
     }
 
@@ -388,7 +435,7 @@ void CallConsumerMessageJsListener(Napi::Env env,
     ConsumerAck* consumer_ack = Napi::ObjectWrap<ConsumerAck>::Unwrap(ack);
 #endif
     if (consumer_ack == nullptr) {
-      data->promise.set_value(false);
+      FailDispatch(data);
       return;
     }
 
@@ -401,7 +448,15 @@ void CallConsumerMessageJsListener(Napi::Env env,
     }
 #endif
 
-    consumer_ack->SetPromise(std::move(data->promise));
+    if (data->callback) {
+      consumer_ack->SetCallback(data->callback);
+    } else {
+      consumer_ack->SetPromise(std::move(data->promise));
+      if (data->acks) {
+        consumer_ack->SetAcks(data->acks);
+      }
+    }
+    ack_owner = consumer_ack;
 
     try {
 #if defined(ROCKETMQ_COVERAGE) || defined(ROCKETMQ_USE_STUB)
@@ -421,18 +476,64 @@ void CallConsumerMessageJsListener(Napi::Env env,
 #endif
     }
   } catch (const std::exception&) {
-    try {
-      data->promise.set_value(false);
-    } catch (const std::future_error&) {
+    if (ack_owner != nullptr) {
+      ack_owner->Done(std::current_exception());
+    } else {
+      FailDispatch(data);
     }
   }
 }
 
-class ConsumerMessageListener : public rocketmq::MessageListenerConcurrently {
+// 异步单条投递时汇总同一批消息各自的 ack，全部回报后按条交给 ConsumeCallback，只重试失败的消息
+class ConsumeResultAggregator {
+ public:
+  ConsumeResultAggregator(size_t count, rocketmq::ConsumeCallbackPtr callback)
+      : acks_(count, false), remaining_(count), callback_(std::move(callback)) {}
+
+  void Complete(size_t index, bool ack) {
+    bool last = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      acks_[index] = ack;
+      last = --remaining_ == 0;
+    }
+    if (last) {
+      callback_->onPartialComplete(acks_);
+    }
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<bool> acks_;
+  size_t remaining_;
+  rocketmq::ConsumeCallbackPtr callback_;
+};
+
+// 单条消息的 ack，结果记到聚合器中对应的位置
+class AggregatedConsumeCallback : public rocketmq::ConsumeCallback {
+ public:
+  AggregatedConsumeCallback(std::shared_ptr<ConsumeResultAggregator> aggregator, size_t index)
+      : aggregator_(std::move(aggregator)), index_(index) {}
+
+  void onComplete(rocketmq::ConsumeStatus status) override {
+    aggregator_->Complete(index_, status == rocketmq::ConsumeStatus::CONSUME_SUCCESS);
+  }
+
+ private:
+  std::shared_ptr<ConsumeResultAggregator> aggregator_;
+  size_t index_;
+};
+
+// 并发与顺序两种模式共用的投递逻辑，具体模式由下面的子类决定注册到哪种消费服务
+class ConsumerMessageListener : virtual public rocketmq::MQMessageListener {
  public:
-  ConsumerMessageListener(Napi::Env& env, Napi::Function&& callback)
+  ConsumerMessageListener(Napi::Env& env, Napi::Function&& callback, bool batch, bool async, bool binary, bool lazy)
       : listener_(
             Listener::New(env, callback, "RocketMQ Message Listener", 0, 1)),
+        batch_(batch),
+        async_(async),
+        binary_(binary),
+        lazy_(lazy),
         aborted_(false),
         shutdown_requested_(false) {}
 
@@ -459,6 +560,41 @@ class ConsumerMessageListener : public rocketmq::MessageListenerConcurrently {
     }
   }
 
+  void consumeMessageAsync(std::vector<rocketmq::MQMessageExt>& msgs,
+                           rocketmq::ConsumeCallbackPtr callback) override {
+    if (!async_) {
+      if (msgs.empty() || shutdown_requested_.load()) {
+        callback->onComplete(consumeMessage(msgs));
+        return;
+      }
+      // 同步模式：阻塞等待 ack，并按条回报结果，只有失败的消息会被重新消费
+      callback->onPartialComplete(ConsumeEach(msgs));
+      return;
+    }
+
+    if (shutdown_requested_.load() || aborted_.load()) {
+      callback->onComplete(rocketmq::ConsumeStatus::RECONSUME_LATER);
+      return;
+    }
+
+    if (msgs.empty()) {
+      callback->onComplete(rocketmq::ConsumeStatus::CONSUME_SUCCESS);
+      return;
+    }
+
+    // 异步模式：投递后立即返回，消费线程不再等待 JS 的 ack
+    if (batch_) {
+      Dispatch(msgs, true, std::move(callback));
+      return;
+    }
+
+    auto aggregator = std::make_shared<ConsumeResultAggregator>(msgs.size(), std::move(callback));
+    for (size_t i = 0; i < msgs.size(); i++) {
+      Dispatch(std::vector<rocketmq::MQMessageExt>{msgs[i]}, false,
+               std::make_shared<AggregatedConsumeCallback>(aggregator, i));
+    }
+  }
+
   rocketmq::ConsumeStatus consumeMessage(
       std::vector<rocketmq::MQMessageExt>& msgs) override {
     
@@ -466,109 +602,196 @@ class ConsumerMessageListener : public rocketmq::MessageListenerConcurrently {
     if (shutdown_requested_.load()) {
       return rocketmq::ConsumeStatus::RECONSUME_LATER;
     }
+
+    // 批量模式：整批消息一次投递给 JS，共用一个 ack
+    if (batch_) {
+      if (msgs.empty()) {
+        return rocketmq::ConsumeStatus::CONSUME_SUCCESS;
+      }
+      return DispatchAndWait(msgs, true) ? rocketmq::ConsumeStatus::CONSUME_SUCCESS
+                                         : rocketmq::ConsumeStatus::RECONSUME_LATER;
+    }
     
     for (auto& msg : msgs) {
       // Double check shutdown status for each message
       if (shutdown_requested_.load()) {
         return rocketmq::ConsumeStatus::RECONSUME_LATER;
       }
-      
-      // 使用智能指针管理内存，确保异常安全
-      std::unique_ptr<MessageAndPromise> data_ptr(new MessageAndPromise{msg, std::promise<bool>()});
-      auto* data = data_ptr.get();
-      auto future = data->promise.get_future();
 
-#if defined(ROCKETMQ_COVERAGE) || defined(ROCKETMQ_USE_STUB)
-      if (IsEnvEnabled("ROCKETMQ_STUB_CONSUMER_PROMISE_PRESET")) {
-        bool preset = !IsEnvEnabled("ROCKETMQ_STUB_CONSUMER_PROMISE_PRESET_FALSE");
-        try {
-          data->promise.set_value(preset);
-          data->promise.set_value(preset);
-        } catch (const std::future_error&) {
-        }
+      if (!DispatchAndWait(std::vector<rocketmq::MQMessageExt>{msg}, false)) {
+        return rocketmq::ConsumeStatus::RECONSUME_LATER;
       }
+    }
+    return rocketmq::ConsumeStatus::CONSUME_SUCCESS;
+  };
 
-      if (IsEnvEnabled("ROCKETMQ_STUB_CONSUMER_TIMEOUT_SKIP_CALL")) {
-        auto wait_time = IsEnvEnabled("ROCKETMQ_STUB_CONSUMER_TIMEOUT")
-                             ? std::chrono::milliseconds(0)
-                             : config::DEFAULT_MESSAGE_TIMEOUT;
-        if (future.wait_for(wait_time) == std::future_status::timeout) {
-          return rocketmq::ConsumeStatus::RECONSUME_LATER;
-        }
-        if (!future.get()) {
-          return rocketmq::ConsumeStatus::RECONSUME_LATER;
+ private:
+  // 同步模式下逐条（批量模式下整批一次）投递并等待 ack，返回每条消息的消费结果
+  std::vector<bool> ConsumeEach(std::vector<rocketmq::MQMessageExt>& msgs) {
+    std::vector<bool> acks(msgs.size(), false);
+    if (batch_) {
+      std::vector<bool> batch_acks;
+      bool ack = DispatchAndWait(msgs, true, &batch_acks);
+      if (batch_acks.empty()) {
+        acks.assign(msgs.size(), ack);
+      } else {
+        for (size_t i = 0; i < acks.size() && i < batch_acks.size(); i++) {
+          acks[i] = batch_acks[i];
         }
-        continue;
       }
+      return acks;
+    }
+
+    // 某条失败后继续投递后面的消息，失败的那条单独重试
+    for (size_t i = 0; i < msgs.size(); i++) {
+      if (shutdown_requested_.load()) {
+        break;
+      }
+      acks[i] = DispatchAndWait(std::vector<rocketmq::MQMessageExt>{msgs[i]}, false);
+    }
+    return acks;
+  }
+
+  void Dispatch(std::vector<rocketmq::MQMessageExt> msgs, bool batch, rocketmq::ConsumeCallbackPtr callback) {
+    std::unique_ptr<MessageAndPromise> data(
+        new MessageAndPromise{std::move(msgs), batch, binary_, lazy_, std::promise<bool>(), std::move(callback)});
+
+    napi_status status = napi_ok;
+#if defined(ROCKETMQ_COVERAGE) || defined(ROCKETMQ_USE_STUB)
+    if (IsEnvEnabled("ROCKETMQ_STUB_CONSUMER_BLOCKING_FAIL")) {
+      status = napi_generic_failure;
+    } else {
+      status = listener_.NonBlockingCall(data.get());
+    }
+#else
+    status = listener_.NonBlockingCall(data.get());
 #endif
+    if (status != napi_ok) {
+      FailDispatch(data.get());
+      return;
+    }
+
+    // 投递成功后由 CallConsumerMessageJsListener 管理内存
+    data.release();
+  }
+
+  // 通过 TSFN 把消息投递给 JS，并阻塞等待 ack；返回 true 表示消费成功
+  // acks 非空时，JS 以 ack.done([...]) 逐条确认的结果会写到这里
+  bool DispatchAndWait(std::vector<rocketmq::MQMessageExt> msgs, bool batch, std::vector<bool>* acks = nullptr) {
+    // 使用智能指针管理内存，确保异常安全
+    std::unique_ptr<MessageAndPromise> data_ptr(
+        new MessageAndPromise{std::move(msgs), batch, binary_, lazy_, std::promise<bool>(), nullptr});
+    auto* data = data_ptr.get();
+    if (acks != nullptr) {
+      data->acks = std::make_shared<std::vector<bool>>();
+    }
+    auto partial_acks = data->acks;
+    auto future = data->promise.get_future();
 
-      napi_status status = napi_ok;
 #if defined(ROCKETMQ_COVERAGE) || defined(ROCKETMQ_USE_STUB)
-      if (IsEnvEnabled("ROCKETMQ_STUB_CONSUMER_ABORT_TSFN")) {
-        listener_.Abort();
-        aborted_.store(true);
-        status = napi_generic_failure;
-      } else if (IsEnvEnabled("ROCKETMQ_STUB_CONSUMER_BLOCKING_FAIL")) {
-        status = napi_generic_failure;
-      } else {
-        status = listener_.BlockingCall(data);
+    if (IsEnvEnabled("ROCKETMQ_STUB_CONSUMER_PROMISE_PRESET")) {
+      bool preset = !IsEnvEnabled("ROCKETMQ_STUB_CONSUMER_PROMISE_PRESET_FALSE");
+      try {
+        data->promise.set_value(preset);
+        data->promise.set_value(preset);
+      } catch (const std::future_error&) {
       }
-#else
-      // Check if we're already aborted before making the call
-      if (aborted_.load() || shutdown_requested_.load()) {
-        return rocketmq::ConsumeStatus::RECONSUME_LATER;
+    }
+
+    if (IsEnvEnabled("ROCKETMQ_STUB_CONSUMER_TIMEOUT_SKIP_CALL")) {
+      auto wait_time = IsEnvEnabled("ROCKETMQ_STUB_CONSUMER_TIMEOUT")
+                           ? std::chrono::milliseconds(0)
+                           : config::DEFAULT_MESSAGE_TIMEOUT;
+      if (future.wait_for(wait_time) == std::future_status::timeout) {
+        return false;
       }
-      
+      return future.get();
+    }
+#endif
+
+    napi_status status = napi_ok;
+#if defined(ROCKETMQ_COVERAGE) || defined(ROCKETMQ_USE_STUB)
+    if (IsEnvEnabled("ROCKETMQ_STUB_CONSUMER_ABORT_TSFN")) {
+      listener_.Abort();
+      aborted_.store(true);
+      status = napi_generic_failure;
+    } else if (IsEnvEnabled("ROCKETMQ_STUB_CONSUMER_BLOCKING_FAIL")) {
+      status = napi_generic_failure;
+    } else {
       status = listener_.BlockingCall(data);
+    }
+#else
+    // Check if we're already aborted before making the call
+    if (aborted_.load() || shutdown_requested_.load()) {
+      return false;
+    }
+    
+    status = listener_.BlockingCall(data);
 #endif
-      if (status != napi_ok) {
-        return rocketmq::ConsumeStatus::RECONSUME_LATER;
-      }
+    if (status != napi_ok) {
+      return false;
+    }
 
-      // 成功调用后释放智能指针的所有权，让 CallConsumerMessageJsListener 管理内存
-      data_ptr.release();
+    // 成功调用后释放智能指针的所有权，让 CallConsumerMessageJsListener 管理内存
+    data_ptr.release();
 
-      try {
+    try {
 #if defined(ROCKETMQ_COVERAGE) || defined(ROCKETMQ_USE_STUB)
-        if (IsEnvEnabled("ROCKETMQ_STUB_CONSUMER_FORCE_FUTURE_ERROR")) {
-          std::promise<bool> probe;
-          auto probe_future = probe.get_future();
-          (void)probe_future;
-          probe.get_future();
-        }
+      if (IsEnvEnabled("ROCKETMQ_STUB_CONSUMER_FORCE_FUTURE_ERROR")) {
+        std::promise<bool> probe;
+        auto probe_future = probe.get_future();
+        (void)probe_future;
+        probe.get_future();
+      }
 
-        auto wait_time = IsEnvEnabled("ROCKETMQ_STUB_CONSUMER_TIMEOUT")
-                             ? std::chrono::milliseconds(0)
-                             : config::DEFAULT_MESSAGE_TIMEOUT;
+      auto wait_time = IsEnvEnabled("ROCKETMQ_STUB_CONSUMER_TIMEOUT")
+                           ? std::chrono::milliseconds(0)
+                           : config::DEFAULT_MESSAGE_TIMEOUT;
 #else
-        auto wait_time = config::DEFAULT_MESSAGE_TIMEOUT;
+      auto wait_time = config::DEFAULT_MESSAGE_TIMEOUT;
 #endif
-        if (future.wait_for(wait_time) == std::future_status::timeout) {
-          return rocketmq::ConsumeStatus::RECONSUME_LATER;
-        }
-        if (!future.get()) {
-          return rocketmq::ConsumeStatus::RECONSUME_LATER;
-        }
-      } catch (const std::future_error&) {
-        return rocketmq::ConsumeStatus::RECONSUME_LATER;
-      } catch (const std::exception&) {
-        return rocketmq::ConsumeStatus::RECONSUME_LATER;
+      if (future.wait_for(wait_time) == std::future_status::timeout) {
+        return false;
+      }
+      bool ack = future.get();
+      if (acks != nullptr) {
+        *acks = *partial_acks;
       }
+      return ack;
+    } catch (const std::future_error&) {
+      return false;
+    } catch (const std::exception&) {
+      return false;
     }
-    return rocketmq::ConsumeStatus::CONSUME_SUCCESS;
-  };
+  }
 
- private:
   using Listener =
       Napi::TypedThreadSafeFunction<std::nullptr_t,
                                     MessageAndPromise,
                                     &CallConsumerMessageJsListener>;
 
   Listener listener_;
+  bool batch_;
+  bool async_;
+  bool binary_;
+  bool lazy_;
   std::atomic<bool> aborted_;
   std::atomic<bool> shutdown_requested_;
 };
 
+class ConcurrentlyConsumerMessageListener : public ConsumerMessageListener,
+                                            public rocketmq::MessageListenerConcurrently {
+ public:
+  using ConsumerMessageListener::ConsumerMessageListener;
+};
+
+// 顺序模式：每个队列的一批消息整体投递，ack 之后才会投递该队列的下一批；
+// 等待 ack 期间不占用消费线程，不同队列之间互不阻塞
+class OrderlyConsumerMessageListener : public ConsumerMessageListener, public rocketmq::MessageListenerOrderly {
+ public:
+  using ConsumerMessageListener::ConsumerMessageListener;
+};
+
 Napi::Value RocketMQPushConsumer::SetListener(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
 
@@ -591,6 +814,30 @@ Napi::Value RocketMQPushConsumer::SetListener(const Napi::CallbackInfo& info) {
     }
   }
 
+  // 第二个参数为可选的监听选项，batch 为 true 时整批投递消息
+  bool batch = false;
+  bool async = false;
+  bool binary = false;
+  bool lazy = false;
+  bool orderly = false;
+  if (info.Length() > 1 && info[1].IsObject()) {
+    Napi::Object listener_options = info[1].ToObject();
+    Napi::Value batch_value = listener_options.Get("batch");
+    batch = batch_value.IsBoolean() && batch_value.ToBoolean();
+    // async 为 true 时消费线程不等待 ack，结果由 ack.done() 异步回报
+    Napi::Value async_value = listener_options.Get("async");
+    async = async_value.IsBoolean() && async_value.ToBoolean();
+    // binary 为 true 时 body 以 Buffer 交付，避免 UTF-8 转码
+    Napi::Value binary_value = listener_options.Get("binary");
+    binary = binary_value.IsBoolean() && binary_value.ToBoolean();
+    // lazy 为 true 时交付 MessageView，只有被访问的字段才会创建 JS 值
+    Napi::Value lazy_value = listener_options.Get("lazy");
+    lazy = lazy_value.IsBoolean() && lazy_value.ToBoolean();
+    // orderly 为 true 时按队列顺序消费，总是整批异步投递
+    Napi::Value orderly_value = listener_options.Get("orderly");
+    orderly = orderly_value.IsBoolean() && orderly_value.ToBoolean();
+  }
+
   // Safely replace the listener
   {
     std::lock_guard<std::mutex> lock(state_mutex_);
@@ -600,9 +847,16 @@ Napi::Value RocketMQPushConsumer::SetListener(const Napi::CallbackInfo& info) {
       listener_.reset();
     }
     
-    listener_.reset(
-        new ConsumerMessageListener(env, info[0].As<Napi::Function>()));
-    consumer_.registerMessageListener(listener_.get());
+    if (orderly) {
+      auto* listener = new OrderlyConsumerMessageListener(env, info[0].As<Napi::Function>(), true, true, binary, lazy);
+      listener_.reset(listener);
+      consumer_.registerMessageListener(listener);
+    } else {
+      auto* listener =
+          new ConcurrentlyConsumerMessageListener(env, info[0].As<Napi::Function>(), batch, async, binary, lazy);
+      listener_.reset(listener);
+      consumer_.registerMessageListener(listener);
+    }
   }
   
   return env.Undefined();
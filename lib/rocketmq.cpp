@@ -30,6 +30,8 @@
 
 #include "addon_data.h"
 #include "consumer_ack.h"
+#include "lite_pull_consumer.h"
+#include "message_view.h"
 #include "producer.h"
 #include "push_consumer.h"
 #include "common_utils.h"
@@ -81,7 +83,9 @@ Napi::Object Init(Napi::Env env, Napi::Object exports) {
 
   RocketMQProducer::Init(env, exports, addon_data);
   RocketMQPushConsumer::Init(env, exports, addon_data);
+  RocketMQLitePullConsumer::Init(env, exports, addon_data);
   ConsumerAck::Init(env, exports, addon_data);
+  MessageView::Init(env, exports, addon_data);
   return exports;
 }
 
@@ -0,0 +1,269 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "send_accumulator.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <exception>
+#include <memory>
+#include <utility>
+
+#include <MQException.h>
+
+namespace __node_rocketmq__ {
+
+size_t EstimateBatchEntrySize(const rocketmq::MQMessage& message) {
+  // TOTALSIZE|MAGICCODE|BODYCRC|FLAG|BodyLen 各 4 字节，propertiesLength 2 字节
+  size_t size = 4 * 5 + message.body().size() + 2;
+  for (const auto& property : message.properties()) {
+    // name\x01value\x02
+    size += property.first.size() + property.second.size() + 2;
+  }
+  // 发送前才会写入的 UNIQ_KEY 属性
+  return size + 64;
+}
+
+struct InFlightSends {
+  std::mutex mutex;
+  std::condition_variable cv;
+  size_t count = 0;
+
+  void Add(size_t n) {
+    std::lock_guard<std::mutex> lock(mutex);
+    count += n;
+  }
+
+  void Done() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      count--;
+    }
+    cv.notify_all();
+  }
+
+  bool WaitIdle(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(mutex);
+    return cv.wait_for(lock, timeout, [this]() { return count == 0; });
+  }
+};
+
+namespace {
+
+// 批量发送的结果：msg_id 是逗号分隔的各条消息 ID，queue_offset 是首条消息的位点
+class FanOutSendCallback : public rocketmq::AutoDeleteSendCallback {
+ public:
+  FanOutSendCallback(std::vector<rocketmq::AutoDeleteSendCallback*>&& callbacks,
+                     std::shared_ptr<InFlightSends> in_flight)
+      : callbacks_(std::move(callbacks)), in_flight_(std::move(in_flight)) {}
+
+  ~FanOutSendCallback() {
+    for (auto* callback : callbacks_) {
+      delete callback;
+    }
+  }
+
+  void onSuccess(rocketmq::SendResult& send_result) override {
+    std::vector<std::string> msg_ids;
+    const std::string& joined = send_result.msg_id();
+    size_t start = 0;
+    while (start <= joined.size()) {
+      size_t end = joined.find(',', start);
+      if (end == std::string::npos) {
+        end = joined.size();
+      }
+      msg_ids.push_back(joined.substr(start, end - start));
+      start = end + 1;
+    }
+
+    for (size_t i = 0; i < callbacks_.size(); i++) {
+      rocketmq::SendResult result(send_result);
+      if (msg_ids.size() == callbacks_.size()) {
+        result.msg_id(msg_ids[i]);
+      }
+      result.set_queue_offset(send_result.queue_offset() + static_cast<int64_t>(i));
+      callbacks_[i]->onSuccess(result);
+    }
+    in_flight_->Done();
+  }
+
+  void onException(rocketmq::MQException& exception) noexcept override {
+    for (auto* callback : callbacks_) {
+      callback->onException(exception);
+    }
+    in_flight_->Done();
+  }
+
+ private:
+  std::vector<rocketmq::AutoDeleteSendCallback*> callbacks_;
+  std::shared_ptr<InFlightSends> in_flight_;
+};
+
+}  // namespace
+
+SendAccumulator::SendAccumulator(rocketmq::DefaultMQProducer* producer,
+                                 std::chrono::milliseconds linger,
+                                 size_t batch_bytes)
+    : producer_(producer),
+      linger_(linger),
+      batch_bytes_(batch_bytes),
+      closed_(false),
+      in_flight_(std::make_shared<InFlightSends>()) {
+  thread_ = std::thread(&SendAccumulator::Run, this);
+}
+
+SendAccumulator::~SendAccumulator() {
+  std::map<std::string, Batch> pending;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    pending.swap(batches_);
+    in_flight_->Add(pending.size());
+  }
+  cv_.notify_one();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+
+  for (auto& entry : pending) {
+    Send(std::move(entry.second));
+  }
+}
+
+void SendAccumulator::Append(rocketmq::MQMessage&& message, rocketmq::AutoDeleteSendCallback* callback) {
+  size_t size = EstimateBatchEntrySize(message);
+  std::vector<Batch> ready;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!closed_) {
+      auto it = batches_.find(message.topic());
+      // 放不下当前消息时先把已缓存的部分发出去
+      if (it != batches_.end() && it->second.bytes + size > batch_bytes_) {
+        ready.push_back(std::move(it->second));
+        batches_.erase(it);
+        it = batches_.end();
+      }
+      if (it == batches_.end()) {
+        it = batches_.emplace(message.topic(), Batch()).first;
+        it->second.deadline = std::chrono::steady_clock::now() + linger_;
+        cv_.notify_one();
+      }
+
+      Batch& batch = it->second;
+      batch.messages.push_back(std::move(message));
+      batch.callbacks.push_back(callback);
+      batch.bytes += size;
+      if (batch.bytes >= batch_bytes_) {
+        ready.push_back(std::move(batch));
+        batches_.erase(it);
+      }
+    } else {
+      Batch batch;
+      batch.messages.push_back(std::move(message));
+      batch.callbacks.push_back(callback);
+      ready.push_back(std::move(batch));
+    }
+    in_flight_->Add(ready.size());
+  }
+
+  for (auto& batch : ready) {
+    Send(std::move(batch));
+  }
+}
+
+void SendAccumulator::Flush() {
+  std::map<std::string, Batch> pending;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending.swap(batches_);
+    in_flight_->Add(pending.size());
+  }
+
+  for (auto& entry : pending) {
+    Send(std::move(entry.second));
+  }
+
+  // 这里只是把批次交给了异步发送，随后的 shutdown 会丢弃尚未完成的请求，回调将永远不会触发。
+  // 因此等待所有已取出的批次（包括 Run 线程正在发送的）回报结果，最多等待一个发送超时
+  int timeout_ms = std::max(producer_->send_msg_timeout(), 0);
+  if (!in_flight_->WaitIdle(std::chrono::milliseconds(timeout_ms))) {
+    fprintf(stderr, "[RocketMQ] Warning: Lingered sends did not complete within %d ms before shutdown\n", timeout_ms);
+  }
+}
+
+void SendAccumulator::Run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!closed_) {
+    if (batches_.empty()) {
+      cv_.wait(lock);
+      continue;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    auto next_deadline = std::chrono::steady_clock::time_point::max();
+    std::vector<Batch> expired;
+    for (auto it = batches_.begin(); it != batches_.end();) {
+      if (it->second.deadline <= now) {
+        expired.push_back(std::move(it->second));
+        it = batches_.erase(it);
+      } else {
+        if (it->second.deadline < next_deadline) {
+          next_deadline = it->second.deadline;
+        }
+        ++it;
+      }
+    }
+
+    if (!expired.empty()) {
+      // 持锁计入在途批次，Flush 才能看到这些已取出但尚未发送的批次
+      in_flight_->Add(expired.size());
+      // 发送可能触发同步回调，不能持锁
+      lock.unlock();
+      for (auto& batch : expired) {
+        Send(std::move(batch));
+      }
+      lock.lock();
+      continue;
+    }
+
+    cv_.wait_until(lock, next_deadline);
+  }
+}
+
+void SendAccumulator::Send(Batch&& batch) {
+  if (batch.messages.empty()) {
+    in_flight_->Done();
+    return;
+  }
+
+  std::unique_ptr<FanOutSendCallback> callback(new FanOutSendCallback(std::move(batch.callbacks), in_flight_));
+  try {
+    // 只有一条消息时没有必要走批量编码，结果也无需拆分
+    if (batch.messages.size() == 1) {
+      producer_->send(batch.messages.front(), callback.get());
+    } else {
+      producer_->send(batch.messages, callback.get());
+    }
+    callback.release();
+  } catch (rocketmq::MQException& e) {
+    callback->onException(e);
+  } catch (const std::exception& e) {
+    rocketmq::MQException exception(e.what(), -1, __FILE__, __LINE__);
+    callback->onException(exception);
+  }
+}
+
+}  // namespace __node_rocketmq__
@@ -0,0 +1,84 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __ROCKETMQ_SEND_ACCUMULATOR_H__
+#define __ROCKETMQ_SEND_ACCUMULATOR_H__
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <DefaultMQProducer.h>
+#include <MQMessage.h>
+#include <SendCallback.h>
+
+namespace __node_rocketmq__ {
+
+struct InFlightSends;
+
+// 估算单条消息在 MessageBatch 中的编码长度，布局与 MessageDecoder::encodeMessage 一致
+size_t EstimateBatchEntrySize(const rocketmq::MQMessage& message);
+
+// 客户端攒批：按 topic 缓存异步发送的消息，攒满 batch_bytes 或等待 linger 到期后
+// 以批量消息发出，再把批量结果拆分回每条消息原来的回调
+class SendAccumulator {
+ public:
+  SendAccumulator(rocketmq::DefaultMQProducer* producer,
+                  std::chrono::milliseconds linger,
+                  size_t batch_bytes);
+  ~SendAccumulator();
+
+  // 接管 callback 的所有权，与 DefaultMQProducer::send 的 AutoDelete 语义一致
+  void Append(rocketmq::MQMessage&& message, rocketmq::AutoDeleteSendCallback* callback);
+
+  // 立即发出所有缓存中的消息，并等待已发出的批次回报结果（最多 send_msg_timeout），
+  // 生产者 shutdown 前调用
+  void Flush();
+
+ private:
+  struct Batch {
+    std::vector<rocketmq::MQMessage> messages;
+    std::vector<rocketmq::AutoDeleteSendCallback*> callbacks;
+    size_t bytes = 0;
+    std::chrono::steady_clock::time_point deadline;
+  };
+
+  void Run();
+  void Send(Batch&& batch);
+
+ private:
+  rocketmq::DefaultMQProducer* producer_;
+  const std::chrono::milliseconds linger_;
+  const size_t batch_bytes_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::map<std::string, Batch> batches_;
+  bool closed_;
+  // 已从 batches_ 取出但尚未回报结果的批次，回调可能晚于累加器析构，因此共享所有权
+  std::shared_ptr<InFlightSends> in_flight_;
+  std::thread thread_;
+};
+
+}  // namespace __node_rocketmq__
+
+#endif
@@ -0,0 +1,301 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "send_completion_queue.h"
+
+#include <cstdio>
+#include <exception>
+
+#include "common_utils.h"
+
+namespace __node_rocketmq__ {
+
+std::shared_ptr<SendCompletionQueue> SendCompletionQueue::New(Napi::Env env, Napi::Object owner) {
+  std::shared_ptr<SendCompletionQueue> queue(new SendCompletionQueue());
+  queue->env_ = env;
+  queue->owner_ = Napi::Weak(owner);
+  queue->channel_ = Channel::New(env,
+                                 "RocketMQ Send Completion",
+                                 0,
+                                 1,
+                                 queue.get(),
+                                 &Finalize,
+                                 static_cast<void*>(nullptr));
+  // 空闲的通道不阻止进程退出；有未完成的发送时由 Pin 重新 Ref，保证结果能送达
+  queue->channel_.Unref(env);
+  queue->self_ = queue;
+  return queue;
+}
+
+SendCompletionQueue::~SendCompletionQueue() {
+  DeleteList(head_.exchange(nullptr));
+}
+
+uint64_t SendCompletionQueue::Register(Napi::Function callback) {
+  if (slots_.empty()) {
+    Pin();
+  }
+  uint64_t id = ++next_id_;
+  slots_[id].callback = Napi::Persistent(callback);
+  return id;
+}
+
+Napi::Promise SendCompletionQueue::RegisterPromise(Napi::Env env, size_t count, bool many, uint64_t* first_id) {
+  if (slots_.empty()) {
+    Pin();
+  }
+  std::shared_ptr<PromiseGroup> group(
+      new PromiseGroup{Napi::Promise::Deferred::New(env),
+                       Napi::Persistent(Napi::Array::New(env, count)),
+                       count,
+                       0,
+                       many});
+  *first_id = next_id_ + 1;
+  for (size_t i = 0; i < count; i++) {
+    Slot& slot = slots_[++next_id_];
+    slot.group = group;
+    slot.index = static_cast<uint32_t>(i);
+  }
+  return group->deferred.Promise();
+}
+
+void SendCompletionQueue::Unregister(uint64_t id) {
+  if (slots_.erase(id) > 0 && slots_.empty()) {
+    Unpin();
+  }
+}
+
+void SendCompletionQueue::Pin() {
+  if (!owner_.IsEmpty()) {
+    owner_.Ref();
+  }
+  std::lock_guard<std::mutex> lock(channel_mutex_);
+  if (!closed_) {
+    channel_.Ref(env_);
+  }
+}
+
+void SendCompletionQueue::Unpin() {
+  if (!owner_.IsEmpty()) {
+    owner_.Unref();
+  }
+  std::lock_guard<std::mutex> lock(channel_mutex_);
+  if (!closed_) {
+    channel_.Unref(env_);
+  }
+}
+
+void SendCompletionQueue::Succeed(uint64_t id, const rocketmq::SendResult& result) {
+  Push(new Completion{nullptr, id, std::unique_ptr<rocketmq::SendResult>(new rocketmq::SendResult(result)), ""});
+}
+
+void SendCompletionQueue::Fail(uint64_t id, const std::string& error) {
+  Push(new Completion{nullptr, id, nullptr, error});
+}
+
+void SendCompletionQueue::Close() {
+  std::lock_guard<std::mutex> lock(channel_mutex_);
+  if (closed_) {
+    return;
+  }
+  closed_ = true;
+  channel_.Release();
+}
+
+void SendCompletionQueue::Push(Completion* completion) {
+  Completion* head = head_.load(std::memory_order_relaxed);
+  do {
+    completion->next = head;
+  } while (!head_.compare_exchange_weak(head, completion, std::memory_order_release, std::memory_order_relaxed));
+
+  // 同一批结果只唤醒 JS 线程一次
+  if (wake_pending_.exchange(true)) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(channel_mutex_);
+  if (closed_) {
+    return;
+  }
+  napi_status status = napi_ok;
+#if defined(ROCKETMQ_COVERAGE) || defined(ROCKETMQ_USE_STUB)
+  if (IsEnvEnabled("ROCKETMQ_STUB_PRODUCER_BLOCKING_FAIL")) {
+    status = napi_generic_failure;
+  } else {
+    status = channel_.NonBlockingCall();
+  }
+#else
+  status = channel_.NonBlockingCall();
+#endif
+  if (status != napi_ok) {
+    // 唤醒失败时结果留在队列中，由下一次成功的唤醒一并投递
+    fprintf(stderr, "[RocketMQ] Failed to schedule JavaScript callback: %d\n", status);
+    wake_pending_.store(false);
+  }
+}
+
+void SendCompletionQueue::DeleteList(Completion* head) {
+  while (head != nullptr) {
+    Completion* next = head->next;
+    delete head;
+    head = next;
+  }
+}
+
+void SendCompletionQueue::Drain(Napi::Env env) {
+  // 先清除唤醒标记再摘取队列，之后入队的结果会触发新的唤醒
+  wake_pending_.store(false);
+  Completion* head = head_.exchange(nullptr, std::memory_order_acquire);
+
+  Completion* ordered = nullptr;
+  while (head != nullptr) {
+    Completion* next = head->next;
+    head->next = ordered;
+    ordered = head;
+    head = next;
+  }
+
+  std::unique_ptr<Napi::Error> first_error;
+  while (ordered != nullptr) {
+    std::unique_ptr<Completion> completion(ordered);
+    ordered = ordered->next;
+
+    auto it = slots_.find(completion->id);
+    if (it == slots_.end()) {
+      continue;
+    }
+    Slot slot = std::move(it->second);
+    Unregister(completion->id);
+
+    Napi::HandleScope scope(env);
+    try {
+#if defined(ROCKETMQ_COVERAGE) || defined(ROCKETMQ_USE_STUB)
+      if (IsEnvEnabled("ROCKETMQ_STUB_PRODUCER_CALLJS_THROW")) {
+        throw Napi::Error::New(env, "producer calljs throw");
+      }
+#endif
+      Settle(env, slot, *completion);
+    } catch (const Napi::Error& e) {
+      // 某个回调抛错不影响同批其他回调，全部投递后再抛出第一个错误
+      if (!first_error) {
+        first_error.reset(new Napi::Error(e));
+      }
+    } catch (const std::exception& e) {
+      fprintf(stderr, "[RocketMQ] Warning: Exception in send callback: %s\n", e.what());
+    }
+  }
+
+  if (first_error) {
+    first_error->ThrowAsJavaScriptException();
+  }
+}
+
+static const char* SendStatusName(int status) {
+  switch (status) {
+    case 0: return "OK";
+    case 1: return "FLUSH_DISK_TIMEOUT";
+    case 2: return "FLUSH_SLAVE_TIMEOUT";
+    case 3: return "SLAVE_NOT_AVAILABLE";
+    default: return "UNKNOWN";
+  }
+}
+
+void SendCompletionQueue::Settle(Napi::Env env, const Slot& slot, const Completion& completion) {
+  if (!slot.group) {
+    if (!completion.result) {
+      slot.callback.Call(env.Global(), {Napi::Error::New(env, completion.error).Value()});
+    } else {
+      slot.callback.Call(env.Global(),
+                         {env.Undefined(),
+                          Napi::Number::New(env, completion.result->send_status()),
+                          Napi::String::New(env, completion.result->msg_id()),
+                          Napi::Number::New(env, completion.result->queue_offset())});
+    }
+    return;
+  }
+
+  // Promise 风格：直接构造与 JS 层 SendResult 相同形状的对象
+  PromiseGroup& group = *slot.group;
+  Napi::Object result = Napi::Object::New(env);
+  Napi::Error error;
+  if (completion.result) {
+    int status = static_cast<int>(completion.result->send_status());
+    result.Set("status", Napi::Number::New(env, status));
+    result.Set("statusStr", Napi::String::New(env, SendStatusName(status)));
+    result.Set("msgId", Napi::String::New(env, completion.result->msg_id()));
+    result.Set("offset", Napi::Number::New(env, static_cast<double>(completion.result->queue_offset())));
+  } else {
+    error = Napi::Error::New(env, completion.error);
+    result.Set("status", Napi::Number::New(env, -1));
+    result.Set("statusStr", Napi::String::New(env, "FAILED"));
+    result.Set("msgId", Napi::String::New(env, ""));
+    result.Set("offset", Napi::Number::New(env, 0));
+    result.Set("error", error.Value());
+    group.failed++;
+  }
+
+  if (!group.many) {
+    if (completion.result) {
+      group.deferred.Resolve(result);
+    } else {
+      group.deferred.Reject(error.Value());
+    }
+    return;
+  }
+
+  Napi::Array results = group.results.Value();
+  results.Set(slot.index, result);
+  if (--group.remaining > 0) {
+    return;
+  }
+  if (group.failed == results.Length()) {
+    group.deferred.Reject(results.Get(static_cast<uint32_t>(0)).As<Napi::Object>().Get("error"));
+  } else {
+    group.deferred.Resolve(results);
+  }
+}
+
+void SendCompletionQueue::CallJs(Napi::Env env, Napi::Function, SendCompletionQueue* queue, std::nullptr_t*) {
+#if defined(ROCKETMQ_COVERAGE) || defined(ROCKETMQ_USE_STUB)
+  if (env == nullptr || queue == nullptr || IsEnvEnabled("ROCKETMQ_STUB_PRODUCER_CALLJS_NULL_ENV")) {
+#else
+  if (env == nullptr || queue == nullptr) {
+#endif
+    return;
+  }
+  queue->Drain(env);
+}
+
+void SendCompletionQueue::Finalize(Napi::Env, void*, SendCompletionQueue* queue) {
+  // 在 JS 线程释放所有 JS 引用，之后队列即便由发送线程最后析构也不会触碰 JS 对象
+  std::shared_ptr<SendCompletionQueue> self = std::move(queue->self_);
+  queue->slots_.clear();
+  queue->owner_.Reset();
+}
+
+void ProducerSendCallback::onSuccess(rocketmq::SendResult& send_result) {
+  queue_->Succeed(id_, send_result);
+}
+
+void ProducerSendCallback::onException(rocketmq::MQException& exception) noexcept {
+  try {
+    queue_->Fail(id_, exception.what());
+  } catch (...) {
+    fprintf(stderr, "[RocketMQ] Warning: Failed to report send exception\n");
+  }
+}
+
+}  // namespace __node_rocketmq__
@@ -0,0 +1,131 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __ROCKETMQ_SEND_COMPLETION_QUEUE_H__
+#define __ROCKETMQ_SEND_COMPLETION_QUEUE_H__
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <napi.h>
+
+#include <MQException.h>
+#include <SendCallback.h>
+
+namespace __node_rocketmq__ {
+
+// 生产者级别的发送完成通道：一个长期存活的 TSFN 加一个无锁 MPSC 队列。
+// 发送线程只入队 {回调 id, 结果}，JS 线程被唤醒后整批取出，再从槽位表找到对应的
+// JS 回调或 Promise。
+class SendCompletionQueue {
+ public:
+  static std::shared_ptr<SendCompletionQueue> New(Napi::Env env, Napi::Object owner);
+  ~SendCompletionQueue();
+
+  // 以下方法只能在 JS 线程调用
+  uint64_t Register(Napi::Function callback);
+  // 为 count 条消息登记一个 Promise，槽位 id 为 *first_id 起连续的 count 个。
+  // many 为 false 时以单个结果 resolve，否则以结果数组 resolve，全部失败时 reject
+  Napi::Promise RegisterPromise(Napi::Env env, size_t count, bool many, uint64_t* first_id);
+  void Unregister(uint64_t id);
+
+  // 任意线程调用
+  void Succeed(uint64_t id, const rocketmq::SendResult& result);
+  void Fail(uint64_t id, const std::string& error);
+
+  // 生产者析构时调用，释放 TSFN；已入队的结果仍会被投递
+  void Close();
+
+ private:
+  struct Completion {
+    Completion* next;
+    uint64_t id;
+    std::unique_ptr<rocketmq::SendResult> result;
+    std::string error;
+  };
+
+  struct PromiseGroup {
+    Napi::Promise::Deferred deferred;
+    Napi::Reference<Napi::Array> results;
+    size_t remaining;
+    size_t failed;
+    bool many;
+  };
+
+  struct Slot {
+    Napi::FunctionReference callback;
+    std::shared_ptr<PromiseGroup> group;
+    uint32_t index = 0;
+  };
+
+  SendCompletionQueue() = default;
+
+  // 槽位表由空变为非空时调用：强引用生产者并让 TSFN 保持事件循环存活，
+  // 否则没有其他句柄的脚本会在结果送达前退出；Unpin 在槽位表清空时撤销
+  void Pin();
+  void Unpin();
+
+  void Push(Completion* completion);
+  void Drain(Napi::Env env);
+  static void Settle(Napi::Env env, const Slot& slot, const Completion& completion);
+  static void DeleteList(Completion* head);
+
+  static void CallJs(Napi::Env env, Napi::Function, SendCompletionQueue* queue, std::nullptr_t*);
+  static void Finalize(Napi::Env, void*, SendCompletionQueue* queue);
+
+  using Channel = Napi::TypedThreadSafeFunction<SendCompletionQueue, std::nullptr_t, &CallJs>;
+
+  // 无锁 MPSC 栈，Drain 时整体摘下并反转成 FIFO
+  std::atomic<Completion*> head_{nullptr};
+  std::atomic<bool> wake_pending_{false};
+
+  // 保护 channel_ 的关闭，避免在 Release 之后继续调用
+  std::mutex channel_mutex_;
+  Channel channel_;
+  bool closed_ = false;
+
+  // 仅在 JS 线程访问
+  Napi::Env env_ = Napi::Env(nullptr);
+  uint64_t next_id_ = 0;
+  std::unordered_map<uint64_t, Slot> slots_;
+  // 有未完成的发送时强引用生产者，防止其被 GC
+  Napi::ObjectReference owner_;
+
+  // TSFN 存活期间持有自身，在 Finalize 中释放
+  std::shared_ptr<SendCompletionQueue> self_;
+};
+
+// 发送回调只负责把结果写入完成队列
+class ProducerSendCallback : public rocketmq::AutoDeleteSendCallback {
+ public:
+  ProducerSendCallback(std::shared_ptr<SendCompletionQueue> queue, uint64_t id)
+      : queue_(std::move(queue)), id_(id) {}
+
+  void onSuccess(rocketmq::SendResult& send_result) override;
+  void onException(rocketmq::MQException& exception) noexcept override;
+
+ private:
+  std::shared_ptr<SendCompletionQueue> queue_;
+  uint64_t id_;
+};
+
+}  // namespace __node_rocketmq__
+
+#endif
@@ -90,6 +90,22 @@ function loadBinding(): NativeBinding {
   );
 }
 
+export interface NativeSendResult {
+  status: number;
+  statusStr: string;
+  msgId: string;
+  offset: number;
+  error?: Error;
+}
+
+export interface NativeBatchSendResult {
+  count: number;
+  status?: number;
+  msgId?: string;
+  offset?: number;
+  error?: Error;
+}
+
 export interface NativeProducer {
   start(callback: (err: Error | null) => void): void;
   shutdown(callback: (err: Error | null) => void): void;
@@ -99,6 +115,22 @@ export interface NativeProducer {
     options: Record<string, any>,
     callback: (err: Error | null, status?: number, msgId?: string, offset?: number) => void
   ): void;
+  sendAsync(
+    topic: string,
+    body: string | Buffer,
+    options: Record<string, any>
+  ): Promise<NativeSendResult>;
+  sendMany(
+    topic: string,
+    bodies: Array<string | Buffer>,
+    options: Record<string, any>
+  ): Promise<NativeSendResult[]>;
+  sendBatch(
+    topic: string,
+    bodies: Array<string | Buffer>,
+    options: Record<string, any>,
+    callback: (err: Error | null, results?: NativeBatchSendResult[]) => void
+  ): void;
   setSessionCredentials(accessKey: string, secretKey: string, onsChannel: string): void;
 }
 
@@ -106,13 +138,34 @@ export interface NativePushConsumer {
   start(callback: (err: Error | null) => void): void;
   shutdown(callback: (err: Error | null) => void): void;
   subscribe(topic: string, expression: string): void;
-  setListener(callback: (msg: any, ack: any) => void): void;
+  setListener(callback: (msg: any, ack: any) => void, options?: { batch?: boolean; async?: boolean; binary?: boolean; lazy?: boolean; orderly?: boolean }): void;
+  setSessionCredentials(accessKey: string, secretKey: string, onsChannel: string): void;
+}
+
+export interface NativeMessageQueue {
+  topic: string;
+  brokerName: string;
+  queueId: number;
+}
+
+export interface NativeLitePullConsumer {
+  start(callback: (err: Error | null) => void): void;
+  shutdown(callback: (err: Error | null) => void): void;
+  subscribe(topic: string, expression: string): void;
+  assign(queues: NativeMessageQueue[]): void;
+  pause(queues: NativeMessageQueue[]): void;
+  resume(queues: NativeMessageQueue[]): void;
+  poll(timeout?: number): Promise<any[]>;
+  seek(queue: NativeMessageQueue, offset: number): Promise<void>;
+  commit(): Promise<void>;
+  fetchMessageQueues(topic: string): Promise<NativeMessageQueue[]>;
   setSessionCredentials(accessKey: string, secretKey: string, onsChannel: string): void;
 }
 
 export interface NativeBinding {
   Producer: new (groupId: string, instanceName?: string | null, options?: Record<string, any>) => NativeProducer;
   PushConsumer: new (groupId: string, instanceName?: string | null, options?: Record<string, any>) => NativePushConsumer;
+  LitePullConsumer: new (groupId: string, instanceName?: string | null, options?: Record<string, any>) => NativeLitePullConsumer;
 }
 
 const nativeBinding: NativeBinding = loadBinding();
@@ -10,6 +10,19 @@ export interface PushConsumerOptions {
   threadCount?: number;
   maxBatchSize?: number;
   maxReconsumeTimes?: number;
+  pullThresholdSizeForQueue?: number;
+  pullThresholdSizeForAll?: number;
+  consumeMaxSpan?: number;
+  batchListener?: boolean;
+  asyncConsume?: boolean;
+  /**
+   * consume each message queue in order: batches of a queue are emitted as `messages`
+   * one after another, implies `batchListener` and `asyncConsume`
+   */
+  orderly?: boolean;
+  binaryBody?: boolean;
+  lazyMessage?: boolean;
+  binaryHeader?: boolean;
   logLevel?: LogLevel | keyof typeof LogLevel;
   logDir?: string;
   logFileSize?: number;
@@ -20,12 +33,30 @@ export interface Message {
   topic: string;
   tags: string;
   keys: string;
-  body: string;
+  body: string | Buffer;
   msgId: string;
 }
 
+/**
+ * Message delivered when `lazyMessage` is enabled. Fields are read from the
+ * native message on access instead of being copied up front.
+ */
+export interface MessageView extends Message {
+  readonly properties: Record<string, string>;
+  readonly queueId: number;
+  readonly queueOffset: number;
+  readonly bornTimestamp: number;
+  readonly storeTimestamp: number;
+  readonly reconsumeTimes: number;
+  toJSON(): Omit<MessageView, 'toJSON'>;
+}
+
 export interface ConsumerAck {
-  done(success?: boolean): void;
+  /**
+   * Acknowledge the message (or batch). For a batch, pass one entry per message:
+   * only the messages without a truthy entry are consumed again later.
+   */
+  done(success?: boolean | boolean[]): void;
 }
 
 type Callback<T = void> = (err?: Error | null, result?: T) => void;
@@ -35,7 +66,8 @@ let timer: NodeJS.Timeout | undefined;
 
 export interface RocketMQPushConsumerEvents {
   message: (msg: Message, ack: ConsumerAck) => void;
-  error: (err: Error, msg?: Message, ack?: ConsumerAck) => void;
+  messages: (msgs: Message[], ack: ConsumerAck) => void;
+  error: (err: Error, msg?: Message | Message[], ack?: ConsumerAck) => void;
 }
 
 export declare interface RocketMQPushConsumer {
@@ -77,10 +109,20 @@ export class RocketMQPushConsumer extends EventEmitter {
       actualOptions.logLevel = LogLevel[actualOptions.logLevel.toUpperCase() as keyof typeof LogLevel] || LogLevel.INFO;
     }
 
+    const orderly = !!actualOptions.orderly;
+    const batch = orderly || !!actualOptions.batchListener;
+    const asyncConsume = orderly || !!actualOptions.asyncConsume;
+    const binary = !!actualOptions.binaryBody;
+    const lazy = !!actualOptions.lazyMessage;
+
     this.core = new binding.PushConsumer(groupId, actualInstanceName, actualOptions);
     this.core.setListener((msg, ack) => {
       try {
-        this.emit('message', msg, ack);
+        if (batch) {
+          this.emit('messages', msg, ack);
+        } else {
+          this.emit('message', msg, ack);
+        }
       } catch (err) {
         try {
           if (ack && typeof ack.done === 'function') {
@@ -97,7 +139,7 @@ export class RocketMQPushConsumer extends EventEmitter {
           }
         }
       }
-    });
+    }, { batch, async: asyncConsume, binary, lazy, orderly });
     this.status = Status.STOPPED;
     this.operationQueue = Promise.resolve();
   }
@@ -1,9 +1,12 @@
-export { RocketMQProducer, SendResultStatus, ProducerOptions, SendOptions, SendResult } from './producer';
-export { RocketMQPushConsumer, PushConsumerOptions, Message, ConsumerAck } from './consumer';
+export { RocketMQProducer, SendResultStatus, ProducerOptions, SendOptions, SendResult, SendManyResult, BatchSendResult } from './producer';
+export { RocketMQPushConsumer, PushConsumerOptions, Message, MessageView, ConsumerAck } from './consumer';
+export { RocketMQLitePullConsumer, LitePullConsumerOptions, MessageQueue } from './lite_pull_consumer';
 export { LogLevel, Status } from './constants';
 
 import { RocketMQProducer } from './producer';
 import { RocketMQPushConsumer } from './consumer';
+import { RocketMQLitePullConsumer } from './lite_pull_consumer';
 
 export const Producer = RocketMQProducer;
 export const PushConsumer = RocketMQPushConsumer;
+export const LitePullConsumer = RocketMQLitePullConsumer;
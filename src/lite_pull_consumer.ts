@@ -0,0 +1,233 @@
+import binding, { NativeLitePullConsumer } from './binding';
+import { LogLevel, Status } from './constants';
+import { Message } from './consumer';
+
+const START_OR_SHUTDOWN = Symbol('RocketMQLitePullConsumer#startOrShutdown');
+
+export interface LitePullConsumerOptions {
+  nameServer?: string;
+  groupName?: string;
+  pullBatchSize?: number;
+  pullThreadNums?: number;
+  autoCommit?: boolean;
+  autoCommitIntervalMillis?: number;
+  pollTimeoutMillis?: number;
+  pollBatchMaxSize?: number;
+  pollBatchMaxBytes?: number;
+  pullThresholdForAll?: number;
+  pullThresholdSizeForQueue?: number;
+  pullThresholdSizeForAll?: number;
+  consumeMaxSpan?: number;
+  binaryBody?: boolean;
+  lazyMessage?: boolean;
+  binaryHeader?: boolean;
+  logLevel?: LogLevel | keyof typeof LogLevel;
+  logDir?: string;
+  logFileSize?: number;
+  logFileNum?: number;
+}
+
+export interface MessageQueue {
+  topic: string;
+  brokerName: string;
+  queueId: number;
+}
+
+type Callback<T = void> = (err?: Error | null, result?: T) => void;
+
+export class RocketMQLitePullConsumer {
+  public core: NativeLitePullConsumer;
+  public status: Status;
+  private operationQueue: Promise<void>;
+
+  /**
+   * RocketMQ LitePullConsumer constructor
+   * @param groupId the group id
+   * @param instanceName the instance name
+   * @param options the options
+   */
+  constructor(groupId: string, instanceName?: string | LitePullConsumerOptions, options?: LitePullConsumerOptions) {
+    let actualInstanceName: string | null = null;
+    let actualOptions: LitePullConsumerOptions = {};
+
+    if (typeof instanceName !== 'string') {
+      actualOptions = instanceName || {};
+    } else {
+      actualInstanceName = instanceName;
+      actualOptions = options || {};
+    }
+
+    if (actualOptions.logLevel && typeof actualOptions.logLevel === 'string') {
+      actualOptions.logLevel = LogLevel[actualOptions.logLevel.toUpperCase() as keyof typeof LogLevel] || LogLevel.INFO;
+    }
+
+    this.core = new binding.LitePullConsumer(groupId, actualInstanceName, actualOptions);
+    this.status = Status.STOPPED;
+    this.operationQueue = Promise.resolve();
+  }
+
+  /**
+   * Set session credentials (usually used in Alibaba MQ)
+   * @param accessKey the access key
+   * @param secretKey the secret key
+   * @param onsChannel the ons channel
+   * @return the result
+   */
+  setSessionCredentials(accessKey: string, secretKey: string, onsChannel: string): boolean {
+    if (typeof accessKey !== 'string') throw new TypeError('accessKey must be a string');
+    if (typeof secretKey !== 'string') throw new TypeError('secretKey must be a string');
+    if (typeof onsChannel !== 'string') throw new TypeError('onsChannel must be a string');
+
+    this.core.setSessionCredentials(accessKey, secretKey, onsChannel);
+    return true;
+  }
+
+  private [START_OR_SHUTDOWN](method: 'start' | 'shutdown'): Promise<void>;
+  private [START_OR_SHUTDOWN](method: 'start' | 'shutdown', callback: Callback): void;
+  private [START_OR_SHUTDOWN](method: 'start' | 'shutdown', callback?: Callback): void | Promise<void> {
+    let promise: Promise<void> | undefined;
+    let resolve: (value?: void) => void;
+    let reject: (err: Error) => void;
+
+    if (!callback) {
+      promise = new Promise<void>((_resolve, _reject) => {
+        resolve = _resolve;
+        reject = _reject;
+      });
+    } else {
+      resolve = () => callback(null);
+      reject = callback;
+    }
+
+    // 将操作加入队列，确保串行执行
+    this.operationQueue = this.operationQueue
+      .then(() => {
+        return new Promise<void>((queueResolve) => {
+          if (method === 'start') {
+            if (this.status !== Status.STOPPED) {
+              queueResolve();
+              return reject(new Error(this.status === Status.STOPPING
+                ? 'Consumer is stopping, please wait for shutdown to complete'
+                : 'Consumer is already started'));
+            }
+            this.status = Status.STARTING;
+          } else {
+            if (this.status !== Status.STARTED) {
+              queueResolve();
+              return reject(new Error(this.status === Status.STARTING
+                ? 'Consumer is starting, please wait for start to complete'
+                : 'Consumer is already stopped'));
+            }
+            this.status = Status.STOPPING;
+          }
+
+          this.core[method]((err) => {
+            if (err) {
+              // 回滚状态
+              this.status = method === 'start' ? Status.STOPPED : Status.STARTED;
+              queueResolve();
+              return reject(err);
+            }
+
+            this.status = method === 'start' ? Status.STARTED : Status.STOPPED;
+            queueResolve();
+            resolve();
+          });
+        });
+      })
+      .catch((err) => {
+        if (process.env.NODE_ENV !== 'production') {
+          console.error('[RocketMQ] Operation queue error:', err);
+        }
+      }); // 防止队列中断
+
+    return promise;
+  }
+
+  /**
+   * Start the lite pull consumer
+   * @param callback the callback function
+   * @return returns a Promise if no callback
+   */
+  start(): Promise<void>;
+  start(callback: Callback): void;
+  start(callback?: Callback): void | Promise<void> {
+    return this[START_OR_SHUTDOWN]('start', callback as any);
+  }
+
+  /**
+   * Shutdown the lite pull consumer
+   * @param callback the callback function
+   * @return returns a Promise if no callback
+   */
+  shutdown(): Promise<void>;
+  shutdown(callback: Callback): void;
+  shutdown(callback?: Callback): void | Promise<void> {
+    return this[START_OR_SHUTDOWN]('shutdown', callback as any);
+  }
+
+  /**
+   * subscribe a topic, queues are then rebalanced within the consumer group
+   * @param topic the topic to be subscribed
+   * @param expression the additional expression to be subscribed
+   */
+  subscribe(topic: string, expression: string = '*'): void {
+    if (!topic || typeof topic !== 'string') {
+      throw new Error('Topic must be a non-empty string');
+    }
+    if (expression && typeof expression !== 'string') {
+      throw new Error('Expression must be a string if provided');
+    }
+    this.core.subscribe(topic, expression || '*');
+  }
+
+  /**
+   * Consume exactly the given queues instead of subscribing to topics
+   * @param queues the message queues to be consumed
+   */
+  assign(queues: MessageQueue[]): void {
+    this.core.assign(queues);
+  }
+
+  /**
+   * Stop pulling from the given queues until they are resumed
+   */
+  pause(queues: MessageQueue[]): void {
+    this.core.pause(queues);
+  }
+
+  resume(queues: MessageQueue[]): void {
+    this.core.resume(queues);
+  }
+
+  /**
+   * Poll the next batch of messages. The wait happens off the JS thread and the
+   * whole batch is delivered at once; an empty array means the timeout elapsed.
+   * Only one poll may be pending per consumer, a second one throws until it settles.
+   * @param timeout the max time to wait in milliseconds, defaults to `pollTimeoutMillis`
+   */
+  poll(timeout?: number): Promise<Message[]> {
+    return this.core.poll(timeout);
+  }
+
+  /**
+   * Reset the offset that the next pull of the queue starts from, dropping
+   * messages already cached for it
+   */
+  seek(queue: MessageQueue, offset: number): Promise<void> {
+    return this.core.seek(queue, offset);
+  }
+
+  /**
+   * Commit the offsets of the messages polled so far, needed when `autoCommit` is false
+   */
+  commit(): Promise<void> {
+    return this.core.commit();
+  }
+
+  fetchMessageQueues(topic: string): Promise<MessageQueue[]> {
+    return this.core.fetchMessageQueues(topic);
+  }
+}
+
+export default RocketMQLitePullConsumer;
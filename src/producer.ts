@@ -23,7 +23,11 @@ export interface ProducerOptions {
   groupName?: string;
   maxMessageSize?: number;
   compressLevel?: number;
+  compressionType?: 'zlib' | 'zstd' | 'lz4';
   sendMessageTimeout?: number;
+  lingerMs?: number;
+  batchBytes?: number;
+  binaryHeader?: boolean;
   logLevel?: LogLevel | keyof typeof LogLevel;
   logDir?: string;
   logFileSize?: number;
@@ -42,6 +46,18 @@ export interface SendResult {
   offset: number;
 }
 
+export interface SendManyResult extends SendResult {
+  /** set when this message failed */
+  error?: Error;
+}
+
+export interface BatchSendResult extends SendResult {
+  /** number of messages carried by this batch */
+  count: number;
+  /** set when this batch failed; the other batches may still have been sent */
+  error?: Error;
+}
+
 type Callback<T = void> = (err?: Error | null, result?: T) => void;
 
 let producerRef = 0;
@@ -274,31 +290,142 @@ export class RocketMQProducer {
       return actualCallback ? actualCallback(null, ret) : Promise.resolve(ret);
     }
 
-    let promise: Promise<SendResult> | undefined;
-    let resolve: (value: SendResult) => void;
+    // 不传回调时由原生层直接返回 Promise 和结果对象
+    if (!actualCallback) {
+      return this.core.sendAsync(topic, body, actualOptions);
+    }
+
+    const done = actualCallback;
+    this.core.send(topic, body, actualOptions, (err, status, msgId, offset) => {
+      if (err) {
+        return done(err);
+      }
+
+      const ret: SendResult = {
+        status: status || 0,
+        statusStr: SEND_RESULT_STATUS_STR[status || 0] || 'UNKNOWN',
+        msgId: msgId || '',
+        offset: offset || 0
+      };
+      done(null, ret);
+    });
+  }
+
+  /**
+   * Send several messages to one topic, one message per request, and resolve
+   * with their results in input order. Failed messages carry an `error`; the
+   * promise only rejects when every message failed.
+   * @param topic the topic
+   * @param bodies the message bodies
+   * @param options the options, applied to every message
+   * @return a Promise of the per-message results
+   */
+  sendMany(topic: string, bodies: Array<string | Buffer>, options?: SendOptions): Promise<SendManyResult[]> {
+    if (typeof topic !== 'string') throw new TypeError('topic must be a string');
+    if (!Array.isArray(bodies)) throw new TypeError('bodies must be an array');
+    for (const body of bodies) {
+      if (typeof body !== 'string' && !Buffer.isBuffer(body)) {
+        throw new TypeError('body must be a string or Buffer');
+      }
+    }
+
+    if (this.status !== Status.STARTED) {
+      return Promise.reject(
+        new Error(`Producer must be started before sending messages. Current status: ${this.getStatusName()}`)
+      );
+    }
+
+    return this.core.sendMany(topic, bodies, options || {});
+  }
+
+  /**
+   * Send several messages to one topic as batch messages. The bodies are split
+   * natively into as few batches as `maxMessageSize` allows and one result is
+   * reported per batch, in order. The call only fails when every batch failed.
+   * @param topic the topic
+   * @param bodies the message bodies
+   * @param options the options, applied to every message
+   * @param callback the callback function
+   * @return returns a Promise if no callback
+   */
+  sendBatch(topic: string, bodies: Array<string | Buffer>, options?: SendOptions): Promise<BatchSendResult[]>;
+  sendBatch(topic: string, bodies: Array<string | Buffer>, callback: Callback<BatchSendResult[]>): void;
+  sendBatch(
+    topic: string,
+    bodies: Array<string | Buffer>,
+    options: SendOptions,
+    callback: Callback<BatchSendResult[]>
+  ): void;
+  sendBatch(
+    topic: string,
+    bodies: Array<string | Buffer>,
+    options?: SendOptions | Callback<BatchSendResult[]>,
+    callback?: Callback<BatchSendResult[]>
+  ): void | Promise<BatchSendResult[]> {
+    if (typeof topic !== 'string') throw new TypeError('topic must be a string');
+    if (!Array.isArray(bodies)) throw new TypeError('bodies must be an array');
+    for (const body of bodies) {
+      if (typeof body !== 'string' && !Buffer.isBuffer(body)) {
+        throw new TypeError('body must be a string or Buffer');
+      }
+    }
+
+    let actualOptions: SendOptions = {};
+    let actualCallback: Callback<BatchSendResult[]> | undefined;
+
+    if (typeof options === 'function') {
+      actualCallback = options;
+    } else {
+      actualOptions = options || {};
+      actualCallback = callback;
+    }
+
+    if (this.status !== Status.STARTED) {
+      const err = new Error(`Producer must be started before sending messages. Current status: ${this.getStatusName()}`);
+      return actualCallback ? actualCallback(err) : Promise.reject(err);
+    }
+
+    if (!bodies.length) {
+      return actualCallback ? actualCallback(null, []) : Promise.resolve([]);
+    }
+
+    let promise: Promise<BatchSendResult[]> | undefined;
+    let resolve: (value: BatchSendResult[]) => void;
     let reject: (err: Error) => void;
 
     if (!actualCallback) {
-      promise = new Promise<SendResult>((_resolve, _reject) => {
+      promise = new Promise<BatchSendResult[]>((_resolve, _reject) => {
         resolve = _resolve;
         reject = _reject;
       });
     } else {
-      resolve = (result: SendResult) => actualCallback(null, result);
+      resolve = (results: BatchSendResult[]) => actualCallback(null, results);
       reject = actualCallback;
     }
 
-    this.core.send(topic, body, actualOptions, (err, status, msgId, offset) => {
+    this.core.sendBatch(topic, bodies, actualOptions, (err, results) => {
       if (err) {
         return reject(err);
       }
 
-      const ret: SendResult = {
-        status: status || 0,
-        statusStr: SEND_RESULT_STATUS_STR[status || 0] || 'UNKNOWN',
-        msgId: msgId || '',
-        offset: offset || 0
-      };
+      const ret: BatchSendResult[] = (results || []).map((result) => {
+        if (result.error) {
+          return { status: -1, statusStr: 'FAILED', msgId: '', offset: 0, count: result.count, error: result.error };
+        }
+        const status = result.status || 0;
+        return {
+          status,
+          statusStr: SEND_RESULT_STATUS_STR[status] || 'UNKNOWN',
+          msgId: result.msgId || '',
+          offset: result.offset || 0,
+          count: result.count
+        };
+      });
+
+      const failed = ret.find((result) => result.error);
+      if (failed && ret.every((result) => result.error)) {
+        return reject(failed.error as Error);
+      }
       resolve(ret);
     });
 
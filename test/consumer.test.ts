@@ -1,6 +1,8 @@
 'use strict';
 
 import { describe, test, expect } from 'vitest';
+import * as fs from 'fs';
+import * as os from 'os';
 import * as path from 'path';
 import { LogLevel, Status } from '../src/constants';
 
@@ -184,6 +186,298 @@ describe('PushConsumer tests', () => {
       }
     });
 
+    test('batch listener delivers whole batch with single ack', async () => {
+      const env = { ROCKETMQ_STUB_CONSUME_MESSAGE: '1', ROCKETMQ_STUB_MESSAGE_COUNT: '3' };
+      const original = setEnv(env);
+      let consumer: any;
+      try {
+        consumer = new RocketMQPushConsumer('G1', { maxBatchSize: 3, batchListener: true });
+        let single = 0;
+        consumer.on('message', () => {
+          single++;
+        });
+        const batch = new Promise((resolve) => {
+          consumer.once('messages', (msgs: any, ack: any) => {
+            ack.done();
+            resolve(msgs);
+          });
+        });
+        await consumer.start();
+        const msgs: any = await batch;
+        expect(Array.isArray(msgs)).toBe(true);
+        expect(msgs).toHaveLength(3);
+        expect(msgs[0].topic).toBe('TopicTest');
+        expect(msgs[2].body).toBe('Hello');
+        expect(single).toBe(0);
+        await consumer.shutdown();
+        consumer = null;
+      } finally {
+        if (consumer && consumer.status === Status.STARTED) {
+          await consumer.shutdown();
+        }
+        restoreEnv(env, original);
+      }
+    });
+
+    test('batch listener acks each message of the batch', async () => {
+      const env = { ROCKETMQ_STUB_CONSUME_MESSAGE: '1', ROCKETMQ_STUB_MESSAGE_COUNT: '3' };
+      const original = setEnv(env);
+      let consumer: any;
+      try {
+        consumer = new RocketMQPushConsumer('G1', { maxBatchSize: 3, batchListener: true });
+        const batch = new Promise((resolve) => {
+          consumer.once('messages', (msgs: any, ack: any) => {
+            ack.done([true, false, true]);
+            ack.done(false);
+            resolve(msgs);
+          });
+        });
+        await consumer.start();
+        const msgs: any = await batch;
+        expect(msgs).toHaveLength(3);
+        await consumer.shutdown();
+        consumer = null;
+      } finally {
+        if (consumer && consumer.status === Status.STARTED) {
+          await consumer.shutdown();
+        }
+        restoreEnv(env, original);
+      }
+    });
+
+    test('async batch listener acks each message of the batch', async () => {
+      const env = { ROCKETMQ_STUB_CONSUME_MESSAGE: '1', ROCKETMQ_STUB_MESSAGE_COUNT: '2' };
+      const original = setEnv(env);
+      let consumer: any;
+      try {
+        consumer = new RocketMQPushConsumer('G1', { batchListener: true, asyncConsume: true });
+        const batch = new Promise((resolve) => {
+          consumer.once('messages', (msgs: any, ack: any) => {
+            ack.done([false]);
+            resolve(msgs);
+          });
+        });
+        await consumer.start();
+        const msgs: any = await batch;
+        expect(msgs).toHaveLength(2);
+        await consumer.shutdown();
+        consumer = null;
+      } finally {
+        if (consumer && consumer.status === Status.STARTED) {
+          await consumer.shutdown();
+        }
+        restoreEnv(env, original);
+      }
+    });
+
+    test('binary body delivers a Buffer', async () => {
+      const env = { ROCKETMQ_STUB_CONSUME_MESSAGE: '1' };
+      const original = setEnv(env);
+      let consumer: any;
+      try {
+        consumer = new RocketMQPushConsumer('G1', { binaryBody: true });
+        const received = new Promise((resolve) => {
+          consumer.once('message', (msg: any, ack: any) => {
+            ack.done();
+            resolve(msg);
+          });
+        });
+        await consumer.start();
+        const msg: any = await received;
+        expect(Buffer.isBuffer(msg.body)).toBe(true);
+        expect(msg.body.toString()).toBe('Hello');
+        await consumer.shutdown();
+        consumer = null;
+      } finally {
+        if (consumer && consumer.status === Status.STARTED) {
+          await consumer.shutdown();
+        }
+        restoreEnv(env, original);
+      }
+    });
+
+    test('writing to a binary body does not change the redelivered message', async () => {
+      const env = { ROCKETMQ_STUB_CONSUME_MESSAGE: '1' };
+      const original = setEnv(env);
+      let consumer: any;
+      try {
+        consumer = new RocketMQPushConsumer('G1', { orderly: true, binaryBody: true });
+        const bodies: string[] = [];
+        const redelivered = new Promise<void>((resolve) => {
+          consumer.on('messages', (msgs: any[], ack: any) => {
+            bodies.push(msgs[0].body.toString());
+            if (bodies.length === 1) {
+              msgs[0].body.write('J');
+              ack.done(false);
+            } else {
+              ack.done();
+              resolve();
+            }
+          });
+        });
+        await consumer.start();
+        await redelivered;
+        expect(bodies).toEqual(['Hello', 'Hello']);
+        await consumer.shutdown();
+        consumer = null;
+      } finally {
+        if (consumer && consumer.status === Status.STARTED) {
+          await consumer.shutdown();
+        }
+        restoreEnv(env, original);
+      }
+    });
+
+    test('lazy message exposes metadata through getters', async () => {
+      const env = {
+        ROCKETMQ_STUB_CONSUME_MESSAGE: '1',
+        ROCKETMQ_STUB_MESSAGE_QUEUE_OFFSET: '42',
+        ROCKETMQ_STUB_MESSAGE_RECONSUME_TIMES: '2',
+      };
+      const original = setEnv(env);
+      let consumer: any;
+      try {
+        consumer = new RocketMQPushConsumer('G1', { lazyMessage: true, binaryBody: true });
+        const received = new Promise((resolve) => {
+          consumer.once('message', (msg: any, ack: any) => {
+            ack.done();
+            resolve(msg);
+          });
+        });
+        await consumer.start();
+        const msg: any = await received;
+        expect(msg.topic).toBe('TopicTest');
+        expect(msg.msgId).toBe('MSGID');
+        expect(msg.body.toString()).toBe('Hello');
+        expect(msg.queueOffset).toBe(42);
+        expect(msg.bornTimestamp).toBe(1);
+        expect(msg.storeTimestamp).toBe(2);
+        expect(msg.reconsumeTimes).toBe(2);
+        expect(msg.properties).toEqual({ TAGS: 'TagA', KEYS: 'KeyA' });
+        // values are built on first read and reused afterwards
+        expect(msg.body).toBe(msg.body);
+        expect(msg.properties).toBe(msg.properties);
+        expect(msg.toJSON().body).toBe(msg.body);
+        expect(JSON.parse(JSON.stringify(msg)).tags).toBe('TagA');
+        await consumer.shutdown();
+        consumer = null;
+      } finally {
+        if (consumer && consumer.status === Status.STARTED) {
+          await consumer.shutdown();
+        }
+        restoreEnv(env, original);
+      }
+    });
+
+    test('async consume acks after start returns', async () => {
+      const resultFile = path.join(os.tmpdir(), `rocketmq-consume-results-${process.pid}.txt`);
+      fs.rmSync(resultFile, { force: true });
+      const env = {
+        ROCKETMQ_STUB_CONSUME_MESSAGE: '1',
+        ROCKETMQ_STUB_MESSAGE_COUNT: '2',
+        ROCKETMQ_STUB_CONSUME_RETRY: '1',
+        ROCKETMQ_STUB_CONSUME_RESULT_FILE: resultFile,
+      };
+      const original = setEnv(env);
+      let consumer: any;
+      try {
+        consumer = new RocketMQPushConsumer('G1', { asyncConsume: true, lazyMessage: true });
+        const deliveries: Array<{ msg: any; ack: any }> = [];
+        let notify: () => void = () => {};
+        consumer.on('message', (msg: any, ack: any) => {
+          deliveries.push({ msg, ack });
+          notify();
+        });
+        const delivered = (count: number) =>
+          new Promise<void>((resolve) => {
+            notify = () => deliveries.length >= count && resolve();
+            notify();
+          });
+        const results = async (count: number) => {
+          for (let i = 0; i < 100; i++) {
+            const lines = fs.existsSync(resultFile) ? fs.readFileSync(resultFile, 'utf8').trim().split('\n') : [];
+            if (lines.length >= count) {
+              return lines;
+            }
+            await new Promise((resolve) => setTimeout(resolve, 10));
+          }
+          return [];
+        };
+
+        // native start() must not wait for the pending acks
+        await consumer.start();
+        await delivered(2);
+        deliveries[0].ack.done();
+        deliveries[1].ack.done(false);
+        // a second done() on the same ack is ignored
+        deliveries[1].ack.done();
+        expect(await results(2)).toEqual(['3 0 CONSUME_SUCCESS', '4 0 RECONSUME_LATER']);
+
+        // only the nacked message comes back, through the retry path
+        await delivered(3);
+        expect(deliveries[2].msg.queueOffset).toBe(4);
+        expect(deliveries[2].msg.reconsumeTimes).toBe(1);
+        deliveries[2].ack.done(true);
+        expect(await results(3)).toEqual(['3 0 CONSUME_SUCCESS', '4 0 RECONSUME_LATER', '4 1 CONSUME_SUCCESS']);
+        await new Promise((resolve) => setTimeout(resolve, 20));
+        expect(deliveries).toHaveLength(3);
+
+        await consumer.shutdown();
+        consumer = null;
+      } finally {
+        if (consumer && consumer.status === Status.STARTED) {
+          await consumer.shutdown();
+        }
+        restoreEnv(env, original);
+        fs.rmSync(resultFile, { force: true });
+      }
+    });
+
+    test('orderly listener delivers the next batch of a queue only after ack', async () => {
+      const env = { ROCKETMQ_STUB_CONSUME_MESSAGE: '1', ROCKETMQ_STUB_MESSAGE_COUNT: '4' };
+      const original = setEnv(env);
+      let consumer: any;
+      try {
+        consumer = new RocketMQPushConsumer('G1', { maxBatchSize: 2, orderly: true, lazyMessage: true });
+        const batches: Array<{ msgs: any[]; ack: any }> = [];
+        let notify: () => void = () => {};
+        consumer.on('messages', (msgs: any[], ack: any) => {
+          batches.push({ msgs, ack });
+          notify();
+        });
+        const nextBatch = (count: number) =>
+          new Promise<void>((resolve) => {
+            notify = () => batches.length >= count && resolve();
+            notify();
+          });
+
+        // native start() must not wait for the pending ack
+        await consumer.start();
+        await nextBatch(1);
+        await new Promise((resolve) => setTimeout(resolve, 20));
+        expect(batches).toHaveLength(1);
+        const offsets = (index: number) => batches[index].msgs.map((m: any) => m.queueOffset);
+        expect(offsets(0)).toEqual([3, 4]);
+
+        // the unacknowledged part of the batch is redelivered before anything after it
+        batches[0].ack.done([true, false]);
+        await nextBatch(2);
+        expect(offsets(1)).toEqual([4]);
+        batches[1].ack.done();
+        await nextBatch(3);
+        expect(offsets(2)).toEqual([5, 6]);
+        batches[2].ack.done();
+
+        await consumer.shutdown();
+        consumer = null;
+      } finally {
+        if (consumer && consumer.status === Status.STARTED) {
+          await consumer.shutdown();
+        }
+        restoreEnv(env, original);
+      }
+    });
+
     test('message handler throws emits error and auto nacks', async () => {
       const env = { ROCKETMQ_STUB_CONSUME_MESSAGE: '1' };
       const original = setEnv(env);
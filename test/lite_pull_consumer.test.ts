@@ -0,0 +1,257 @@
+'use strict';
+
+import { describe, test, expect } from 'vitest';
+import * as path from 'path';
+import { LogLevel, Status } from '../src/constants';
+
+import { ensureBindingBinary } from './helpers/binding';
+
+const rootDir = path.join(__dirname, '..');
+process.env.NODE_BINDINGS_COMPILED_DIR = 'build';
+ensureBindingBinary(rootDir);
+
+import { RocketMQLitePullConsumer } from '../src/lite_pull_consumer';
+
+function setEnv(env: Record<string, string | undefined>): Record<string, string | undefined> {
+  const original: Record<string, string | undefined> = {};
+  for (const key of Object.keys(env)) {
+    original[key] = process.env[key];
+    if (env[key] === undefined) {
+      delete process.env[key];
+    } else {
+      process.env[key] = env[key];
+    }
+  }
+  return original;
+}
+
+function restoreEnv(env: Record<string, string | undefined>, original: Record<string, string | undefined>): void {
+  for (const key of Object.keys(env)) {
+    if (original[key] === undefined) {
+      delete process.env[key];
+    } else {
+      process.env[key] = original[key];
+    }
+  }
+}
+
+const QUEUE = { topic: 'TopicTest', brokerName: 'broker-a', queueId: 0 };
+
+describe('LitePullConsumer tests', () => {
+  describe('LitePullConsumer constructor tests', () => {
+    test('constructor overloads and options mapping', () => {
+      const c1 = new RocketMQLitePullConsumer('G1', { nameServer: '127.0.0.1', logLevel: LogLevel.DEBUG });
+      const c2 = new RocketMQLitePullConsumer('G2', 'INST', {
+        groupName: 'GROUP_A',
+        pullBatchSize: 32,
+        pullThreadNums: 2,
+        autoCommit: false,
+        autoCommitIntervalMillis: 1000,
+        pollTimeoutMillis: 100,
+        pullThresholdSizeForQueue: 10,
+        pullThresholdSizeForAll: 100,
+        consumeMaxSpan: 500,
+        binaryHeader: true,
+        logLevel: 'warn' as any
+      });
+
+      expect(c1.status).toBe(Status.STOPPED);
+      expect(c2.status).toBe(Status.STOPPED);
+    });
+
+    test('setSessionCredentials validates input', () => {
+      const consumer = new RocketMQLitePullConsumer('G1', {});
+      expect(consumer.setSessionCredentials('ak', 'sk', 'ALIYUN')).toBe(true);
+      expect(() => consumer.setSessionCredentials(1 as any, 'sk', 'ALIYUN')).toThrow(TypeError);
+    });
+  });
+
+  describe('LitePullConsumer subscription tests', () => {
+    test('subscribe and assign validate arguments', () => {
+      const consumer = new RocketMQLitePullConsumer('G1', {});
+      consumer.subscribe('TopicTest');
+      consumer.assign([QUEUE]);
+      consumer.pause([QUEUE]);
+      consumer.resume([QUEUE]);
+
+      expect(() => consumer.subscribe('')).toThrow(/non-empty/);
+      expect(() => consumer.assign([])).toThrow(/can not be empty/);
+      expect(() => consumer.assign([{ topic: 'TopicTest' } as any])).toThrow(TypeError);
+      expect(() => consumer.pause('TopicTest' as any)).toThrow(TypeError);
+    });
+
+    test('subscribe propagates native errors', () => {
+      const env = { ROCKETMQ_STUB_LITE_PULL_SUBSCRIBE_ERROR: '1' };
+      const original = setEnv(env);
+      try {
+        const consumer = new RocketMQLitePullConsumer('G1', {});
+        expect(() => consumer.subscribe('TopicTest', '*')).toThrow(/subscribe error/);
+      } finally {
+        restoreEnv(env, original);
+      }
+    });
+  });
+
+  describe('LitePullConsumer poll tests', () => {
+    test('poll requires a started consumer', () => {
+      const consumer = new RocketMQLitePullConsumer('G1', {});
+      expect(() => consumer.poll(10)).toThrow(/not started/);
+      expect(() => consumer.commit()).toThrow(/not started/);
+    });
+
+    test('poll resolves with the whole batch', async () => {
+      const env = { ROCKETMQ_STUB_LITE_PULL_MESSAGE_COUNT: '3', ROCKETMQ_STUB_MESSAGE_BODY: 'pulled' };
+      const original = setEnv(env);
+      const consumer = new RocketMQLitePullConsumer('G1', {});
+      try {
+        consumer.subscribe('TopicTest', '*');
+        await consumer.start();
+
+        const messages = await consumer.poll(10);
+        expect(messages).toHaveLength(3);
+        expect(messages.map((m) => m.body)).toEqual(['pulled', 'pulled', 'pulled']);
+        expect(messages[0].topic).toBe('TopicTest');
+
+        await expect(consumer.poll()).resolves.toHaveLength(3);
+        expect(() => consumer.poll('10' as any)).toThrow(TypeError);
+      } finally {
+        await consumer.shutdown();
+        restoreEnv(env, original);
+      }
+    });
+
+    test('poll batch is capped by pollBatchMaxSize', async () => {
+      const env = { ROCKETMQ_STUB_LITE_PULL_MESSAGE_COUNT: '10' };
+      const original = setEnv(env);
+      const consumer = new RocketMQLitePullConsumer('G1', {
+        pollBatchMaxSize: 4,
+        pollBatchMaxBytes: 1024,
+        pullThresholdForAll: 100
+      });
+      try {
+        consumer.subscribe('TopicTest', '*');
+        await consumer.start();
+        await expect(consumer.poll(10)).resolves.toHaveLength(4);
+      } finally {
+        await consumer.shutdown();
+        restoreEnv(env, original);
+      }
+    });
+
+    test('only one poll may be pending per consumer', async () => {
+      const consumer = new RocketMQLitePullConsumer('G1', {});
+      consumer.subscribe('TopicTest', '*');
+      await consumer.start();
+      try {
+        const pending = consumer.poll(100);
+        expect(() => consumer.poll(10)).toThrow(/already polling/);
+        await expect(pending).resolves.toEqual([]);
+        await expect(consumer.poll(1)).resolves.toEqual([]);
+      } finally {
+        await consumer.shutdown();
+      }
+    });
+
+    test('poll resolves with an empty array on timeout', async () => {
+      const consumer = new RocketMQLitePullConsumer('G1', {});
+      consumer.subscribe('TopicTest', '*');
+      await consumer.start();
+      try {
+        await expect(consumer.poll(1)).resolves.toEqual([]);
+      } finally {
+        await consumer.shutdown();
+      }
+    });
+
+    test('binary and lazy messages', async () => {
+      const env = { ROCKETMQ_STUB_LITE_PULL_MESSAGE_COUNT: '2', ROCKETMQ_STUB_MESSAGE_QUEUE_OFFSET: '7' };
+      const original = setEnv(env);
+      const consumer = new RocketMQLitePullConsumer('G1', { binaryBody: true, lazyMessage: true });
+      try {
+        consumer.subscribe('TopicTest', '*');
+        await consumer.start();
+
+        const messages = await consumer.poll(10);
+        expect(Buffer.isBuffer(messages[0].body)).toBe(true);
+        expect((messages[0] as any).queueOffset).toBe(7);
+        expect((messages[1] as any).queueOffset).toBe(8);
+      } finally {
+        await consumer.shutdown();
+        restoreEnv(env, original);
+      }
+    });
+
+    test('poll error rejects the promise', async () => {
+      const env = { ROCKETMQ_STUB_LITE_PULL_POLL_ERROR: '1' };
+      const original = setEnv(env);
+      const consumer = new RocketMQLitePullConsumer('G1', {});
+      try {
+        consumer.subscribe('TopicTest', '*');
+        await consumer.start();
+        await expect(consumer.poll(10)).rejects.toThrow(/poll error/);
+      } finally {
+        await consumer.shutdown();
+        restoreEnv(env, original);
+      }
+    });
+  });
+
+  describe('LitePullConsumer offset tests', () => {
+    test('seek, commit and fetchMessageQueues', async () => {
+      const consumer = new RocketMQLitePullConsumer('G1', { autoCommit: false });
+      consumer.assign([QUEUE]);
+      await consumer.start();
+      try {
+        await expect(consumer.seek(QUEUE, 5)).resolves.toBeUndefined();
+        await expect(consumer.seek(QUEUE, -1)).rejects.toThrow(/Seek offset illegal/);
+        expect(() => consumer.seek({} as any, 1)).toThrow(TypeError);
+        expect(() => consumer.seek(QUEUE, 'x' as any)).toThrow(TypeError);
+
+        await expect(consumer.commit()).resolves.toBeUndefined();
+
+        const queues = await consumer.fetchMessageQueues('TopicTest');
+        expect(queues).toHaveLength(4);
+        expect(queues[3]).toEqual({ topic: 'TopicTest', brokerName: 'broker-a', queueId: 3 });
+        expect(() => consumer.fetchMessageQueues(1 as any)).toThrow(TypeError);
+      } finally {
+        await consumer.shutdown();
+      }
+    });
+
+    test('commit error rejects the promise', async () => {
+      const env = { ROCKETMQ_STUB_LITE_PULL_COMMIT_ERROR: '1' };
+      const original = setEnv(env);
+      const consumer = new RocketMQLitePullConsumer('G1', {});
+      try {
+        consumer.assign([QUEUE]);
+        await consumer.start();
+        await expect(consumer.commit()).rejects.toThrow(/commit error/);
+      } finally {
+        await consumer.shutdown();
+        restoreEnv(env, original);
+      }
+    });
+  });
+
+  describe('LitePullConsumer lifecycle tests', () => {
+    test('start error rolls back status', async () => {
+      const env = { ROCKETMQ_STUB_LITE_PULL_START_ERROR: '1' };
+      const original = setEnv(env);
+      try {
+        const consumer = new RocketMQLitePullConsumer('G1', {});
+        await expect(consumer.start()).rejects.toThrow(/start error/);
+        expect(consumer.status).toBe(Status.STOPPED);
+      } finally {
+        restoreEnv(env, original);
+      }
+    });
+
+    test('start and shutdown with callbacks and repeated calls', async () => {
+      const consumer = new RocketMQLitePullConsumer('G1', {});
+      await new Promise<void>((resolve, reject) => consumer.start((err) => (err ? reject(err) : resolve())));
+      await expect(consumer.start()).rejects.toThrow(/already started/);
+      await new Promise<void>((resolve, reject) => consumer.shutdown((err) => (err ? reject(err) : resolve())));
+      await expect(consumer.shutdown()).rejects.toThrow(/already stopped/);
+    });
+  });
+});
@@ -0,0 +1,16 @@
+#ifndef ROCKETMQ_STUB_COMPRESSION_TYPE_H
+#define ROCKETMQ_STUB_COMPRESSION_TYPE_H
+
+#include <cstdint>
+
+namespace rocketmq {
+
+enum class CompressionType : uint8_t {
+  LZ4 = 1,
+  ZSTD = 2,
+  ZLIB = 3,
+};
+
+}
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef ROCKETMQ_STUB_DEFAULT_LITE_PULL_CONSUMER_H
+#define ROCKETMQ_STUB_DEFAULT_LITE_PULL_CONSUMER_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ClientRPCHook.h"
+#include "MQMessage.h"
+#include "MQMessageQueue.h"
+#include "SerializeType.h"
+
+namespace rocketmq {
+
+class DefaultLitePullConsumer {
+ public:
+  explicit DefaultLitePullConsumer(const std::string& group_name);
+
+  void set_group_name(const std::string& group_name);
+  void set_instance_name(const std::string& instance_name);
+  void set_namesrv_addr(const std::string& namesrv_addr);
+  void set_pull_batch_size(int pull_batch_size);
+  void set_pull_thread_nums(int pull_thread_nums);
+  void setAutoCommit(bool auto_commit);
+  void set_auto_commit_interval_millis(long auto_commit_interval_millis);
+  void set_poll_timeout_millis(long poll_timeout_millis);
+  void set_poll_batch_max_size(int poll_batch_max_size);
+  void set_poll_batch_max_bytes(int poll_batch_max_bytes);
+  void set_pull_threshold_for_all(long pull_threshold_for_all);
+  void set_pull_threshold_size_for_queue(int size_in_mib);
+  void set_pull_threshold_size_for_all(int size_in_mib);
+  void set_consume_max_span(int consume_max_span);
+  void set_serialize_type(SerializeType serialize_type);
+  void setRPCHook(std::shared_ptr<ClientRPCHook> rpc_hook);
+
+  void start();
+  void shutdown();
+  void subscribe(const std::string& topic, const std::string& expression);
+  void assign(const std::vector<MQMessageQueue>& message_queues);
+  void pause(const std::vector<MQMessageQueue>& message_queues);
+  void resume(const std::vector<MQMessageQueue>& message_queues);
+
+  std::vector<MQMessageExt> poll();
+  std::vector<MQMessageExt> poll(long timeout);
+  void seek(const MQMessageQueue& message_queue, int64_t offset);
+  void commitSync();
+  std::vector<MQMessageQueue> fetchMessageQueues(const std::string& topic);
+
+ private:
+  std::string group_name_;
+  std::string instance_name_;
+  std::string namesrv_addr_;
+  int pull_batch_size_;
+  int pull_thread_nums_;
+  bool auto_commit_;
+  long auto_commit_interval_millis_;
+  long poll_timeout_millis_;
+  int poll_batch_max_size_;
+  int poll_batch_max_bytes_;
+  long pull_threshold_for_all_;
+  int pull_threshold_size_for_queue_;
+  int pull_threshold_size_for_all_;
+  int consume_max_span_;
+  SerializeType serialize_type_;
+  std::shared_ptr<ClientRPCHook> rpc_hook_;
+  std::vector<MQMessageQueue> assigned_;
+};
+
+}
+
+#endif
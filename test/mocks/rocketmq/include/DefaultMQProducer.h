@@ -1,12 +1,15 @@
 #ifndef ROCKETMQ_STUB_DEFAULT_MQ_PRODUCER_H
 #define ROCKETMQ_STUB_DEFAULT_MQ_PRODUCER_H
 
+#include <atomic>
 #include <memory>
 #include <string>
 
 #include "ClientRPCHook.h"
+#include "CompressionType.h"
 #include "MQMessage.h"
 #include "SendCallback.h"
+#include "SerializeType.h"
 
 namespace rocketmq {
 
@@ -17,14 +20,20 @@ class DefaultMQProducer {
   void set_group_name(const std::string& group_name);
   void set_instance_name(const std::string& instance_name);
   void set_namesrv_addr(const std::string& namesrv_addr);
+  int max_message_size() const;
   void set_max_message_size(int max_message_size);
   void set_compress_level(int compress_level);
+  CompressionType compression_type() const;
+  void set_compression_type(CompressionType compression_type);
+  int send_msg_timeout() const;
   void set_send_msg_timeout(int timeout_ms);
+  void set_serialize_type(SerializeType serialize_type);
   void setRPCHook(std::shared_ptr<ClientRPCHook> rpc_hook);
 
   void start();
   void shutdown();
   void send(MQMessage& message, AutoDeleteSendCallback* callback);
+  void send(std::vector<MQMessage>& messages, AutoDeleteSendCallback* callback);
 
  private:
   std::string group_name_;
@@ -32,8 +41,12 @@ class DefaultMQProducer {
   std::string namesrv_addr_;
   int max_message_size_;
   int compress_level_;
+  CompressionType compression_type_;
   int send_msg_timeout_;
+  SerializeType serialize_type_;
   std::shared_ptr<ClientRPCHook> rpc_hook_;
+  // shutdown 后置位，延迟投递的发送结果随之丢弃
+  std::shared_ptr<std::atomic<bool>> stopped_;
 };
 
 }
@@ -6,9 +6,13 @@
 
 #include "ClientRPCHook.h"
 #include "MQMessageListener.h"
+#include "SerializeType.h"
 
 namespace rocketmq {
 
+struct StubOrderlyDispatch;
+struct StubConcurrentDispatch;
+
 class DefaultMQPushConsumer {
  public:
   explicit DefaultMQPushConsumer(const std::string& group_name);
@@ -19,22 +23,37 @@ class DefaultMQPushConsumer {
   void set_consume_thread_nums(int nums);
   void set_consume_message_batch_max_size(int size);
   void set_max_reconsume_times(int times);
+  void set_pull_threshold_size_for_queue(int size_in_mib);
+  void set_pull_threshold_size_for_all(int size_in_mib);
+  void set_consume_concurrently_max_span(int max_span);
+  void set_serialize_type(SerializeType serialize_type);
   void setRPCHook(std::shared_ptr<ClientRPCHook> rpc_hook);
 
   void start();
   void shutdown();
   void subscribe(const std::string& topic, const std::string& expression);
   void registerMessageListener(MessageListenerConcurrently* listener);
+  void registerMessageListener(MessageListenerOrderly* listener);
 
  private:
+  void shutdown_dispatch();
+
   std::string group_name_;
   std::string instance_name_;
   std::string namesrv_addr_;
   int consume_thread_nums_;
   int consume_message_batch_max_size_;
   int max_reconsume_times_;
+  int pull_threshold_size_for_queue_;
+  int pull_threshold_size_for_all_;
+  int consume_concurrently_max_span_;
+  SerializeType serialize_type_;
   std::shared_ptr<ClientRPCHook> rpc_hook_;
-  MessageListenerConcurrently* listener_;
+  MQMessageListener* listener_;
+  // 顺序模式下按批串行投递的状态，shutdown 时断开与 listener 的联系
+  std::shared_ptr<StubOrderlyDispatch> orderly_dispatch_;
+  // 并发模式下失败消息的重投状态，同样在 shutdown 时断开
+  std::shared_ptr<StubConcurrentDispatch> concurrent_dispatch_;
 };
 
 }
@@ -9,6 +9,7 @@ namespace rocketmq {
 class MQException : public std::exception {
  public:
   explicit MQException(const std::string& message);
+  MQException(const std::string& message, int error, const char* file, int line);
   const char* what() const noexcept override;
 
  private:
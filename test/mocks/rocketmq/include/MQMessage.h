@@ -2,6 +2,8 @@
 #define ROCKETMQ_STUB_MQMESSAGE_H
 
 #include <cstdint>
+#include <map>
+#include <memory>
 #include <string>
 
 namespace rocketmq {
@@ -15,15 +17,19 @@ class MQMessage {
   const std::string& body() const;
   const std::string& tags() const;
   const std::string& keys() const;
+  const std::map<std::string, std::string>& properties() const;
 
   void set_tags(const std::string& tags);
   void set_keys(const std::string& keys);
+  void putProperty(const std::string& name, const std::string& value);
 
  protected:
   std::string topic_;
-  std::string body_;
+  // 与核心一致，消息拷贝共享同一份 body
+  std::shared_ptr<std::string> body_;
   std::string tags_;
   std::string keys_;
+  std::map<std::string, std::string> properties_;
 };
 
 class MQMessageExt : public MQMessage {
@@ -1,6 +1,7 @@
 #ifndef ROCKETMQ_STUB_MQMESSAGE_LISTENER_H
 #define ROCKETMQ_STUB_MQMESSAGE_LISTENER_H
 
+#include <memory>
 #include <vector>
 
 #include "MQMessage.h"
@@ -12,10 +13,41 @@ enum ConsumeStatus {
   RECONSUME_LATER = 1
 };
 
-class MessageListenerConcurrently {
+class ConsumeCallback {
  public:
-  virtual ~MessageListenerConcurrently();
-  virtual ConsumeStatus consumeMessage(std::vector<MQMessageExt>& msgs) = 0;
+  virtual ~ConsumeCallback() = default;
+  virtual void onComplete(ConsumeStatus status) = 0;
+  virtual void onPartialComplete(const std::vector<bool>& acks) {
+    bool consumed = !acks.empty();
+    for (auto ack : acks) {
+      consumed = consumed && ack;
+    }
+    onComplete(consumed ? CONSUME_SUCCESS : RECONSUME_LATER);
+  }
+};
+
+typedef std::shared_ptr<ConsumeCallback> ConsumeCallbackPtr;
+
+enum MessageListenerType { messageListenerDefaultly = 0, messageListenerOrderly = 1, messageListenerConcurrently = 2 };
+
+class MQMessageListener {
+ public:
+  virtual ~MQMessageListener();
+  virtual MessageListenerType getMessageListenerType() { return messageListenerDefaultly; }
+  virtual ConsumeStatus consumeMessage(std::vector<MQMessageExt>& msgs) { return RECONSUME_LATER; }
+  virtual void consumeMessageAsync(std::vector<MQMessageExt>& msgs, ConsumeCallbackPtr callback) {
+    callback->onComplete(consumeMessage(msgs));
+  }
+};
+
+class MessageListenerConcurrently : virtual public MQMessageListener {
+ public:
+  MessageListenerType getMessageListenerType() override final { return messageListenerConcurrently; }
+};
+
+class MessageListenerOrderly : virtual public MQMessageListener {
+ public:
+  MessageListenerType getMessageListenerType() override final { return messageListenerOrderly; }
 };
 
 }
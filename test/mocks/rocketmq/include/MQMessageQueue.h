@@ -0,0 +1,25 @@
+#ifndef ROCKETMQ_STUB_MQMESSAGE_QUEUE_H
+#define ROCKETMQ_STUB_MQMESSAGE_QUEUE_H
+
+#include <string>
+
+namespace rocketmq {
+
+class MQMessageQueue {
+ public:
+  MQMessageQueue();
+  MQMessageQueue(const std::string& topic, const std::string& broker_name, int queue_id);
+
+  const std::string& topic() const;
+  const std::string& broker_name() const;
+  int queue_id() const;
+
+ private:
+  std::string topic_;
+  std::string broker_name_;
+  int queue_id_;
+};
+
+}
+
+#endif
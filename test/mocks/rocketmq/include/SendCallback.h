@@ -19,7 +19,9 @@ class SendResult {
   SendResult(SendStatus status, const std::string& msg_id, int64_t queue_offset);
   SendStatus send_status() const;
   const std::string& msg_id() const;
+  void msg_id(const std::string& msg_id);
   int64_t queue_offset() const;
+  void set_queue_offset(int64_t queue_offset);
 
  private:
   SendStatus status_;
@@ -0,0 +1,15 @@
+#ifndef ROCKETMQ_STUB_SERIALIZE_TYPE_H
+#define ROCKETMQ_STUB_SERIALIZE_TYPE_H
+
+#include <cstdint>
+
+namespace rocketmq {
+
+enum class SerializeType : uint8_t {
+  JSON = 0,
+  ROCKETMQ = 1,
+};
+
+}
+
+#endif
@@ -1,15 +1,24 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
 #include <cstdlib>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include "ClientRPCHook.h"
+#include "DefaultLitePullConsumer.h"
 #include "DefaultMQProducer.h"
 #include "DefaultMQPushConsumer.h"
 #include "LoggerConfig.h"
 #include "MQException.h"
 #include "MQMessage.h"
 #include "MQMessageListener.h"
+#include "MQMessageQueue.h"
 #include "SendCallback.h"
 
 namespace rocketmq {
@@ -73,6 +82,28 @@ MQMessageExt BuildMessageFromEnv() {
   return message;
 }
 
+// ROCKETMQ_STUB_SEND_DELAY_MS 大于 0 时像真实 broker 一样在另一个线程延迟回报结果，
+// 否则在调用线程内同步回调。与核心一致，结果到达前生产者已 shutdown 时回调不会被触发
+void CompleteSend(AutoDeleteSendCallback* callback,
+                  const SendResult& result,
+                  const std::shared_ptr<std::atomic<bool>>& stopped) {
+  int delay_ms = GetEnvInt("ROCKETMQ_STUB_SEND_DELAY_MS", 0);
+  if (delay_ms <= 0) {
+    SendResult copy(result);
+    callback->onSuccess(copy);
+    delete callback;
+    return;
+  }
+  SendResult delayed(result);
+  std::thread([callback, delayed, delay_ms, stopped]() mutable {
+    std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms));
+    if (!stopped->load()) {
+      callback->onSuccess(delayed);
+    }
+    delete callback;
+  }).detach();
+}
+
 }
 
 void LoggerConfig::set_level(LogLevel) {}
@@ -108,6 +139,8 @@ const SessionCredentials& ClientRPCHook::credentials() const { return credential
 
 MQException::MQException(const std::string& message) : message_(message) {}
 
+MQException::MQException(const std::string& message, int, const char*, int) : message_(message) {}
+
 const char* MQException::what() const noexcept { return message_.c_str(); }
 
 SendResult::SendResult() : status_(SEND_OK), msg_id_(""), queue_offset_(0) {}
@@ -121,28 +154,45 @@ SendStatus SendResult::send_status() const { return status_; }
 
 const std::string& SendResult::msg_id() const { return msg_id_; }
 
+void SendResult::msg_id(const std::string& msg_id) { msg_id_ = msg_id; }
+
 int64_t SendResult::queue_offset() const { return queue_offset_; }
 
+void SendResult::set_queue_offset(int64_t queue_offset) { queue_offset_ = queue_offset; }
+
 SendCallback::~SendCallback() = default;
 
 AutoDeleteSendCallback::~AutoDeleteSendCallback() = default;
 
-MQMessage::MQMessage() : topic_(), body_(), tags_(), keys_() {}
+MQMessage::MQMessage()
+    : topic_(), body_(std::make_shared<std::string>()), tags_(), keys_(), properties_() {}
 
 MQMessage::MQMessage(const std::string& topic, const std::string& body)
-    : topic_(topic), body_(body), tags_(), keys_() {}
+    : topic_(topic), body_(std::make_shared<std::string>(body)), tags_(), keys_(), properties_() {}
 
 const std::string& MQMessage::topic() const { return topic_; }
 
-const std::string& MQMessage::body() const { return body_; }
+const std::string& MQMessage::body() const { return *body_; }
 
 const std::string& MQMessage::tags() const { return tags_; }
 
 const std::string& MQMessage::keys() const { return keys_; }
 
-void MQMessage::set_tags(const std::string& tags) { tags_ = tags; }
+const std::map<std::string, std::string>& MQMessage::properties() const { return properties_; }
 
-void MQMessage::set_keys(const std::string& keys) { keys_ = keys; }
+void MQMessage::set_tags(const std::string& tags) {
+  tags_ = tags;
+  properties_["TAGS"] = tags;
+}
+
+void MQMessage::set_keys(const std::string& keys) {
+  keys_ = keys;
+  properties_["KEYS"] = keys;
+}
+
+void MQMessage::putProperty(const std::string& name, const std::string& value) {
+  properties_[name] = value;
+}
 
 MQMessageExt::MQMessageExt()
     : MQMessage(),
@@ -186,7 +236,113 @@ void MQMessageExt::set_queue_offset(int64_t offset) { queue_offset_ = offset; }
 
 void MQMessageExt::set_reconsume_times(int32_t times) { reconsume_times_ = times; }
 
-MessageListenerConcurrently::~MessageListenerConcurrently() = default;
+MQMessageListener::~MQMessageListener() = default;
+
+// 模拟顺序消费：消息按批串行投递，上一批 ack 成功后才投递下一批，失败则从第一条未确认的消息起重投
+struct StubOrderlyDispatch : public std::enable_shared_from_this<StubOrderlyDispatch> {
+  std::mutex mutex;
+  MQMessageListener* listener = nullptr;
+  std::vector<std::vector<MQMessageExt>> batches;
+  size_t next = 0;
+
+  void Dispatch() {
+    std::vector<MQMessageExt> batch;
+    MQMessageListener* target = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (listener == nullptr || next >= batches.size()) {
+        return;
+      }
+      batch = batches[next];
+      target = listener;
+    }
+    target->consumeMessageAsync(batch, std::make_shared<Callback>(shared_from_this()));
+  }
+
+  class Callback : public ConsumeCallback {
+   public:
+    explicit Callback(std::shared_ptr<StubOrderlyDispatch> dispatch) : dispatch_(std::move(dispatch)) {}
+
+    void onComplete(ConsumeStatus status) override {
+      if (status == CONSUME_SUCCESS) {
+        std::lock_guard<std::mutex> lock(dispatch_->mutex);
+        dispatch_->next++;
+      }
+      dispatch_->Dispatch();
+    }
+
+    void onPartialComplete(const std::vector<bool>& acks) override {
+      {
+        std::lock_guard<std::mutex> lock(dispatch_->mutex);
+        auto& batch = dispatch_->batches[dispatch_->next];
+        size_t consumed = std::find(acks.begin(), acks.end(), false) - acks.begin();
+        batch.erase(batch.begin(), batch.begin() + std::min(consumed, batch.size()));
+        if (batch.empty()) {
+          dispatch_->next++;
+        }
+      }
+      dispatch_->Dispatch();
+    }
+
+   private:
+    std::shared_ptr<StubOrderlyDispatch> dispatch_;
+  };
+};
+
+// 模拟并发消费：ROCKETMQ_STUB_CONSUME_RESULT_FILE 指定时逐条追加 "offset reconsumeTimes status"，
+// 开启 ROCKETMQ_STUB_CONSUME_RETRY 时失败的消息像经过重试队列一样带着递增的 reconsume times 重投
+struct StubConcurrentDispatch : public std::enable_shared_from_this<StubConcurrentDispatch> {
+  std::mutex mutex;
+  MQMessageListener* listener = nullptr;
+
+  void Dispatch(std::vector<MQMessageExt> messages) {
+    MQMessageListener* target = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      target = listener;
+    }
+    if (target != nullptr) {
+      target->consumeMessageAsync(messages, std::make_shared<Callback>(shared_from_this(), messages));
+    }
+  }
+
+  class Callback : public ConsumeCallback {
+   public:
+    Callback(std::shared_ptr<StubConcurrentDispatch> dispatch, std::vector<MQMessageExt> messages)
+        : dispatch_(std::move(dispatch)), messages_(std::move(messages)) {}
+
+    void onComplete(ConsumeStatus status) override {
+      onPartialComplete(std::vector<bool>(messages_.size(), status == CONSUME_SUCCESS));
+    }
+
+    void onPartialComplete(const std::vector<bool>& acks) override {
+      std::string path = GetEnvString("ROCKETMQ_STUB_CONSUME_RESULT_FILE", "");
+      FILE* file = path.empty() ? nullptr : std::fopen(path.c_str(), "a");
+      std::vector<MQMessageExt> retry;
+      for (size_t i = 0; i < messages_.size(); i++) {
+        bool ack = i < acks.size() && acks[i];
+        if (file != nullptr) {
+          std::fprintf(file, "%lld %d %s\n", static_cast<long long>(messages_[i].queue_offset()),
+                       messages_[i].reconsume_times(), ack ? "CONSUME_SUCCESS" : "RECONSUME_LATER");
+        }
+        if (!ack) {
+          retry.push_back(messages_[i]);
+          retry.back().set_reconsume_times(messages_[i].reconsume_times() + 1);
+        }
+      }
+      if (file != nullptr) {
+        std::fclose(file);
+      }
+      if (!retry.empty() && IsEnvEnabled("ROCKETMQ_STUB_CONSUME_RETRY")) {
+        dispatch_->Dispatch(retry);
+      }
+    }
+
+   private:
+    std::shared_ptr<StubConcurrentDispatch> dispatch_;
+    std::vector<MQMessageExt> messages_;
+  };
+};
 
 DefaultMQProducer::DefaultMQProducer(const std::string& group_name)
     : group_name_(group_name),
@@ -194,8 +350,11 @@ DefaultMQProducer::DefaultMQProducer(const std::string& group_name)
       namesrv_addr_(),
       max_message_size_(0),
       compress_level_(0),
-      send_msg_timeout_(0),
-      rpc_hook_(nullptr) {}
+      compression_type_(CompressionType::ZLIB),
+      send_msg_timeout_(3000),
+      serialize_type_(SerializeType::JSON),
+      rpc_hook_(nullptr),
+      stopped_(std::make_shared<std::atomic<bool>>(false)) {}
 
 void DefaultMQProducer::set_group_name(const std::string& group_name) {
   group_name_ = group_name;
@@ -209,6 +368,8 @@ void DefaultMQProducer::set_namesrv_addr(const std::string& namesrv_addr) {
   namesrv_addr_ = namesrv_addr;
 }
 
+int DefaultMQProducer::max_message_size() const { return max_message_size_; }
+
 void DefaultMQProducer::set_max_message_size(int max_message_size) {
   max_message_size_ = max_message_size;
 }
@@ -217,10 +378,27 @@ void DefaultMQProducer::set_compress_level(int compress_level) {
   compress_level_ = compress_level;
 }
 
+CompressionType DefaultMQProducer::compression_type() const { return compression_type_; }
+
+void DefaultMQProducer::set_compression_type(CompressionType compression_type) {
+  // 与核心一致：未编译进来的算法被忽略，ROCKETMQ_STUB_WITH_ZSTD/LZ4 模拟开启对应编译选项
+  if ((compression_type == CompressionType::ZSTD && !IsEnvEnabled("ROCKETMQ_STUB_WITH_ZSTD")) ||
+      (compression_type == CompressionType::LZ4 && !IsEnvEnabled("ROCKETMQ_STUB_WITH_LZ4"))) {
+    return;
+  }
+  compression_type_ = compression_type;
+}
+
+int DefaultMQProducer::send_msg_timeout() const { return send_msg_timeout_; }
+
 void DefaultMQProducer::set_send_msg_timeout(int timeout_ms) {
   send_msg_timeout_ = timeout_ms;
 }
 
+void DefaultMQProducer::set_serialize_type(SerializeType serialize_type) {
+  serialize_type_ = serialize_type;
+}
+
 void DefaultMQProducer::setRPCHook(std::shared_ptr<ClientRPCHook> rpc_hook) {
   rpc_hook_ = std::move(rpc_hook);
 }
@@ -229,12 +407,14 @@ void DefaultMQProducer::start() {
   if (IsEnvEnabled("ROCKETMQ_STUB_PRODUCER_START_ERROR")) {
     throw MQException("producer start error");
   }
+  stopped_->store(false);
 }
 
 void DefaultMQProducer::shutdown() {
   if (IsEnvEnabled("ROCKETMQ_STUB_PRODUCER_SHUTDOWN_ERROR")) {
     throw MQException("producer shutdown error");
   }
+  stopped_->store(true);
 }
 
 void DefaultMQProducer::send(MQMessage&, AutoDeleteSendCallback* callback) {
@@ -259,8 +439,36 @@ void DefaultMQProducer::send(MQMessage&, AutoDeleteSendCallback* callback) {
       status,
       GetEnvString("ROCKETMQ_STUB_SEND_MSG_ID", "MSGID"),
       GetEnvInt64("ROCKETMQ_STUB_SEND_QUEUE_OFFSET", 0));
-  callback->onSuccess(result);
-  delete callback;
+  CompleteSend(callback, result, stopped_);
+}
+
+void DefaultMQProducer::send(std::vector<MQMessage>& messages, AutoDeleteSendCallback* callback) {
+  if (IsEnvEnabled("ROCKETMQ_STUB_SEND_BATCH_THROW")) {
+    throw MQException("producer batch send throw");
+  }
+
+  if (callback == nullptr) {
+    return;
+  }
+
+  if (IsEnvEnabled("ROCKETMQ_STUB_SEND_EXCEPTION")) {
+    MQException exception("producer send exception");
+    callback->onException(exception);
+    delete callback;
+    return;
+  }
+
+  // 与核心一致，msg id 为逗号分隔的各条消息 ID；queue offset 回显本批消息条数，便于测试校验拆批结果
+  std::string msg_ids;
+  const std::string base_id = GetEnvString("ROCKETMQ_STUB_SEND_MSG_ID", "MSGID");
+  for (size_t i = 0; i < messages.size(); i++) {
+    if (i > 0) {
+      msg_ids.append(",");
+    }
+    msg_ids.append(base_id + std::to_string(i));
+  }
+  SendResult result(SEND_OK, msg_ids, static_cast<int64_t>(messages.size()));
+  CompleteSend(callback, result, stopped_);
 }
 
 DefaultMQPushConsumer::DefaultMQPushConsumer(const std::string& group_name)
@@ -270,6 +478,10 @@ DefaultMQPushConsumer::DefaultMQPushConsumer(const std::string& group_name)
       consume_thread_nums_(0),
       consume_message_batch_max_size_(0),
       max_reconsume_times_(0),
+      pull_threshold_size_for_queue_(0),
+      pull_threshold_size_for_all_(0),
+      consume_concurrently_max_span_(0),
+      serialize_type_(SerializeType::JSON),
       rpc_hook_(nullptr),
       listener_(nullptr) {}
 
@@ -297,6 +509,22 @@ void DefaultMQPushConsumer::set_max_reconsume_times(int times) {
   max_reconsume_times_ = times;
 }
 
+void DefaultMQPushConsumer::set_pull_threshold_size_for_queue(int size_in_mib) {
+  pull_threshold_size_for_queue_ = size_in_mib;
+}
+
+void DefaultMQPushConsumer::set_pull_threshold_size_for_all(int size_in_mib) {
+  pull_threshold_size_for_all_ = size_in_mib;
+}
+
+void DefaultMQPushConsumer::set_consume_concurrently_max_span(int max_span) {
+  consume_concurrently_max_span_ = max_span;
+}
+
+void DefaultMQPushConsumer::set_serialize_type(SerializeType serialize_type) {
+  serialize_type_ = serialize_type;
+}
+
 void DefaultMQPushConsumer::setRPCHook(std::shared_ptr<ClientRPCHook> rpc_hook) {
   rpc_hook_ = std::move(rpc_hook);
 }
@@ -308,8 +536,28 @@ void DefaultMQPushConsumer::start() {
 
   if (listener_ != nullptr && IsEnvEnabled("ROCKETMQ_STUB_CONSUME_MESSAGE")) {
     std::vector<MQMessageExt> messages;
-    messages.push_back(BuildMessageFromEnv());
-    listener_->consumeMessage(messages);
+    int count = GetEnvInt("ROCKETMQ_STUB_MESSAGE_COUNT", 1);
+    int64_t offset = GetEnvInt64("ROCKETMQ_STUB_MESSAGE_QUEUE_OFFSET", 3);
+    for (int i = 0; i < count; i++) {
+      messages.push_back(BuildMessageFromEnv());
+      messages.back().set_queue_offset(offset + i);
+    }
+
+    if (listener_->getMessageListenerType() == messageListenerOrderly) {
+      orderly_dispatch_ = std::make_shared<StubOrderlyDispatch>();
+      orderly_dispatch_->listener = listener_;
+      size_t batch_size = consume_message_batch_max_size_ > 0 ? consume_message_batch_max_size_ : 1;
+      for (size_t begin = 0; begin < messages.size(); begin += batch_size) {
+        size_t end = std::min(begin + batch_size, messages.size());
+        orderly_dispatch_->batches.emplace_back(messages.begin() + begin, messages.begin() + end);
+      }
+      orderly_dispatch_->Dispatch();
+      return;
+    }
+
+    concurrent_dispatch_ = std::make_shared<StubConcurrentDispatch>();
+    concurrent_dispatch_->listener = listener_;
+    concurrent_dispatch_->Dispatch(messages);
   }
 }
 
@@ -317,6 +565,18 @@ void DefaultMQPushConsumer::shutdown() {
   if (IsEnvEnabled("ROCKETMQ_STUB_CONSUMER_SHUTDOWN_ERROR")) {
     throw MQException("consumer shutdown error");
   }
+  shutdown_dispatch();
+}
+
+void DefaultMQPushConsumer::shutdown_dispatch() {
+  if (orderly_dispatch_) {
+    std::lock_guard<std::mutex> lock(orderly_dispatch_->mutex);
+    orderly_dispatch_->listener = nullptr;
+  }
+  if (concurrent_dispatch_) {
+    std::lock_guard<std::mutex> lock(concurrent_dispatch_->mutex);
+    concurrent_dispatch_->listener = nullptr;
+  }
 }
 
 void DefaultMQPushConsumer::subscribe(const std::string&, const std::string&) {
@@ -326,7 +586,182 @@ void DefaultMQPushConsumer::subscribe(const std::string&, const std::string&) {
 }
 
 void DefaultMQPushConsumer::registerMessageListener(MessageListenerConcurrently* listener) {
+  shutdown_dispatch();
   listener_ = listener;
 }
 
+void DefaultMQPushConsumer::registerMessageListener(MessageListenerOrderly* listener) {
+  shutdown_dispatch();
+  listener_ = listener;
+}
+
+MQMessageQueue::MQMessageQueue() : topic_(), broker_name_(), queue_id_(-1) {}
+
+MQMessageQueue::MQMessageQueue(const std::string& topic, const std::string& broker_name, int queue_id)
+    : topic_(topic), broker_name_(broker_name), queue_id_(queue_id) {}
+
+const std::string& MQMessageQueue::topic() const { return topic_; }
+
+const std::string& MQMessageQueue::broker_name() const { return broker_name_; }
+
+int MQMessageQueue::queue_id() const { return queue_id_; }
+
+DefaultLitePullConsumer::DefaultLitePullConsumer(const std::string& group_name)
+    : group_name_(group_name),
+      instance_name_(),
+      namesrv_addr_(),
+      pull_batch_size_(0),
+      pull_thread_nums_(0),
+      auto_commit_(true),
+      auto_commit_interval_millis_(0),
+      poll_timeout_millis_(0),
+      poll_batch_max_size_(0),
+      poll_batch_max_bytes_(0),
+      pull_threshold_for_all_(0),
+      pull_threshold_size_for_queue_(0),
+      pull_threshold_size_for_all_(0),
+      consume_max_span_(0),
+      serialize_type_(SerializeType::JSON),
+      rpc_hook_(nullptr),
+      assigned_() {}
+
+void DefaultLitePullConsumer::set_group_name(const std::string& group_name) {
+  group_name_ = group_name;
+}
+
+void DefaultLitePullConsumer::set_instance_name(const std::string& instance_name) {
+  instance_name_ = instance_name;
+}
+
+void DefaultLitePullConsumer::set_namesrv_addr(const std::string& namesrv_addr) {
+  namesrv_addr_ = namesrv_addr;
+}
+
+void DefaultLitePullConsumer::set_pull_batch_size(int pull_batch_size) {
+  pull_batch_size_ = pull_batch_size;
+}
+
+void DefaultLitePullConsumer::set_pull_thread_nums(int pull_thread_nums) {
+  pull_thread_nums_ = pull_thread_nums;
+}
+
+void DefaultLitePullConsumer::setAutoCommit(bool auto_commit) {
+  auto_commit_ = auto_commit;
+}
+
+void DefaultLitePullConsumer::set_auto_commit_interval_millis(long auto_commit_interval_millis) {
+  auto_commit_interval_millis_ = auto_commit_interval_millis;
+}
+
+void DefaultLitePullConsumer::set_poll_timeout_millis(long poll_timeout_millis) {
+  poll_timeout_millis_ = poll_timeout_millis;
+}
+
+void DefaultLitePullConsumer::set_poll_batch_max_size(int poll_batch_max_size) {
+  poll_batch_max_size_ = poll_batch_max_size;
+}
+
+void DefaultLitePullConsumer::set_poll_batch_max_bytes(int poll_batch_max_bytes) {
+  poll_batch_max_bytes_ = poll_batch_max_bytes;
+}
+
+void DefaultLitePullConsumer::set_pull_threshold_for_all(long pull_threshold_for_all) {
+  pull_threshold_for_all_ = pull_threshold_for_all;
+}
+
+void DefaultLitePullConsumer::set_pull_threshold_size_for_queue(int size_in_mib) {
+  pull_threshold_size_for_queue_ = size_in_mib;
+}
+
+void DefaultLitePullConsumer::set_pull_threshold_size_for_all(int size_in_mib) {
+  pull_threshold_size_for_all_ = size_in_mib;
+}
+
+void DefaultLitePullConsumer::set_consume_max_span(int consume_max_span) {
+  consume_max_span_ = consume_max_span;
+}
+
+void DefaultLitePullConsumer::set_serialize_type(SerializeType serialize_type) {
+  serialize_type_ = serialize_type;
+}
+
+void DefaultLitePullConsumer::setRPCHook(std::shared_ptr<ClientRPCHook> rpc_hook) {
+  rpc_hook_ = std::move(rpc_hook);
+}
+
+void DefaultLitePullConsumer::start() {
+  if (IsEnvEnabled("ROCKETMQ_STUB_LITE_PULL_START_ERROR")) {
+    throw MQException("lite pull consumer start error");
+  }
+}
+
+void DefaultLitePullConsumer::shutdown() {
+  if (IsEnvEnabled("ROCKETMQ_STUB_LITE_PULL_SHUTDOWN_ERROR")) {
+    throw MQException("lite pull consumer shutdown error");
+  }
+}
+
+void DefaultLitePullConsumer::subscribe(const std::string&, const std::string&) {
+  if (IsEnvEnabled("ROCKETMQ_STUB_LITE_PULL_SUBSCRIBE_ERROR")) {
+    throw MQException("lite pull consumer subscribe error");
+  }
+}
+
+void DefaultLitePullConsumer::assign(const std::vector<MQMessageQueue>& message_queues) {
+  if (message_queues.empty()) {
+    throw MQException("Message queues can not be empty.");
+  }
+  assigned_ = message_queues;
+}
+
+void DefaultLitePullConsumer::pause(const std::vector<MQMessageQueue>&) {}
+
+void DefaultLitePullConsumer::resume(const std::vector<MQMessageQueue>&) {}
+
+std::vector<MQMessageExt> DefaultLitePullConsumer::poll() {
+  return poll(poll_timeout_millis_);
+}
+
+std::vector<MQMessageExt> DefaultLitePullConsumer::poll(long timeout) {
+  if (IsEnvEnabled("ROCKETMQ_STUB_LITE_PULL_POLL_ERROR")) {
+    throw MQException("lite pull consumer poll error");
+  }
+
+  std::vector<MQMessageExt> messages;
+  int count = GetEnvInt("ROCKETMQ_STUB_LITE_PULL_MESSAGE_COUNT", 0);
+  if (poll_batch_max_size_ > 0 && count > poll_batch_max_size_) {
+    count = poll_batch_max_size_;
+  }
+  for (int i = 0; i < count; i++) {
+    messages.push_back(BuildMessageFromEnv());
+    messages.back().set_queue_offset(messages.back().queue_offset() + i);
+  }
+  // 与核心一致，没有消息时等到超时才返回
+  if (messages.empty() && timeout > 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(timeout));
+  }
+  return messages;
+}
+
+void DefaultLitePullConsumer::seek(const MQMessageQueue&, int64_t offset) {
+  if (offset < 0 || IsEnvEnabled("ROCKETMQ_STUB_LITE_PULL_SEEK_ERROR")) {
+    throw MQException("Seek offset illegal");
+  }
+}
+
+void DefaultLitePullConsumer::commitSync() {
+  if (IsEnvEnabled("ROCKETMQ_STUB_LITE_PULL_COMMIT_ERROR")) {
+    throw MQException("lite pull consumer commit error");
+  }
+}
+
+std::vector<MQMessageQueue> DefaultLitePullConsumer::fetchMessageQueues(const std::string& topic) {
+  std::vector<MQMessageQueue> queues;
+  int count = GetEnvInt("ROCKETMQ_STUB_LITE_PULL_QUEUE_COUNT", 4);
+  for (int i = 0; i < count; i++) {
+    queues.emplace_back(topic, "broker-a", i);
+  }
+  return queues;
+}
+
 }
@@ -2,6 +2,7 @@
 
 import { describe, test, expect } from 'vitest';
 import * as path from 'path';
+import * as childProcess from 'child_process';
 
 import { ensureBindingBinary } from './helpers/binding';
 
@@ -399,6 +400,40 @@ describe('Producer send tests', () => {
     }
   });
 
+  test('many concurrent sends all resolve', async () => {
+    const original = setEnv(baseEnv);
+    let producer: any;
+    try {
+      producer = new RocketMQProducer('test-group');
+      await producer.start();
+      const results = await Promise.all(
+        Array.from({ length: 200 }, (_, i) => producer.send('test-topic', `hello ${i}`))
+      );
+      expect(results).toHaveLength(200);
+      expect(results.every((r: any) => r.statusStr === 'OK')).toBe(true);
+    } finally {
+      if (producer && producer.status === Status.STARTED) {
+        await producer.shutdown();
+      }
+      restoreEnv(baseEnv, original);
+    }
+  });
+
+  test('pending sends keep the process alive until their results arrive', () => {
+    // the child has no other handles open, so only the pending sends can hold the event loop
+    const script = [
+      "const { RocketMQProducer } = require('./dist/producer');",
+      "const producer = new RocketMQProducer('test-group');",
+      'producer.start().then(() => {',
+      "  producer.send('test-topic', 'callback', (err, result) => console.log('callback', err ? err.message : result.statusStr));",
+      "  producer.send('test-topic', 'promise').then((result) => console.log('promise', result.statusStr));",
+      '});'
+    ].join('\n');
+    const env = { ...process.env, NODE_BINDINGS_COMPILED_DIR: 'build', ROCKETMQ_STUB_SEND_DELAY_MS: '200' };
+    const output = childProcess.execFileSync(process.execPath, ['-e', script], { cwd: rootDir, env }).toString();
+    expect(output.trim().split('\n').sort()).toEqual(['callback OK', 'promise OK']);
+  });
+
   test('with options', async () => {
     const original = setEnv(baseEnv);
     let producer: any;
@@ -575,6 +610,217 @@ describe('Producer send tests', () => {
   });
 });
 
+describe('Producer sendMany tests', () => {
+  const baseEnv = {
+    ROCKETMQ_STUB_SEND_EXCEPTION: undefined,
+    ROCKETMQ_STUB_SEND_THROW: undefined
+  };
+
+  test('resolves one result per message in order', async () => {
+    const original = setEnv(baseEnv);
+    let producer: any;
+    try {
+      producer = new RocketMQProducer('test-group');
+      await producer.start();
+      const results = await producer.sendMany('test-topic', ['a', Buffer.from('b')], { tags: 'tagA' });
+      expect(results).toHaveLength(2);
+      expect(results[0]).toEqual({ status: 0, statusStr: 'OK', msgId: 'MSGID', offset: 0 });
+      expect(await producer.sendMany('test-topic', [])).toEqual([]);
+    } finally {
+      if (producer && producer.status === Status.STARTED) {
+        await producer.shutdown();
+      }
+      restoreEnv(baseEnv, original);
+    }
+  });
+
+  test('rejects when every message fails', async () => {
+    const env = { ...baseEnv, ROCKETMQ_STUB_SEND_THROW: '1' };
+    const original = setEnv(env);
+    let producer: any;
+    try {
+      producer = new RocketMQProducer('test-group');
+      await producer.start();
+      await expect(producer.sendMany('test-topic', ['a', 'b'])).rejects.toThrow('producer send throw');
+      // promise-style send reports synchronous failures as rejections too
+      await expect(producer.send('test-topic', 'a')).rejects.toThrow('producer send throw');
+    } finally {
+      if (producer && producer.status === Status.STARTED) {
+        await producer.shutdown();
+      }
+      restoreEnv(env, original);
+    }
+  });
+
+  test('requires a started producer', async () => {
+    const producer = new RocketMQProducer('test-group');
+    await expect(producer.sendMany('test-topic', ['a'])).rejects.toThrow(/must be started/);
+    expect(() => producer.sendMany('test-topic', [1 as any])).toThrow(TypeError);
+  });
+});
+
+describe('Producer sendBatch tests', () => {
+  const baseEnv = {
+    ROCKETMQ_STUB_SEND_EXCEPTION: undefined,
+    ROCKETMQ_STUB_SEND_BATCH_THROW: undefined
+  };
+
+  test('sends all bodies in one batch by default', async () => {
+    const original = setEnv(baseEnv);
+    let producer: any;
+    try {
+      producer = new RocketMQProducer('test-group');
+      await producer.start();
+      const results = await producer.sendBatch('test-topic', ['a', Buffer.from('b'), 'c'], { tags: 'tagA' });
+      expect(results).toHaveLength(1);
+      expect(results[0].count).toBe(3);
+      expect(results[0].statusStr).toBe('OK');
+      // stub echoes the batch size as the queue offset
+      expect(results[0].offset).toBe(3);
+    } finally {
+      if (producer && producer.status === Status.STARTED) {
+        await producer.shutdown();
+      }
+      restoreEnv(baseEnv, original);
+    }
+  });
+
+  test('splits by maxMessageSize', async () => {
+    const original = setEnv(baseEnv);
+    let producer: any;
+    try {
+      producer = new RocketMQProducer('test-group', { maxMessageSize: 250 });
+      await producer.start();
+      const body = 'x'.repeat(100);
+      const results = await producer.sendBatch('test-topic', [body, body, body, body, body]);
+      expect(results.map((r: any) => r.count)).toEqual([1, 1, 1, 1, 1]);
+
+      const small = await producer.sendBatch('test-topic', ['a', 'b', 'c', 'd']);
+      expect(small.map((r: any) => r.count)).toEqual([2, 2]);
+    } finally {
+      if (producer && producer.status === Status.STARTED) {
+        await producer.shutdown();
+      }
+      restoreEnv(baseEnv, original);
+    }
+  });
+
+  test('rejects when every batch fails', async () => {
+    const env = { ...baseEnv, ROCKETMQ_STUB_SEND_BATCH_THROW: '1' };
+    const original = setEnv(env);
+    let producer: any;
+    try {
+      producer = new RocketMQProducer('test-group');
+      await producer.start();
+      await expect(producer.sendBatch('test-topic', ['a'])).rejects.toThrow('producer batch send throw');
+    } finally {
+      if (producer && producer.status === Status.STARTED) {
+        await producer.shutdown();
+      }
+      restoreEnv(env, original);
+    }
+  });
+
+  test('empty array resolves without sending and invalid bodies throw', async () => {
+    const original = setEnv(baseEnv);
+    let producer: any;
+    try {
+      producer = new RocketMQProducer('test-group');
+      await producer.start();
+      await expect(producer.sendBatch('test-topic', [])).resolves.toEqual([]);
+      expect(() => producer.sendBatch('test-topic', [1])).toThrow(TypeError);
+    } finally {
+      if (producer && producer.status === Status.STARTED) {
+        await producer.shutdown();
+      }
+      restoreEnv(baseEnv, original);
+    }
+  });
+});
+
+describe('Producer linger batching tests', () => {
+  const baseEnv = {
+    ROCKETMQ_STUB_SEND_EXCEPTION: undefined,
+    ROCKETMQ_STUB_SEND_BATCH_THROW: undefined
+  };
+
+  test('fans batch results out to each send', async () => {
+    const original = setEnv(baseEnv);
+    let producer: any;
+    try {
+      producer = new RocketMQProducer('test-group', { lingerMs: 20 });
+      await producer.start();
+      const results = await Promise.all([
+        producer.send('test-topic', 'a'),
+        producer.send('test-topic', 'b'),
+        producer.send('test-topic', 'c')
+      ]);
+      expect(results.map((r: any) => r.msgId)).toEqual(['MSGID0', 'MSGID1', 'MSGID2']);
+      // stub reports the batch size as the first offset
+      expect(results.map((r: any) => r.offset)).toEqual([3, 4, 5]);
+    } finally {
+      if (producer && producer.status === Status.STARTED) {
+        await producer.shutdown();
+      }
+      restoreEnv(baseEnv, original);
+    }
+  });
+
+  test('batchBytes flushes before linger expires and errors reach every send', async () => {
+    const env = { ...baseEnv, ROCKETMQ_STUB_SEND_BATCH_THROW: '1' };
+    const original = setEnv(env);
+    let producer: any;
+    try {
+      // each one-byte message is estimated at 87 bytes, so the second send fills the batch
+      producer = new RocketMQProducer('test-group', { lingerMs: 60000, batchBytes: 174 });
+      await producer.start();
+      const results = await Promise.allSettled([
+        producer.send('test-topic', 'a'),
+        producer.send('test-topic', 'b')
+      ]);
+      expect(results.map((r) => r.status)).toEqual(['rejected', 'rejected']);
+    } finally {
+      if (producer && producer.status === Status.STARTED) {
+        await producer.shutdown();
+      }
+      restoreEnv(env, original);
+    }
+  });
+
+  test('shutdown waits for buffered sends to settle', async () => {
+    // delayed results are dropped by the stub once the producer has shut down
+    const env = { ...baseEnv, ROCKETMQ_STUB_SEND_DELAY_MS: '100' };
+    const original = setEnv(env);
+    try {
+      const producer = new RocketMQProducer('test-group', { lingerMs: 60000 });
+      await producer.start();
+      const promises = [
+        producer.send('test-topic', 'a'),
+        producer.send('test-topic', 'b'),
+        producer.send('other-topic', 'c')
+      ];
+      const callback = new Promise<any>((resolve) => {
+        producer.send('test-topic', 'd', (err: any, result: any) => resolve(err || result));
+      });
+      await producer.shutdown();
+
+      let timer: NodeJS.Timeout | undefined;
+      const timeout = new Promise<never>((_, reject) => {
+        timer = setTimeout(() => reject(new Error('buffered sends never settled')), 1000);
+      });
+      try {
+        const settled = await Promise.race([Promise.allSettled([...promises, callback]), timeout]);
+        expect(settled.map((r) => r.status)).toEqual(['fulfilled', 'fulfilled', 'fulfilled', 'fulfilled']);
+        expect((settled[3] as PromiseFulfilledResult<any>).value.statusStr).toBe('OK');
+      } finally {
+        clearTimeout(timer);
+      }
+    } finally {
+      restoreEnv(env, original);
+    }
+  });
+});
+
 describe('Producer static properties', () => {
   test('SEND_RESULT static property', () => {
     expect(RocketMQProducer.SEND_RESULT.OK).toBe(0);
@@ -606,6 +852,22 @@ describe('Producer C++ binding coverage tests', () => {
     expect(producer).toBeTruthy();
   });
 
+  test('compressionType rejects unknown values and codecs missing from the build', () => {
+    const original = setEnv({ ROCKETMQ_STUB_WITH_ZSTD: undefined, ROCKETMQ_STUB_WITH_LZ4: '1' });
+    try {
+      expect(new binding.Producer('test-group', 'instance-1', { compressionType: 'zlib' })).toBeTruthy();
+      expect(new binding.Producer('test-group', 'instance-1', { compressionType: 'lz4' })).toBeTruthy();
+      expect(() => new binding.Producer('test-group', 'instance-1', { compressionType: 'gzip' }))
+        .toThrow(TypeError);
+      expect(() => new binding.Producer('test-group', 'instance-1', { compressionType: 1 }))
+        .toThrow(/compressionType must be one of/);
+      expect(() => new binding.Producer('test-group', 'instance-1', { compressionType: 'zstd' }))
+        .toThrow(/compressionType 'zstd' is not available in this build/);
+    } finally {
+      restoreEnv({ ROCKETMQ_STUB_WITH_ZSTD: undefined, ROCKETMQ_STUB_WITH_LZ4: undefined }, original);
+    }
+  });
+
   test('constructor with logLevel boundary values', () => {
     const producerLow = new binding.Producer('test-group', 'instance-1', {
       logLevel: -1